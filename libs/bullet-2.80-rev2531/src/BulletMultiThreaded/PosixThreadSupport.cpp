@@ -395,5 +395,15 @@ btCriticalSection* PosixThreadSupport::createCriticalSection()
 	return new PosixCriticalSection();
 }
 
+void PosixThreadSupport::deleteBarrier(btBarrier* barrier)
+{
+	delete barrier;
+}
+
+void PosixThreadSupport::deleteCriticalSection(btCriticalSection* criticalSection)
+{
+	delete criticalSection;
+}
+
 #endif // USE_PTHREADS
 
@@ -1001,7 +1001,7 @@ btParallelConstraintSolver::btParallelConstraintSolver(btThreadSupportInterface*
 btParallelConstraintSolver::~btParallelConstraintSolver()
 {
 	delete m_memoryCache;
-	delete m_solverIO;
+	delete [] m_solverIO;
 	m_solverThreadSupport->deleteBarrier(m_barrier);
 	m_solverThreadSupport->deleteCriticalSection(m_criticalSection);
 }
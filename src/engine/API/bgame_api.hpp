@@ -92,6 +92,9 @@
 #error overflow: (CS_MAX) > MAX_CONFIGSTRINGS
 #endif
 
+// cell size of the grid target_location lookups are cached on
+#define LOCATION_CELL_SIZE  256.0f
+
 typedef enum {
     GENDER_MALE,
     GENDER_FEMALE,
@@ -1104,6 +1107,7 @@ typedef struct voiceTrack_s {
 
 typedef struct voiceCmd_s {
     valueType cmd[ MAX_VOICE_CMD_LEN ];
+    uint32 hash;                    // Com_NameHash of cmd
     voiceTrack_t *tracks;
     struct voiceCmd_s *next;
 } voiceCmd_t;
@@ -1276,6 +1280,15 @@ public:
     virtual void Free(void *ptr) = 0;
     virtual void InitMemory(void) = 0;
     virtual void DefragmentMemory(void) = 0;
+    virtual uint32 CacheHash(const void *data, sint len, uint32 hash) = 0;
+    virtual fileHandle_t CacheOpenRead(pointer name, sint layout,
+                                       sint sourceSize, uint32 sourceHash, sint *dataSize) = 0;
+    virtual fileHandle_t CacheOpenWrite(pointer name, sint layout,
+                                        sint sourceSize, uint32 sourceHash, sint dataSize) = 0;
+    virtual bool CacheRead(pointer name, sint sourceSize, uint32 sourceHash,
+                           void *data, sint dataSize) = 0;
+    virtual void CacheWrite(pointer name, sint sourceSize, uint32 sourceHash,
+                            const void *data, sint dataSize) = 0;
 };
 
 extern bgGame *bggame;
@@ -130,6 +130,7 @@ sint trap_Milliseconds(void);
 void trap_Cvar_Register(vmConvar_t *vmCvar, pointer varName,
                         pointer defaultValue, sint flags, pointer description);
 void trap_Cvar_Update(vmConvar_t *vmCvar);
+convar_t *trap_Cvar_Find(pointer var_name);
 void trap_Cvar_Set(pointer var_name, pointer value);
 void trap_Cvar_VariableStringBuffer(pointer var_name, valueType *buffer,
                                     uint64 bufsize);
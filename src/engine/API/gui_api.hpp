@@ -75,6 +75,7 @@ sint trap_Milliseconds(void);
 void trap_Cvar_Register(vmConvar_t *cvar, pointer var_name, pointer value,
                         sint flags, pointer description);
 void trap_Cvar_Update(vmConvar_t *cvar);
+convar_t *trap_Cvar_Find(pointer var_name);
 void trap_Cvar_Set(pointer var_name, pointer value);
 float32 trap_Cvar_VariableValue(pointer var_name);
 void trap_Cvar_VariableStringBuffer(pointer var_name, valueType *buffer,
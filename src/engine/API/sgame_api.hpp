@@ -85,6 +85,7 @@ void trap_Cvar_Register(vmConvar_t *cvar, pointer var_name, pointer value,
                         sint flags, pointer description);
 void trap_Cvar_Set(pointer var_name, pointer value);
 void trap_Cvar_Update(vmConvar_t *cvar);
+convar_t *trap_Cvar_Find(pointer var_name);
 sint trap_Cvar_VariableIntegerValue(pointer var_name);
 void trap_Cvar_VariableStringBuffer(pointer var_name, valueType *buffer,
                                     uint64 bufsize);
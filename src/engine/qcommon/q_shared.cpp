@@ -282,6 +282,277 @@ sint Com_HashKey(valueType *string, sint maxlen) {
     return hash;
 }
 
+/*
+============
+Com_NameHash
+
+Case insensitive
+============
+*/
+uint32 Com_NameHash(pointer name) {
+    uint32 hash = 2166136261u;
+
+    for(; *name; name++) {
+        hash = (hash ^ (uchar8)tolower(*name)) * 16777619u;
+    }
+
+    return hash;
+}
+
+/*
+============
+Com_NameIndexClear
+============
+*/
+void Com_NameIndexClear(nameIndex_t *index) {
+    ::memset(index, 0, sizeof(*index));
+}
+
+/*
+============
+Com_NameIndexAdd
+============
+*/
+static void Com_NameIndexAdd(nameIndex_t *index, nameIndexName_t nameOf,
+                             sint entry) {
+    pointer name = nameOf(entry);
+    uint32 hash;
+    sint slot;
+
+    if(!name) {
+        return;
+    }
+
+    hash = Com_NameHash(name);
+    slot = hash & (MAX_NAME_INDEX - 1);
+
+    while(index->slots[slot]) {
+        // keep the first of several entries with the same name, as a
+        // scan from the start of the table would find
+        if(index->hashes[slot] == hash &&
+                !Q_stricmp(nameOf(index->slots[slot] - 1), name)) {
+            return;
+        }
+
+        slot = (slot + 1) & (MAX_NAME_INDEX - 1);
+    }
+
+    index->slots[slot] = entry + 1;
+    index->hashes[slot] = hash;
+}
+
+/*
+============
+Com_NameIndexFind
+
+Returns the first entry of the table named name, or -1. Entries past
+what the index can hold are scanned.
+============
+*/
+sint Com_NameIndexFind(nameIndex_t *index, sint count,
+                       nameIndexName_t nameOf, pointer name) {
+    uint32 hash;
+    sint i, slot, indexed;
+
+    if(index->numEntries > count) {
+        Com_NameIndexClear(index);
+    }
+
+    indexed = count < MAX_NAME_INDEX / 2 ? count : MAX_NAME_INDEX / 2;
+
+    while(index->numEntries < indexed) {
+        Com_NameIndexAdd(index, nameOf, index->numEntries++);
+    }
+
+    if(!name) {
+        return -1;
+    }
+
+    hash = Com_NameHash(name);
+    slot = hash & (MAX_NAME_INDEX - 1);
+
+    while(index->slots[slot]) {
+        if(index->hashes[slot] == hash &&
+                !Q_stricmp(nameOf(index->slots[slot] - 1), name)) {
+            return index->slots[slot] - 1;
+        }
+
+        slot = (slot + 1) & (MAX_NAME_INDEX - 1);
+    }
+
+    for(i = indexed; i < count; i++) {
+        if(nameOf(i) && !Q_stricmp(nameOf(i), name)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/*
+============
+Com_CellCacheClear
+============
+*/
+void Com_CellCacheClear(cellCache_t *cache, float32 cellSize) {
+    ::memset(cache, 0, sizeof(*cache));
+    cache->cellSize = cellSize;
+}
+
+/*
+============
+Com_CellCacheHash
+============
+*/
+static sint Com_CellCacheHash(sint x, sint y, sint z, sint size) {
+    return ((x * 73856093) ^ (y * 19349663) ^ (z * 83492791)) & (size - 1);
+}
+
+/*
+============
+Com_CellCacheCorner
+
+func( corner ), computed once for the eight cells that share it
+============
+*/
+static sint Com_CellCacheCorner(cellCache_t *cache, sint x, sint y, sint z,
+                                cellCacheFunc_t func) {
+    cellCacheCorner_t *corner;
+    vec3_t point;
+    sint slot;
+
+    // start over rather than let the probes grow long, the cells keep
+    // what they learnt from the corners
+    if(cache->numCorners >= MAX_CELL_CORNERS / 2) {
+        ::memset(cache->corners, 0, sizeof(cache->corners));
+        cache->numCorners = 0;
+    }
+
+    slot = Com_CellCacheHash(x, y, z, MAX_CELL_CORNERS);
+
+    for(corner = &cache->corners[slot]; corner->value;
+            corner = &cache->corners[slot = (slot + 1) & (MAX_CELL_CORNERS - 1)]) {
+        if(corner->x == x && corner->y == y && corner->z == z) {
+            return corner->value - 2;
+        }
+    }
+
+    point[0] = x * cache->cellSize;
+    point[1] = y * cache->cellSize;
+    point[2] = z * cache->cellSize;
+
+    corner->x = x;
+    corner->y = y;
+    corner->z = z;
+    corner->value = func(point) + 2;
+    cache->numCorners++;
+    cache->queries++;
+
+    return corner->value - 2;
+}
+
+/*
+============
+Com_CellCacheCell
+
+Works out whether the corners of a cell agree, -2 if they don't
+============
+*/
+static sint Com_CellCacheCell(cellCache_t *cache, sint x, sint y, sint z,
+                              cellCacheFunc_t func) {
+    sint i, value, cornerValue;
+    vec3_t probe;
+
+    value = -1;
+
+    for(i = 0; i < 8; i++) {
+        cornerValue = Com_CellCacheCorner(cache, x + (i & 1),
+                                          y + ((i >> 1) & 1), z + ((i >> 2) & 1), func);
+
+        // a corner in solid says nothing about the inside, try a point
+        // an eighth of the way in instead
+        if(cornerValue < 0) {
+            probe[0] = (x + (i & 1) * 0.75f + 0.125f) * cache->cellSize;
+            probe[1] = (y + ((i >> 1) & 1) * 0.75f + 0.125f) * cache->cellSize;
+            probe[2] = (z + ((i >> 2) & 1) * 0.75f + 0.125f) * cache->cellSize;
+
+            cornerValue = func(probe);
+            cache->queries++;
+        }
+
+        if(cornerValue < 0) {
+            continue;
+        }
+
+        if(value >= 0 && cornerValue != value) {
+            return -2;
+        }
+
+        value = cornerValue;
+    }
+
+    // all in solid
+    if(value < 0) {
+        return -2;
+    }
+
+    return value;
+}
+
+/*
+============
+Com_CellCacheLookup
+
+Returns func( point ), from the cell point is in when that is uniform
+============
+*/
+sint Com_CellCacheLookup(cellCache_t *cache, const vec3_t point,
+                         cellCacheFunc_t func) {
+    cellCacheEntry_t *cell;
+    sint x, y, z, slot;
+
+    cache->lookups++;
+
+    if(cache->cellSize <= 0.0f) {
+        cache->queries++;
+        return func(point);
+    }
+
+    x = (sint)floor(point[0] / cache->cellSize);
+    y = (sint)floor(point[1] / cache->cellSize);
+    z = (sint)floor(point[2] / cache->cellSize);
+
+    if(cache->numCells >= MAX_CELL_CACHE / 2) {
+        ::memset(cache->cells, 0, sizeof(cache->cells));
+        cache->numCells = 0;
+    }
+
+    slot = Com_CellCacheHash(x, y, z, MAX_CELL_CACHE);
+
+    for(cell = &cache->cells[slot]; cell->used;
+            cell = &cache->cells[slot = (slot + 1) & (MAX_CELL_CACHE - 1)]) {
+        if(cell->x == x && cell->y == y && cell->z == z) {
+            break;
+        }
+    }
+
+    if(!cell->used) {
+        cell->used = true;
+        cell->x = x;
+        cell->y = y;
+        cell->z = z;
+        cell->value = Com_CellCacheCell(cache, x, y, z, func);
+        cache->numCells++;
+    }
+
+    if(cell->value == -2) {
+        cache->queries++;
+        return func(point);
+    }
+
+    return cell->value;
+}
+
 //============================================================================
 
 
@@ -418,12 +689,13 @@ pointer     punctuation[] = {
     nullptr
 };
 
-static valueType com_token[MAX_TOKEN_CHARS];
-static valueType com_parsename[MAX_TOKEN_CHARS];
-static sint com_lines;
+// per thread so scripts can be parsed off the main thread while loading
+static thread_local valueType com_token[MAX_TOKEN_CHARS];
+static thread_local valueType com_parsename[MAX_TOKEN_CHARS];
+static thread_local sint com_lines;
 
-static sint backup_lines;
-static valueType    *backup_text;
+static thread_local sint backup_lines;
+static thread_local valueType    *backup_text;
 
 void COM_BeginParseSession(pointer name) {
     com_lines = 0;
@@ -2100,6 +2372,90 @@ void Q_StripIndentMarker(valueType *string) {
     string[j] = 0;
 }
 
+static thread_local valueType scratchArena[MAX_SCRATCH_ARENA];
+static thread_local sint scratchUsed;
+static thread_local sint scratchFrame;  // 0 on threads that never reset
+
+/*
+============
+Com_ScratchReset
+
+Ends the calling thread's frame. Everything allocated from its scratch
+arena is freed, and va() may reuse the strings it handed out before. The
+game modules call this once a frame, strings from the arena are good
+until then.
+============
+*/
+void Com_ScratchReset(void) {
+    scratchUsed = 0;
+    scratchFrame++;
+}
+
+/*
+============
+ScratchAllocate
+
+nullptr if the arena is out of room
+============
+*/
+static void *ScratchAllocate(sint size) {
+    void *p;
+
+    size = (size + 15) & ~15;
+
+    if(size < 0 || scratchUsed + size > MAX_SCRATCH_ARENA) {
+        return nullptr;
+    }
+
+    p = &scratchArena[ scratchUsed ];
+    scratchUsed += size;
+
+    return p;
+}
+
+/*
+============
+Com_ScratchAlloc
+
+Never wraps, running out of arena is an error instead of handing out
+memory that is still in use
+============
+*/
+void *Com_ScratchAlloc(sint size) {
+    void *p = ScratchAllocate(size);
+
+    if(!p) {
+        common->Error(ERR_DROP, "Com_ScratchAlloc: %i bytes wanted, %i left\n",
+                      size, MAX_SCRATCH_ARENA - scratchUsed);
+    }
+
+    return p;
+}
+
+/*
+============
+Com_ScratchPrintf
+
+va() into the scratch arena. The arena never hands out memory twice in a
+frame, so the arguments can't overlap the string being formatted.
+============
+*/
+valueType *Com_ScratchPrintf(pointer format, ...) {
+    va_list argptr;
+    valueType *buf = &scratchArena[ scratchUsed ];
+    sint len;
+
+    va_start(argptr, format);
+    len = vsnprintf(buf, MAX_SCRATCH_ARENA - scratchUsed, format, argptr);
+    va_end(argptr);
+
+    if(len < 0 || len >= MAX_SCRATCH_ARENA - scratchUsed) {
+        common->Error(ERR_DROP, "Com_ScratchPrintf: overflowed the scratch arena\n");
+    }
+
+    return (valueType *)Com_ScratchAlloc(len + 1);
+}
+
 /*
 ============
 va
@@ -2108,34 +2464,73 @@ does a varargs printf into a temp buffer, so I don't need to have
 varargs versions of all text functions.
 
 Ridah, modified this into a circular list, to further prevent stepping on
-previous strings
+previous strings. The ring is per thread. Strings are formatted aside,
+since the arguments may be earlier va() strings, and copied in once
+their slot is known.
+
+On threads that reset a scratch arena each frame the ring won't wrap over
+a string from the current frame, that string goes to the arena instead.
+Strings that must outlive the frame belong in a buffer of the caller's.
 ============
 */
 valueType *va(pointer format, ...) {
     va_list argptr;
-#define MAX_VA_STRING   32000
-    static valueType temp_buffer[MAX_VA_STRING];
-    static valueType
-    string[MAX_VA_STRING];      // in case va is called by nested functions
-    static sint index = 0;
+    static thread_local valueType string[MAX_VA_STRING];
+    static thread_local valueType formatted[MAX_VA_STRING];
+    static thread_local sint index, lap;
+    static thread_local sint frame, frameIndex, frameLap;   // frame start
+    static thread_local bool warned;
     valueType *buf;
-    sint len;
+    sint len, start, startLap;
 
     va_start(argptr, format);
-    Q_vsprintf_s(temp_buffer, sizeof(temp_buffer), format, argptr);
+    len = vsnprintf(formatted, MAX_VA_STRING, format, argptr);
     va_end(argptr);
 
-    if((len = strlen(temp_buffer)) >= MAX_VA_STRING) {
+    if(len < 0 || len >= MAX_VA_STRING) {
         common->Error(ERR_DROP, "Attempted to overrun string in call to va()\n");
     }
 
-    if(len + index >= MAX_VA_STRING - 1) {
-        index = 0;
+    start = index;
+    startLap = lap;
+
+    if(len >= MAX_VA_STRING - index) {
+        // didn't fit after the last string, start the ring over
+        start = 0;
+        startLap = lap + 1;
     }
 
-    buf = &string[index];
-    ::memcpy(buf, temp_buffer, len + 1);
+    // remember where the strings of this frame begin
+    if(frame != scratchFrame) {
+        frame = scratchFrame;
+        frameIndex = start;
+        frameLap = startLap;
+    }
+
+    if(scratchFrame && startLap != frameLap && start + len >= frameIndex) {
+        // the slot still holds strings from this frame
+        buf = (valueType *)ScratchAllocate(len + 1);
+
+        if(buf) {
+            ::memcpy(buf, formatted, len + 1);
+            return buf;
+        }
+
+        if(!warned) {
+            warned = true;
+            common->Printf(S_COLOR_YELLOW "WARNING: va() reused a string from "
+                           "this frame, the scratch arena is full\n");
+        }
+
+        frameIndex = start;
+        frameLap = startLap;
+    }
+
+    index = start;
+    lap = startLap;
 
+    buf = &string[index];
+    ::memcpy(buf, formatted, len + 1);
     index += len + 1;
 
     return buf;
@@ -2160,9 +2555,9 @@ FIXME: overflow check?
 */
 valueType *Info_ValueForKey(pointer s, pointer key) {
     valueType pkey[BIG_INFO_KEY];
-    static valueType value[2][BIG_INFO_VALUE];   // use two buffers so compares
+    static thread_local valueType value[2][BIG_INFO_VALUE];   // use two buffers so compares
     // work without stomping on each other
-    static sint valueindex = 0;
+    static thread_local sint valueindex = 0;
     valueType    *o;
 
     if(!s || !key) {
@@ -2266,6 +2661,256 @@ void Info_NextPair(pointer *head, valueType *key, valueType *value) {
     *head = s;
 }
 
+/*
+===================
+Info_KeyHash
+===================
+*/
+static uint32 Info_KeyHash(pointer key, sint length) {
+    uint32 hash = 2166136261u;
+    sint i;
+
+    for(i = 0; i < length; i++) {
+        hash = (hash ^ (uchar8)tolower(key[i])) * 16777619u;
+    }
+
+    return hash;
+}
+
+/*
+===================
+Info_ScanPair
+
+Finds the key and value following offset pos in an info string, the same
+way Info_ValueForKey reads them, without copying either
+===================
+*/
+static bool Info_ScanPair(pointer s, sint *pos, infoPair_t *pair) {
+    pointer p = s + *pos, start;
+
+    if(*p == '\\') {
+        p++;
+    }
+
+    start = p;
+
+    while(*p != '\\') {
+        if(!*p) {
+            return false;
+        }
+
+        p++;
+    }
+
+    pair->key = start - s;
+    pair->keyLength = p - start;
+    pair->hash = Info_KeyHash(start, pair->keyLength);
+
+    start = ++p;
+
+    while(*p != '\\' && *p) {
+        p++;
+    }
+
+    pair->value = start - s;
+    pair->valueLength = p - start;
+
+    *pos = p - s;
+    return true;
+}
+
+/*
+===================
+Info_ParseView
+
+Indexes an info string, which must stay unchanged while the view is used
+===================
+*/
+void Info_ParseView(infoView_t *view, pointer s) {
+    sint pos = 0;
+
+    view->s = s ? s : "";
+    view->numPairs = 0;
+    view->tail = -1;
+
+    while(view->numPairs < MAX_INFO_PAIRS) {
+        if(!Info_ScanPair(view->s, &pos, &view->pairs[ view->numPairs ])) {
+            return;
+        }
+
+        view->numPairs++;
+    }
+
+    // anything past this many pairs is only scanned for if asked for
+    view->tail = pos;
+}
+
+/*
+===================
+Info_ViewFind
+
+Points value at the first value for key in the info string, it is not
+nullptr terminated
+===================
+*/
+bool Info_ViewFind(const infoView_t *view, pointer key, pointer *value,
+                   sint *length) {
+    const infoPair_t *pair;
+    infoPair_t tailPair;
+    sint i, keyLength, pos;
+    uint32 hash;
+
+    if(!key) {
+        return false;
+    }
+
+    keyLength = strlen(key);
+    hash = Info_KeyHash(key, keyLength);
+
+    for(i = 0, pair = view->pairs; i < view->numPairs; i++, pair++) {
+        if(pair->hash == hash && pair->keyLength == keyLength &&
+                !Q_stricmpn(view->s + pair->key, key, keyLength)) {
+            *value = view->s + pair->value;
+            *length = pair->valueLength;
+            return true;
+        }
+    }
+
+    if(view->tail < 0) {
+        return false;
+    }
+
+    pos = view->tail;
+
+    while(Info_ScanPair(view->s, &pos, &tailPair)) {
+        if(tailPair.hash == hash && tailPair.keyLength == keyLength &&
+                !Q_stricmpn(view->s + tailPair.key, key, keyLength)) {
+            *value = view->s + tailPair.value;
+            *length = tailPair.valueLength;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+===================
+Info_ViewString
+
+Copies the value for key into buffer, an empty string if there is none
+===================
+*/
+valueType *Info_ViewString(const infoView_t *view, pointer key,
+                           valueType *buffer, sint size) {
+    pointer value;
+    sint length;
+
+    if(!Info_ViewFind(view, key, &value, &length)) {
+        value = "";
+        length = 0;
+    }
+
+    if(length > size - 1) {
+        length = size - 1;
+    }
+
+    ::memcpy(buffer, value, length);
+    buffer[ length ] = '\0';
+
+    return buffer;
+}
+
+/*
+===================
+Info_ViewInt
+===================
+*/
+sint Info_ViewInt(const infoView_t *view, pointer key) {
+    pointer value;
+    sint length;
+
+    // atoi stops at the \ after the value
+    if(!Info_ViewFind(view, key, &value, &length) || !length) {
+        return 0;
+    }
+
+    return atoi(value);
+}
+
+/*
+===================
+Info_ViewBuild
+
+Writes the viewed info string to out in one pass with key set to value,
+or removed if value is empty, as Info_SetValueForKey would leave it.
+Returns false and leaves out empty if the result doesn't fit.
+===================
+*/
+bool Info_ViewBuild(const infoView_t *view, valueType *out, sint size,
+                    pointer key, pointer value) {
+    const infoPair_t *pair;
+    infoPair_t tailPair;
+    sint i, pos, used = 0, keyLength;
+    uint32 hash;
+
+    out[ 0 ] = '\0';
+
+    if(strchr(key, '\\') || strchr(value, '\\') || strchr(key, ';') ||
+            strchr(value, ';')) {
+        return false;
+    }
+
+    keyLength = strlen(key);
+    hash = Info_KeyHash(key, keyLength);
+
+    for(i = 0, pos = view->tail; ; i++) {
+        if(i < view->numPairs) {
+            pair = &view->pairs[ i ];
+        } else if(pos >= 0 && Info_ScanPair(view->s, &pos, &tailPair)) {
+            pair = &tailPair;
+        } else {
+            break;
+        }
+
+        if(pair->hash == hash && pair->keyLength == keyLength &&
+                !Q_stricmpn(view->s + pair->key, key, keyLength)) {
+            continue;
+        }
+
+        if(used + pair->keyLength + pair->valueLength + 2 >= size) {
+            out[ 0 ] = '\0';
+            return false;
+        }
+
+        out[ used++ ] = '\\';
+        ::memcpy(out + used, view->s + pair->key, pair->keyLength);
+        used += pair->keyLength;
+        out[ used++ ] = '\\';
+        ::memcpy(out + used, view->s + pair->value, pair->valueLength);
+        used += pair->valueLength;
+    }
+
+    if(*value) {
+        sint valueLength = strlen(value);
+
+        if(used + keyLength + valueLength + 2 >= size) {
+            out[ 0 ] = '\0';
+            return false;
+        }
+
+        out[ used++ ] = '\\';
+        ::memcpy(out + used, key, keyLength);
+        used += keyLength;
+        out[ used++ ] = '\\';
+        ::memcpy(out + used, value, valueLength);
+        used += valueLength;
+    }
+
+    out[ used ] = '\0';
+    return true;
+}
+
 /*
 =============
 Q_bytestrcpy
@@ -2591,7 +3236,7 @@ Com_ClientListString
 ============
 */
 valueType *Com_ClientListString(const clientList_t *list) {
-    static valueType s[ 17 ];
+    static thread_local valueType s[ 17 ];
 
     s[ 0 ] = '\0';
 
@@ -2651,7 +3296,7 @@ void Q_vsprintf_s(valueType *pDest, uint32 nDestSize, pointer pFmt,
 #ifdef _WIN32
     vsprintf_s(pDest, nDestSize, pFmt, args);
 #else
-    vsprintf(pDest, pFmt, args);
+    vsnprintf(pDest, nDestSize, pFmt, args);
 #endif
 }
 
@@ -888,6 +888,61 @@ void COM_BitSet(sint array[], sint bitNum);
 void COM_BitClear(sint array[], sint bitNum);
 
 sint     Com_HashKey(valueType *string, sint maxlen);
+uint32   Com_NameHash(pointer name);
+
+//
+// case insensitive name lookups over a table of named entries, indexed
+// as the table grows; clear the index whenever the table is reset
+//
+#define MAX_NAME_INDEX 512      // a power of two, twice the entries indexed
+
+typedef pointer(*nameIndexName_t)(sint entry);
+
+typedef struct nameIndex_s {
+    sint numEntries;                    // entries indexed so far
+    schar16 slots[MAX_NAME_INDEX];      // entry + 1, 0 if empty
+    uint32 hashes[MAX_NAME_INDEX];
+} nameIndex_t;
+
+void Com_NameIndexClear(nameIndex_t *index);
+sint Com_NameIndexFind(nameIndex_t *index, sint count,
+                       nameIndexName_t nameOf, pointer name);
+
+//
+// caches a value computed for points, such as the location a point is in,
+// by grid cell. A cell whose corners agree on a value answers for any
+// point inside it; others are computed for the point. A corner valued -1
+// (in solid) is replaced by a point just inside the cell, and left out if
+// that is -1 too. Corner values are kept on their own, each is shared by
+// eight cells.
+//
+#define MAX_CELL_CACHE 16384    // a power of two
+#define MAX_CELL_CORNERS 65536  // a power of two
+
+typedef sint(*cellCacheFunc_t)(const vec3_t point);
+
+typedef struct cellCacheEntry_s {
+    bool used;
+    sint x, y, z;
+    sint value;                 // -2 if the corners disagree
+} cellCacheEntry_t;
+
+typedef struct cellCacheCorner_s {
+    schar16 x, y, z;
+    schar16 value;              // value + 2, 0 if unused
+} cellCacheCorner_t;
+
+typedef struct cellCache_s {
+    float32 cellSize;
+    sint numCells, numCorners;
+    sint lookups, queries;      // calls, and how many times they ran func
+    cellCacheEntry_t cells[MAX_CELL_CACHE];
+    cellCacheCorner_t corners[MAX_CELL_CORNERS];
+} cellCache_t;
+
+void Com_CellCacheClear(cellCache_t *cache, float32 cellSize);
+sint Com_CellCacheLookup(cellCache_t *cache, const vec3_t point,
+                         cellCacheFunc_t func);
 
 #define MAX_TOKENLENGTH     1024
 
@@ -1046,8 +1101,17 @@ valueType *Q_CleanDirName(valueType *dirname);
 
 //=============================================
 
+#define MAX_VA_STRING       32000
+#define MAX_SCRATCH_ARENA   65536
+
 valueType *va(pointer format, ...) __attribute__((format(printf, 1, 2)));
 
+// per thread arena, everything in it is freed by Com_ScratchReset
+void Com_ScratchReset(void);
+void *Com_ScratchAlloc(sint size);
+valueType *Com_ScratchPrintf(pointer format, ...) __attribute__((format(
+            printf, 1, 2)));
+
 //=============================================
 
 //
@@ -1061,6 +1125,34 @@ void Info_SetValueForKey_Big(valueType *s, pointer key, pointer value);
 bool Info_Validate(pointer s);
 void Info_NextPair(pointer *s, valueType *key, valueType *value);
 
+//
+// info strings indexed once, so that looking keys up neither rescans nor
+// copies the string
+//
+#define MAX_INFO_PAIRS 256
+
+typedef struct infoPair_s {
+    sint key, keyLength;            // offsets into the info string
+    sint value, valueLength;
+    uint32 hash;                    // of the key, ignoring case
+} infoPair_t;
+
+typedef struct infoView_s {
+    pointer s;
+    sint numPairs;
+    sint tail;                      // where indexing stopped, -1 if it didn't
+    infoPair_t pairs[MAX_INFO_PAIRS];
+} infoView_t;
+
+void Info_ParseView(infoView_t *view, pointer s);
+bool Info_ViewFind(const infoView_t *view, pointer key, pointer *value,
+                   sint *length);
+valueType *Info_ViewString(const infoView_t *view, pointer key,
+                           valueType *buffer, sint size);
+sint Info_ViewInt(const infoView_t *view, pointer key);
+bool Info_ViewBuild(const infoView_t *view, valueType *out, sint size,
+                    pointer key, pointer value);
+
 // this is only here so the functions in q_shared.c and bg_*.c can link
 void Com_Error(errorParm_t level, pointer error,
                ...) _attribute((format(printf,
@@ -48,6 +48,9 @@ void UI_DrawConnectScreen(bool overlay);
 //#define MAX_PINGREQUESTS 32
 #define MAX_ADDRESSLENGTH 64
 #define MAX_DISPLAY_SERVERS 2048
+#define MAX_SERVER_CACHE MAX_GLOBAL_SERVERS
+#define MAX_SERVER_NAME MAX_HOSTNAME_LENGTH
+#define SERVER_CACHE_AGE 10000
 #define MAX_SERVERSTATUS_LINES 128
 #define MAX_SERVERSTATUS_TEXT 1024
 #define MAX_FOUNDPLAYER_SERVERS 16
@@ -116,6 +119,25 @@ typedef struct guiServerStatus_s {
 }
 guiServerStatus_t;
 
+// the fields the browser lists, filters and sorts on, parsed once per
+// change of a server's info string and indexed by LAN server number
+typedef struct {
+    sint    source;
+    uint32  infoHash[MAX_SERVER_CACHE];     // 0 if the entry is empty
+    sint    updateTime[MAX_SERVER_CACHE];
+    sint    lanPing[MAX_SERVER_CACHE];      // LAN ping when last fetched
+    sint    clients[MAX_SERVER_CACHE];
+    sint    maxClients[MAX_SERVER_CACHE];
+    sint    ping[MAX_SERVER_CACHE];
+    sint    netType[MAX_SERVER_CACHE];
+    valueType  hostName[MAX_SERVER_CACHE][MAX_SERVER_NAME];
+    valueType  sortName[MAX_SERVER_CACHE][MAX_SERVER_NAME];
+    valueType  mapName[MAX_SERVER_CACHE][MAX_QPATH];
+    valueType  game[MAX_SERVER_CACHE][MAX_QPATH];
+    valueType  addr[MAX_SERVER_CACHE][MAX_ADDRESSLENGTH];
+}
+guiServerCache_t;
+
 
 typedef struct {
     valueType    adrstr[MAX_ADDRESSLENGTH];
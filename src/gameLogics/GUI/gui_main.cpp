@@ -72,6 +72,7 @@ typedef struct {
     valueType    *defaultString;
     sint     cvarFlags;
     valueType *description;
+    convar_t *cvar;             // the engine's cvar, to see changes without asking
 } cvarTable_t;
 
 vmConvar_t  ui_browserShowFull;
@@ -295,14 +296,15 @@ UI_InsertServerIntoDisplayList
 static void UI_InsertServerIntoDisplayList(sint num, sint position) {
     sint i;
 
-    if(position < 0 || position > uiInfo.serverStatus.numDisplayServers) {
+    if(position < 0 || position > uiInfo.serverStatus.numDisplayServers ||
+            uiInfo.serverStatus.numDisplayServers >= MAX_DISPLAY_SERVERS) {
         return;
     }
 
     //
     uiInfo.serverStatus.numDisplayServers++;
 
-    for(i = uiInfo.serverStatus.numDisplayServers; i > position; i--) {
+    for(i = uiInfo.serverStatus.numDisplayServers - 1; i > position; i--) {
         uiInfo.serverStatus.displayServers[i] =
             uiInfo.serverStatus.displayServers[i - 1];
     }
@@ -332,6 +334,137 @@ static void UI_RemoveServerFromDisplayList(sint num) {
     }
 }
 
+static guiServerCache_t serverCache;
+
+/*
+==================
+UI_ServerInfoHash
+==================
+*/
+static uint32 UI_ServerInfoHash(pointer info) {
+    uint32 hash = 2166136261u;
+
+    for(; *info; info++) {
+        hash = (hash ^ static_cast<uchar8>(*info)) * 16777619u;
+    }
+
+    // zero marks an empty cache entry
+    return hash ? hash : 1;
+}
+
+/*
+==================
+UI_UpdateServerCache
+
+Fetches the info string of a server and reparses the cached fields if it
+has changed. Entries whose LAN ping is unchanged and that were looked at
+less than maxAge msec ago are left alone.
+==================
+*/
+static void UI_UpdateServerCache(sint num, sint lanPing, sint maxAge) {
+    valueType info[MAX_STRING_CHARS], hostName[MAX_INFO_VALUE];
+    infoView_t view;
+    uint32 hash;
+    valueType *name;
+
+    if(num < 0 || num >= MAX_SERVER_CACHE) {
+        return;
+    }
+
+    // the server numbers of each source are unrelated
+    if(serverCache.source != ui_netSource.integer) {
+        ::memset(serverCache.infoHash, 0, sizeof(serverCache.infoHash));
+        serverCache.source = ui_netSource.integer;
+    }
+
+    if(serverCache.infoHash[num] && serverCache.lanPing[num] == lanPing &&
+            uiInfo.uiDC.realTime - serverCache.updateTime[num] < maxAge) {
+        return;
+    }
+
+    trap_LAN_GetServerInfo(ui_netSource.integer, num, info, sizeof(info));
+    serverCache.updateTime[num] = uiInfo.uiDC.realTime;
+    serverCache.lanPing[num] = lanPing;
+
+    hash = UI_ServerInfoHash(info);
+
+    if(serverCache.infoHash[num] == hash) {
+        return;
+    }
+
+    serverCache.infoHash[num] = hash;
+
+    Info_ParseView(&view, info);
+
+    serverCache.clients[num] = Info_ViewInt(&view, "clients");
+    serverCache.maxClients[num] = Info_ViewInt(&view, "sv_maxclients");
+    serverCache.ping[num] = Info_ViewInt(&view, "ping");
+    serverCache.netType[num] = Info_ViewInt(&view, "nettype");
+
+    if(serverCache.netType[num] < 0 ||
+            serverCache.netType[num] >= ARRAY_LEN(netnames) - 1) {
+        serverCache.netType[num] = 0;
+    }
+
+    Info_ViewString(&view, "mapname", serverCache.mapName[num], MAX_QPATH);
+    Info_ViewString(&view, "game", serverCache.game[num], MAX_QPATH);
+    Info_ViewString(&view, "addr", serverCache.addr[num], MAX_ADDRESSLENGTH);
+
+    // strip leading whitespace from the name, and colours from its sort key
+    Info_ViewString(&view, "hostname", hostName, sizeof(hostName));
+
+    name = hostName;
+
+    while(*name == ' ') {
+        name++;
+    }
+
+    Q_strncpyz(serverCache.hostName[num], name, MAX_SERVER_NAME);
+    Q_strncpyz(serverCache.sortName[num], name, MAX_SERVER_NAME);
+    Q_CleanStr(serverCache.sortName[num]);
+}
+
+/*
+==================
+UI_CompareServers
+
+Orders two cached servers by the current sort key and direction
+==================
+*/
+static sint UI_CompareServers(sint s1, sint s2) {
+    sint res = 0;
+
+    switch(uiInfo.serverStatus.sortKey) {
+        case SORT_HOST:
+            res = Q_stricmp(serverCache.sortName[s1], serverCache.sortName[s2]);
+            break;
+
+        case SORT_MAP:
+            res = Q_stricmp(serverCache.mapName[s1], serverCache.mapName[s2]);
+            break;
+
+        case SORT_CLIENTS:
+            res = serverCache.clients[s1] - serverCache.clients[s2];
+            break;
+
+        case SORT_PING:
+            res = serverCache.ping[s1] - serverCache.ping[s2];
+            break;
+
+        case SORT_GAME:
+            res = Q_stricmp(serverCache.game[s1], serverCache.game[s2]);
+            break;
+    }
+
+    res = (res > 0) - (res < 0);
+
+    if(uiInfo.serverStatus.sortDir) {
+        return -res;
+    }
+
+    return res;
+}
+
 /*
 ==================
 UI_BinaryServerInsertion
@@ -349,10 +482,8 @@ static void UI_BinaryServerInsertion(sint num) {
     while(mid > 0) {
         mid = len >> 1;
         //
-        res = trap_LAN_CompareServers(ui_netSource.integer,
-                                      uiInfo.serverStatus.sortKey,
-                                      uiInfo.serverStatus.sortDir, num,
-                                      uiInfo.serverStatus.displayServers[offset + mid]);
+        res = UI_CompareServers(num,
+                                uiInfo.serverStatus.displayServers[offset + mid]);
         // if equal
 
         if(res == 0) {
@@ -841,7 +972,6 @@ UI_BuildServerDisplayList
 */
 static void UI_BuildServerDisplayList(bool force) {
     sint i, count, clients, maxClients, ping, len, visible;
-    valueType info[MAX_STRING_CHARS];
     static sint numinvisible;
 
     if(!(force ||
@@ -897,6 +1027,10 @@ static void UI_BuildServerDisplayList(bool force) {
         uiInfo.serverStatus.currentServerPreview = 0;
     }
 
+    if(count > MAX_SERVER_CACHE) {
+        count = MAX_SERVER_CACHE;
+    }
+
     visible = false;
 
     for(i = 0; i < count; i++) {
@@ -911,9 +1045,9 @@ static void UI_BuildServerDisplayList(bool force) {
         ping = trap_LAN_GetServerPing(ui_netSource.integer, i);
 
         if(ping > 0 || ui_netSource.integer == AS_GLOBAL) {
-            trap_LAN_GetServerInfo(ui_netSource.integer, i, info, MAX_STRING_CHARS);
+            UI_UpdateServerCache(i, ping, SERVER_CACHE_AGE);
 
-            clients = atoi(Info_ValueForKey(info, "clients"));
+            clients = serverCache.clients[i];
             uiInfo.serverStatus.numPlayersOnServers += clients;
 
             if(ui_browserShowEmpty.integer == 0) {
@@ -924,7 +1058,7 @@ static void UI_BuildServerDisplayList(bool force) {
             }
 
             if(ui_browserShowFull.integer == 0) {
-                maxClients = atoi(Info_ValueForKey(info, "sv_maxclients"));
+                maxClients = serverCache.maxClients[i];
 
                 if(clients == maxClients) {
                     trap_LAN_MarkServerVisible(ui_netSource.integer, i, false);
@@ -939,11 +1073,9 @@ static void UI_BuildServerDisplayList(bool force) {
 
             // insert the server into the list
             if(uiInfo.serverStatus.numDisplayServers == 0) {
-                valueType *s = Info_ValueForKey(info, "mapname");
-
-                if(s && *s) {
+                if(serverCache.mapName[i][0]) {
                     uiInfo.serverStatus.currentServerPreview = trap_R_RegisterShaderNoMip(
-                                va("levelshots/%s", Info_ValueForKey(info, "mapname")));
+                                va("levelshots/%s", serverCache.mapName[i]));
                 } else {
                     uiInfo.serverStatus.currentServerPreview =
                         trap_R_RegisterShaderNoMip("levelshots/unknownmap");
@@ -1128,6 +1260,9 @@ void idUserInterfaceManagerLocal::Refresh(sint realtime) {
     //  return;
     //}
 
+    // last frame's scratch strings are done with
+    Com_ScratchReset();
+
     uiInfo.uiDC.frameTime = realtime - uiInfo.uiDC.realTime;
     uiInfo.uiDC.realTime = realtime;
 
@@ -1611,14 +1746,14 @@ static void UI_DrawInfoPane(menuItem_t *item, rectDef_t *rect,
                      ALIEN_CREDITS_PER_FRAG - 1) / ALIEN_CREDITS_PER_FRAG;
 
             if(value < 1) {
-                s = va("%s\n\n%s",
-                       bggame->ClassConfig(item->v.pclass)->humanName,
-                       bggame->Class(item->v.pclass)->info);
+                s = Com_ScratchPrintf("%s\n\n%s",
+                                      bggame->ClassConfig(item->v.pclass)->humanName,
+                                      bggame->Class(item->v.pclass)->info);
             } else {
-                s = va("%s\n\n%s\n\nFrags: %d",
-                       bggame->ClassConfig(item->v.pclass)->humanName,
-                       bggame->Class(item->v.pclass)->info,
-                       value);
+                s = Com_ScratchPrintf("%s\n\n%s\n\nFrags: %d",
+                                      bggame->ClassConfig(item->v.pclass)->humanName,
+                                      bggame->Class(item->v.pclass)->info,
+                                      value);
             }
 
             break;
@@ -1627,14 +1762,14 @@ static void UI_DrawInfoPane(menuItem_t *item, rectDef_t *rect,
             value = bggame->Weapon(item->v.weapon)->price;
 
             if(value == 0) {
-                s = va("%s\n\n%s\n\nCredits: Free",
-                       bggame->Weapon(item->v.weapon)->humanName,
-                       bggame->Weapon(item->v.weapon)->info);
+                s = Com_ScratchPrintf("%s\n\n%s\n\nCredits: Free",
+                                      bggame->Weapon(item->v.weapon)->humanName,
+                                      bggame->Weapon(item->v.weapon)->info);
             } else {
-                s = va("%s\n\n%s\n\nCredits: %d",
-                       bggame->Weapon(item->v.weapon)->humanName,
-                       bggame->Weapon(item->v.weapon)->info,
-                       value);
+                s = Com_ScratchPrintf("%s\n\n%s\n\nCredits: %d",
+                                      bggame->Weapon(item->v.weapon)->humanName,
+                                      bggame->Weapon(item->v.weapon)->info,
+                                      value);
             }
 
             break;
@@ -1643,14 +1778,14 @@ static void UI_DrawInfoPane(menuItem_t *item, rectDef_t *rect,
             value = bggame->Upgrade(item->v.upgrade)->price;
 
             if(value == 0) {
-                s = va("%s\n\n%s\n\nCredits: Free",
-                       bggame->Upgrade(item->v.upgrade)->humanName,
-                       bggame->Upgrade(item->v.upgrade)->info);
+                s = Com_ScratchPrintf("%s\n\n%s\n\nCredits: Free",
+                                      bggame->Upgrade(item->v.upgrade)->humanName,
+                                      bggame->Upgrade(item->v.upgrade)->info);
             } else {
-                s = va("%s\n\n%s\n\nCredits: %d",
-                       bggame->Upgrade(item->v.upgrade)->humanName,
-                       bggame->Upgrade(item->v.upgrade)->info,
-                       value);
+                s = Com_ScratchPrintf("%s\n\n%s\n\nCredits: %d",
+                                      bggame->Upgrade(item->v.upgrade)->humanName,
+                                      bggame->Upgrade(item->v.upgrade)->info,
+                                      value);
             }
 
             break;
@@ -1672,14 +1807,14 @@ static void UI_DrawInfoPane(menuItem_t *item, rectDef_t *rect,
             }
 
             if(value == 0) {
-                s = va("%s\n\n%s",
-                       bggame->Buildable(item->v.buildable)->humanName,
-                       bggame->Buildable(item->v.buildable)->info);
+                s = Com_ScratchPrintf("%s\n\n%s",
+                                      bggame->Buildable(item->v.buildable)->humanName,
+                                      bggame->Buildable(item->v.buildable)->info);
             } else {
-                s = va("%s\n\n%s\n\n%s: %d",
-                       bggame->Buildable(item->v.buildable)->humanName,
-                       bggame->Buildable(item->v.buildable)->info,
-                       string, value);
+                s = Com_ScratchPrintf("%s\n\n%s\n\n%s: %d",
+                                      bggame->Buildable(item->v.buildable)->humanName,
+                                      bggame->Buildable(item->v.buildable)->info,
+                                      string, value);
             }
 
             break;
@@ -1791,12 +1926,14 @@ static pointer UI_OwnerDrawText(sint ownerDraw) {
 
                 dots[ i ] = '\0';
 
-                s = numServers < 0 ? va("Waiting for response%s", dots) :
-                    va("Getting info for %d servers (ESC to cancel)%s", numServers, dots);
+                s = numServers < 0 ?
+                    Com_ScratchPrintf("Waiting for response%s", dots) :
+                    Com_ScratchPrintf("Getting info for %d servers (ESC to cancel)%s",
+                                      numServers, dots);
             } else {
-                s = va("Refresh Time: %s",
-                       UI_Cvar_VariableString(va("ui_lastServerRefresh_%i",
-                                                 ui_netSource.integer)));
+                s = Com_ScratchPrintf("Refresh Time: %s",
+                                      UI_Cvar_VariableString(va("ui_lastServerRefresh_%i",
+                                                                ui_netSource.integer)));
             }
 
             break;
@@ -2160,9 +2297,7 @@ UI_ServersQsortCompare
 =================
 */
 static sint UI_ServersQsortCompare(const void *arg1, const void *arg2) {
-    return trap_LAN_CompareServers(ui_netSource.integer,
-                                   uiInfo.serverStatus.sortKey,
-                                   uiInfo.serverStatus.sortDir, *(sint *)arg1, *(sint *)arg2);
+    return UI_CompareServers(*(sint *)arg1, *(sint *)arg2);
 }
 
 
@@ -3851,12 +3986,9 @@ static pointer UI_SelectedMap(sint index, sint *actual) {
 
 static pointer UI_FeederItemText(float32 feederID, sint index, sint column,
                                  qhandle_t *handle) {
-    static valueType info[MAX_STRING_CHARS];
     static valueType hostname[1024];
     static valueType clientBuff[32];
     static valueType resolution[MAX_STRING_CHARS];
-    static sint lastColumn = -1;
-    static sint lastTime = 0;
 
     if(handle) {
         *handle = -1;
@@ -3867,17 +3999,12 @@ static pointer UI_FeederItemText(float32 feederID, sint index, sint column,
         return UI_SelectedMap(index, &actual);
     } else if(feederID == FEEDER_SERVERS) {
         if(index >= 0 && index < uiInfo.serverStatus.numDisplayServers) {
-            sint ping;
-
-            if(lastColumn != column || lastTime > uiInfo.uiDC.realTime + 5000) {
-                trap_LAN_GetServerInfo(ui_netSource.integer,
-                                       uiInfo.serverStatus.displayServers[index],
-                                       info, MAX_STRING_CHARS);
-                lastColumn = column;
-                lastTime = uiInfo.uiDC.realTime;
-            }
+            sint server, ping;
 
-            ping = atoi(Info_ValueForKey(info, "ping"));
+            server = uiInfo.serverStatus.displayServers[index];
+            UI_UpdateServerCache(server,
+                                 trap_LAN_GetServerPing(ui_netSource.integer, server), 1000);
+            ping = serverCache.ping[server];
 
             if(ping == -1) {
                 // if we ever see a ping that is out of date, do a server refresh
@@ -3887,44 +4014,31 @@ static pointer UI_FeederItemText(float32 feederID, sint index, sint column,
             switch(column) {
                 case SORT_HOST:
                     if(ping <= 0) {
-                        return Info_ValueForKey(info, "addr");
+                        return serverCache.addr[server];
                     } else {
                         if(ui_netSource.integer == AS_LOCAL) {
                             Q_vsprintf_s(hostname, sizeof(hostname), sizeof(hostname), "%s [%s]",
-                                         Info_ValueForKey(info, "hostname"),
-                                         netnames[atoi(Info_ValueForKey(info, "nettype"))]);
+                                         serverCache.hostName[server],
+                                         netnames[serverCache.netType[server]]);
                             return hostname;
                         } else {
-                            valueType *text;
-
-                            Q_vsprintf_s(hostname, sizeof(hostname), sizeof(hostname), "%s",
-                                         Info_ValueForKey(info, "hostname"));
-
-                            // Strip leading whitespace
-                            text = hostname;
-
-                            while(*text != '\0' && *text == ' ') {
-                                text++;
-                            }
-
-                            return text;
+                            return serverCache.hostName[server];
                         }
                     }
 
                 case SORT_MAP:
-                    return Info_ValueForKey(info, "mapname");
+                    return serverCache.mapName[server];
 
                 case SORT_CLIENTS:
-                    Q_vsprintf_s(clientBuff, sizeof(clientBuff), sizeof(clientBuff), "%s (%s)",
-                                 Info_ValueForKey(info, "clients"), Info_ValueForKey(info,
-                                         "sv_maxclients"));
+                    Q_vsprintf_s(clientBuff, sizeof(clientBuff), sizeof(clientBuff), "%d (%d)",
+                                 serverCache.clients[server], serverCache.maxClients[server]);
                     return clientBuff;
 
                 case SORT_PING:
                     if(ping <= 0) {
                         return "...";
                     } else {
-                        return Info_ValueForKey(info, "ping");
+                        return va("%d", ping);
                     }
             }
         }
@@ -4825,6 +4939,9 @@ void idUserInterfaceManagerLocal::DrawConnectScreen(bool overlay) {
 
     menuDef_t *menu = Menus_FindByName("Connect");
 
+    // the connect screen is painted without a Refresh
+    Com_ScratchReset();
+
     if(!overlay && menu) {
         Menu_Paint(menu, true);
     }
@@ -4963,6 +5080,7 @@ void UI_RegisterCvars(void) {
     for(i = 0, cv = cvarTable ; i < cvarTableSize ; i++, cv++) {
         trap_Cvar_Register(cv->vmCvar, cv->cvarName, cv->defaultString,
                            cv->cvarFlags, cv->description);
+        cv->cvar = trap_Cvar_Find(cv->cvarName);
     }
 
     // use ui messagemode
@@ -4972,6 +5090,8 @@ void UI_RegisterCvars(void) {
 /*
 =================
 UI_UpdateCvars
+
+Only asks the engine for the cvars that changed
 =================
 */
 void UI_UpdateCvars(void) {
@@ -4979,6 +5099,11 @@ void UI_UpdateCvars(void) {
     cvarTable_t *cv;
 
     for(i = 0, cv = cvarTable ; i < cvarTableSize ; i++, cv++) {
+        if(cv->cvar &&
+                cv->cvar->modificationCount == cv->vmCvar->modificationCount) {
+            continue;
+        }
+
         trap_Cvar_Update(cv->vmCvar);
     }
 }
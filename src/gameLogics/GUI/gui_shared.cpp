@@ -87,6 +87,9 @@ static sint lastListBoxClickTime = 0;
 
 itemDataType_t Item_DataType(itemDef_t *item);
 void Item_RunScript(itemDef_t *item, pointer s);
+void Script_InitPrograms(void);
+static void Menu_ClearNameIndex(void);
+void UI_Text_ClearRuns(void);
 void Item_SetupKeywordHash(void);
 void Menu_SetupKeywordHash(void);
 sint BindingIDFromName(pointer name);
@@ -340,8 +343,14 @@ void String_Init(void) {
 
     strPoolIndex = 0;
 
+    Script_InitPrograms();
+
+    UI_Text_ClearRuns();
+
     menuCount = 0;
 
+    Menu_ClearNameIndex();
+
     openMenuCount = 0;
 
     UI_InitMemory();
@@ -1378,16 +1387,68 @@ void Script_SetBackground(itemDef_t *item, valueType **args) {
 
 
 
+static nameIndex_t menuNameIndex;
+static itemDef_t *itemNameHash[HASH_TABLE_SIZE];
+
+/*
+=================
+Menu_ClearNameIndex
+=================
+*/
+static void Menu_ClearNameIndex(void) {
+    Com_NameIndexClear(&menuNameIndex);
+    ::memset(itemNameHash, 0, sizeof(itemNameHash));
+}
+
+/*
+=================
+Item_NameHash
+
+Items are hashed on their menu as well as their name
+=================
+*/
+static sint Item_NameHash(menuDef_t *menu, pointer name) {
+    return (hashForString(name) + (sint)((uintptr_t)menu >> 4)) &
+           (HASH_TABLE_SIZE - 1);
+}
+
+/*
+=================
+Menu_IndexItems
+
+Called once a menu has parsed
+=================
+*/
+static void Menu_IndexItems(menuDef_t *menu) {
+    itemDef_t *item;
+    sint i, hash;
+
+    for(i = 0; i < menu->itemCount; i++) {
+        item = menu->items[i];
+
+        // only the first of several items with the same name can be found
+        if(item->window.name == nullptr ||
+                Menu_FindItemByName(menu, item->window.name)) {
+            continue;
+        }
+
+        hash = Item_NameHash(menu, item->window.name);
+        item->nameHashNext = itemNameHash[hash];
+        itemNameHash[hash] = item;
+    }
+}
+
 itemDef_t *Menu_FindItemByName(menuDef_t *menu, pointer p) {
-    sint i;
+    itemDef_t *item;
 
     if(menu == nullptr || p == nullptr) {
         return nullptr;
     }
 
-    for(i = 0; i < menu->itemCount; i++) {
-        if(Q_stricmp(p, menu->items[i]->window.name) == 0) {
-            return menu->items[i];
+    for(item = itemNameHash[Item_NameHash(menu, p)]; item;
+            item = item->nameHashNext) {
+        if(item->parent == menu && Q_stricmp(p, item->window.name) == 0) {
+            return item;
         }
     }
 
@@ -1482,13 +1543,15 @@ void Menu_FadeItemByName(menuDef_t *menu, pointer p, bool fadeOut) {
     }
 }
 
+static pointer Menu_IndexName(sint i) {
+    return Menus[i].window.name;
+}
+
 menuDef_t *Menus_FindByName(pointer p) {
-    sint i;
+    sint i = Com_NameIndexFind(&menuNameIndex, menuCount, Menu_IndexName, p);
 
-    for(i = 0; i < menuCount; i++) {
-        if(Q_stricmp(Menus[i].window.name, p) == 0) {
-            return &Menus[i];
-        }
+    if(i >= 0) {
+        return &Menus[i];
     }
 
     return nullptr;
@@ -2339,23 +2402,71 @@ static bool UI_Text_Emoticon(pointer s, bool *escaped, sint *length,
 }
 
 
+#define UI_LAYOUT_HASH_INIT 2166136261u
+
+/*
+==================
+UI_LayoutHash
+
+FNV-1a, used to tell whether the text layout worked out for an item is
+still good without comparing everything it came from
+==================
+*/
+static uint32 UI_LayoutHash(uint32 hash, const void *data, sint length) {
+    const uchar8 *bytes = (const uchar8 *)data;
+    sint i;
+
+    for(i = 0; i < length; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+static uint32 UI_LayoutHashString(uint32 hash, pointer text) {
+    return UI_LayoutHash(hash, text, strlen(text));
+}
+
+/*
+=================
+UI_FontForScale
+
+The font size thresholds are cvars, so look them up once a frame rather
+than for every string measured or drawn
+=================
+*/
+static fontInfo_t *UI_FontForScale(float32 scale) {
+    static sint thresholdTime = -1;
+    static float32 smallFont, bigFont;
+
+    if(thresholdTime != DC->realTime) {
+        thresholdTime = DC->realTime;
+        smallFont = DC->getCVarValue("ui_smallFont");
+        bigFont = DC->getCVarValue("ui_bigFont");
+    }
+
+    if(scale <= smallFont) {
+        return &DC->Assets.smallFont;
+    } else if(scale >= bigFont) {
+        return &DC->Assets.bigFont;
+    }
+
+    return &DC->Assets.textFont;
+}
+
 float32 UI_Text_Width(pointer text, float32 scale, sint limit) {
     sint count, len;
     float32 out;
     glyphInfo_t *glyph;
     float32 useScale;
     pointer s = text;
-    fontInfo_t *font = &DC->Assets.textFont;
+    fontInfo_t *font;
     sint emoticonLen;
     bool emoticonEscaped;
     float32 emoticonW;
     sint emoticons = 0;
 
-    if(scale <= DC->getCVarValue("ui_smallFont")) {
-        font = &DC->Assets.smallFont;
-    } else if(scale >= DC->getCVarValue("ui_bigFont")) {
-        font = &DC->Assets.bigFont;
-    }
+    font = UI_FontForScale(scale);
 
     useScale = scale * font->glyphScale;
     emoticonW = UI_Text_Height("[", scale, 0) * DC->aspectScale;
@@ -2402,13 +2513,7 @@ float32 UI_Text_Height(pointer text, float32 scale, sint limit) {
     glyphInfo_t *glyph;
     float32 useScale;
     pointer s = text;
-    fontInfo_t *font = &DC->Assets.textFont;
-
-    if(scale <= DC->getCVarValue("ui_smallFont")) {
-        font = &DC->Assets.smallFont;
-    } else if(scale >= DC->getCVarValue("ui_bigFont")) {
-        font = &DC->Assets.bigFont;
-    }
+    fontInfo_t *font = UI_FontForScale(scale);
 
     useScale = scale * font->glyphScale;
     max = 0;
@@ -2495,15 +2600,11 @@ void UI_Text_Paint_Limit(float32 *maxX, float32 x, float32 y,
         pointer s = text;
         float32 max = *maxX;
         float32 useScale;
-        fontInfo_t *font = &DC->Assets.textFont;
+        fontInfo_t *font;
 
         memcpy(&newColor[0], &color[0], sizeof(vec4_t));
 
-        if(scale <= DC->getCVarValue("ui_smallFont")) {
-            font = &DC->Assets.smallFont;
-        } else if(scale > DC->getCVarValue("ui_bigFont")) {
-            font = &DC->Assets.bigFont;
-        }
+        font = UI_FontForScale(scale);
 
         useScale = scale * font->glyphScale;
 
@@ -2571,160 +2672,325 @@ void UI_Text_Paint_Limit(float32 *maxX, float32 x, float32 y,
     }
 }
 
-void UI_Text_Paint(float32 x, float32 y, float32 scale, vec4_t color,
-                   pointer text,
-                   float32 adjust, sint limit, sint style) {
-    sint len, count;
-    vec4_t newColor;
-    glyphInfo_t *glyph;
+/*
+ * Strings are laid out once into a glyph run, the glyphs with their
+ * offsets, the colour each is in and where the emoticons go, and the run
+ * is kept in a small set associative cache. Painting a run draws each
+ * pass of a text style over the whole string, so the colour only changes
+ * when the text asks for it rather than around every glyph.
+ */
+#define MAX_TEXT_RUN_SETS     32
+#define MAX_TEXT_RUN_WAYS     4
+#define MAX_TEXT_RUN_TEXT     192
+#define MAX_TEXT_RUN_SCRATCH  4096
+
+typedef struct {
+    glyphInfo_t *glyph;             // nullptr for an emoticon
+    qhandle_t emoticon;
+    sint colorIndex;                // -1 until the text sets a colour
+    float32 x, yadj;
+    float32 width, height;
+}
+textRunGlyph_t;
+
+typedef struct {
+    bool valid;
+    uint32 hash;
+    sint lastUsed;
+    valueType text[MAX_TEXT_RUN_TEXT];
+    float32 scale, adjust, aspectScale;
+    sint limit;
+    sint emoticonCount;
+    fontInfo_t *font;
     float32 useScale;
-    fontInfo_t *font = &DC->Assets.textFont;
-    sint emoticonLen = 0;
+    float32 emoticonH;
+    textRunGlyph_t *glyphs;
+    sint numGlyphs, maxGlyphs;
+}
+textRun_t;
+
+static textRun_t textRuns[MAX_TEXT_RUN_SETS * MAX_TEXT_RUN_WAYS];
+static textRunGlyph_t textRunGlyphs[MAX_TEXT_RUN_SETS *
+                                    MAX_TEXT_RUN_WAYS][MAX_TEXT_RUN_TEXT];
+static textRun_t textRunScratch;
+static textRunGlyph_t textRunScratchGlyphs[MAX_TEXT_RUN_SCRATCH];
+static sint textRunTime;
+
+/*
+=================
+UI_Text_ClearRuns
+
+Runs hold emoticon shaders, so they go whenever the assets are reloaded
+=================
+*/
+void UI_Text_ClearRuns(void) {
+    sint i;
+
+    for(i = 0; i < ARRAY_LEN(textRuns); i++) {
+        textRuns[ i ].valid = false;
+    }
+}
+
+/*
+=================
+UI_Text_BuildRun
+=================
+*/
+static void UI_Text_BuildRun(textRun_t *run, pointer text) {
+    pointer s = text;
+    glyphInfo_t *glyph;
+    textRunGlyph_t *g;
+    sint len, count = 0, colorIndex = -1;
+    sint emoticonLen = 0, emoticonWidth;
     qhandle_t emoticonHandle = 0;
-    float32 emoticonH, emoticonW;
     bool emoticonEscaped;
-    sint emoticonWidth;
+    float32 x = 0, yadj, emoticonW;
+
+    run->useScale = run->scale * run->font->glyphScale;
+    run->emoticonH = UI_Text_Height("[", run->scale, 0);
+    run->numGlyphs = 0;
+    emoticonW = run->emoticonH * DC->aspectScale;
 
-    if(scale <= DC->getCVarValue("ui_smallFont")) {
-        font = &DC->Assets.smallFont;
-    } else if(scale >= DC->getCVarValue("ui_bigFont")) {
-        font = &DC->Assets.bigFont;
+    len = strlen(text);
+
+    if(run->limit > 0 && len > run->limit) {
+        len = run->limit;
     }
 
-    emoticonH = UI_Text_Height("[", scale, 0);
-    emoticonW = emoticonH * DC->aspectScale;
-    useScale = scale * font->glyphScale;
+    while(s && *s && count < len && run->numGlyphs < run->maxGlyphs) {
+        glyph = &run->font->glyphs[(uchar8) * s];
+        yadj = run->useScale * glyph->top;
 
-    if(text) {
-        pointer s = text;
-        DC->setColor(color);
-        memcpy(&newColor[0], &color[0], sizeof(vec4_t));
-        len = strlen(text);
+        if(Q_IsColorString(s)) {
+            colorIndex = ColorIndex(*(s + 1));
+            s += 2;
+            continue;
+        } else if(UI_Text_Emoticon(s, &emoticonEscaped, &emoticonLen,
+                                   &emoticonHandle, &emoticonWidth)) {
+            if(emoticonEscaped) {
+                s++;
+            } else {
+                g = &run->glyphs[ run->numGlyphs++ ];
+                g->glyph = nullptr;
+                g->emoticon = emoticonHandle;
+                g->colorIndex = colorIndex;
+                g->x = x;
+                g->yadj = yadj;
+                g->width = emoticonW * emoticonWidth;
+                g->height = run->emoticonH;
+
+                x += (emoticonW * emoticonWidth);
+                s += emoticonLen;
+                continue;
+            }
+        }
 
-        if(limit > 0 && len > limit) {
-            len = limit;
+        g = &run->glyphs[ run->numGlyphs++ ];
+        g->glyph = glyph;
+        g->emoticon = 0;
+        g->colorIndex = colorIndex;
+        g->x = x;
+        g->yadj = yadj;
+        g->width = glyph->imageWidth * DC->aspectScale;
+        g->height = glyph->imageHeight;
+
+        x += (glyph->xSkip * DC->aspectScale * run->useScale) + run->adjust;
+        s++;
+        count++;
+    }
+}
+
+/*
+=================
+UI_Text_GetRun
+
+Finds the glyph run for a string, laying it out if it isn't cached
+=================
+*/
+static textRun_t *UI_Text_GetRun(pointer text, float32 scale,
+                                 float32 adjust, sint limit) {
+    fontInfo_t *font = UI_FontForScale(scale);
+    textRun_t *run, *set;
+    uint32 hash;
+    sint i;
+
+    if(strlen(text) >= MAX_TEXT_RUN_TEXT) {
+        // too long to keep, lay it out for this paint only
+        run = &textRunScratch;
+        run->glyphs = textRunScratchGlyphs;
+        run->maxGlyphs = MAX_TEXT_RUN_SCRATCH;
+        run->scale = scale;
+        run->adjust = adjust;
+        run->limit = limit;
+        run->font = font;
+        UI_Text_BuildRun(run, text);
+        return run;
+    }
+
+    hash = UI_LayoutHashString(UI_LAYOUT_HASH_INIT, text);
+    hash = UI_LayoutHash(hash, &scale, sizeof(scale));
+    hash = UI_LayoutHash(hash, &adjust, sizeof(adjust));
+    hash = UI_LayoutHash(hash, &limit, sizeof(limit));
+
+    set = &textRuns[(hash % MAX_TEXT_RUN_SETS) * MAX_TEXT_RUN_WAYS ];
+    run = set;
+
+    for(i = 0; i < MAX_TEXT_RUN_WAYS; i++) {
+        if(set[i].valid && set[i].hash == hash && set[i].font == font &&
+                set[i].scale == scale && set[i].adjust == adjust &&
+                set[i].limit == limit && set[i].aspectScale == DC->aspectScale &&
+                set[i].emoticonCount == DC->Assets.emoticonCount &&
+                !strcmp(set[i].text, text)) {
+            set[i].lastUsed = ++textRunTime;
+            return &set[i];
+        }
+
+        // replace an unused way or else the least recently used one
+        if(!run->valid) {
+            continue;
         }
 
-        count = 0;
+        if(!set[i].valid || set[i].lastUsed < run->lastUsed) {
+            run = &set[i];
+        }
+    }
 
-        while(s && *s && count < len) {
-            float32 width, height, skip, yadj;
+    run->valid = true;
+    run->hash = hash;
+    run->lastUsed = ++textRunTime;
+    Q_strncpyz(run->text, text, sizeof(run->text));
+    run->scale = scale;
+    run->adjust = adjust;
+    run->limit = limit;
+    run->aspectScale = DC->aspectScale;
+    run->emoticonCount = DC->Assets.emoticonCount;
+    run->font = font;
+    run->glyphs = textRunGlyphs[ run - textRuns ];
+    run->maxGlyphs = MAX_TEXT_RUN_TEXT;
+    UI_Text_BuildRun(run, text);
 
-            glyph = &font->glyphs[(uchar8) * s];
-            width = glyph->imageWidth * DC->aspectScale;
-            height = glyph->imageHeight;
-            skip = glyph->xSkip * DC->aspectScale;
-            yadj = useScale * glyph->top;
+    return run;
+}
 
-            if(Q_IsColorString(s)) {
-                memcpy(newColor, g_color_table[ColorIndex(*(s + 1))], sizeof(newColor));
-                newColor[3] = color[3];
-                DC->setColor(newColor);
-                s += 2;
-                continue;
-            } else if(UI_Text_Emoticon(s, &emoticonEscaped, &emoticonLen,
-                                       &emoticonHandle, &emoticonWidth)) {
-                if(emoticonEscaped) {
-                    s++;
-                } else {
-                    DC->setColor(nullptr);
-                    DC->drawHandlePic(x, y - yadj, (emoticonW * emoticonWidth),
-                                      emoticonH, emoticonHandle);
-                    DC->setColor(newColor);
-                    x += (emoticonW * emoticonWidth);
-                    s += emoticonLen;
-                    continue;
-                }
-            }
+/*
+=================
+UI_Text_RunColor
 
-            if(style == ITEM_TEXTSTYLE_SHADOWED ||
-                    style == ITEM_TEXTSTYLE_SHADOWEDMORE) {
-                sint ofs = style == ITEM_TEXTSTYLE_SHADOWED ? 1 : 2;
-                colorBlack[3] = newColor[3];
-                DC->setColor(colorBlack);
-                UI_Text_PaintChar(x + ofs, y - yadj + ofs,
-                                  width,
-                                  height,
-                                  useScale,
-                                  glyph->s,
-                                  glyph->t,
-                                  glyph->s2,
-                                  glyph->t2,
-                                  glyph->glyph);
-                DC->setColor(newColor);
-                colorBlack[3] = 1.0;
-            } else if(style == ITEM_TEXTSTYLE_NEON) {
-                vec4_t glow, outer, inner, white;
+The colour a glyph is drawn in, colour codes keep the alpha passed in
+=================
+*/
+static void UI_Text_RunColor(textRunGlyph_t *g, const vec4_t color,
+                             vec4_t out) {
+    if(g->colorIndex < 0) {
+        Vector4Copy(color, out);
+    } else {
+        Vector4Copy(g_color_table[ g->colorIndex ], out);
+        out[3] = color[3];
+    }
+}
 
-                glow[0] = newColor[0] * 0.5;
-                glow[1] = newColor[1] * 0.5;
-                glow[2] = newColor[2] * 0.5;
-                glow[3] = newColor[3] * 0.2;
+/*
+=================
+UI_Text_PaintRunPass
 
-                outer[0] = newColor[0];
-                outer[1] = newColor[1];
-                outer[2] = newColor[2];
-                outer[3] = newColor[3];
+Draws every glyph of a run once, grown by grow and moved by offset, in
+the colour colorFunc makes of its text colour
+=================
+*/
+static void UI_Text_PaintRunPass(textRun_t *run, float32 x, float32 y,
+                                 vec4_t color, float32 grow, float32 offset,
+                                 void (*colorFunc)(const vec4_t in, vec4_t out)) {
+    textRunGlyph_t *g;
+    vec4_t glyphColor;
+    sint i, lastColor = -2;
+
+    for(i = 0, g = run->glyphs; i < run->numGlyphs; i++, g++) {
+        if(!g->glyph) {
+            continue;
+        }
 
-                inner[0] = newColor[0] * 1.5 > 1.0f ? 1.0f : newColor[0] * 1.5;
-                inner[1] = newColor[1] * 1.5 > 1.0f ? 1.0f : newColor[1] * 1.5;
-                inner[2] = newColor[2] * 1.5 > 1.0f ? 1.0f : newColor[2] * 1.5;
-                inner[3] = newColor[3];
+        if(g->colorIndex != lastColor) {
+            UI_Text_RunColor(g, color, glyphColor);
+            colorFunc(glyphColor, glyphColor);
+            DC->setColor(glyphColor);
+            lastColor = g->colorIndex;
+        }
 
-                white[0] = white[1] = white[2] = white[3] = 1.0f;
+        UI_Text_PaintChar(x + g->x + offset, y - g->yadj + offset,
+                          g->width + grow,
+                          g->height + grow,
+                          run->useScale,
+                          g->glyph->s,
+                          g->glyph->t,
+                          g->glyph->s2,
+                          g->glyph->t2,
+                          g->glyph->glyph);
+    }
+}
 
-                DC->setColor(glow);
-                UI_Text_PaintChar(x - 1.5, y - yadj - 1.5,
-                                  width + 3,
-                                  height + 3,
-                                  useScale,
-                                  glyph->s,
-                                  glyph->t,
-                                  glyph->s2,
-                                  glyph->t2,
-                                  glyph->glyph);
+static void UI_Text_ShadowColor(const vec4_t in, vec4_t out) {
+    out[0] = out[1] = out[2] = 0.0f;
+    out[3] = in[3];
+}
 
-                DC->setColor(outer);
-                UI_Text_PaintChar(x - 1, y - yadj - 1,
-                                  width + 2,
-                                  height + 2,
-                                  useScale,
-                                  glyph->s,
-                                  glyph->t,
-                                  glyph->s2,
-                                  glyph->t2,
-                                  glyph->glyph);
+static void UI_Text_GlowColor(const vec4_t in, vec4_t out) {
+    out[0] = in[0] * 0.5;
+    out[1] = in[1] * 0.5;
+    out[2] = in[2] * 0.5;
+    out[3] = in[3] * 0.2;
+}
 
-                DC->setColor(inner);
-                UI_Text_PaintChar(x - 0.5, y - yadj - 0.5,
-                                  width + 1,
-                                  height + 1,
-                                  useScale,
-                                  glyph->s,
-                                  glyph->t,
-                                  glyph->s2,
-                                  glyph->t2,
-                                  glyph->glyph);
+static void UI_Text_OuterColor(const vec4_t in, vec4_t out) {
+    Vector4Copy(in, out);
+}
 
-                DC->setColor(white);
-            }
+static void UI_Text_InnerColor(const vec4_t in, vec4_t out) {
+    out[0] = in[0] * 1.5 > 1.0f ? 1.0f : in[0] * 1.5;
+    out[1] = in[1] * 1.5 > 1.0f ? 1.0f : in[1] * 1.5;
+    out[2] = in[2] * 1.5 > 1.0f ? 1.0f : in[2] * 1.5;
+    out[3] = in[3];
+}
 
-            UI_Text_PaintChar(x, y - yadj,
-                              width,
-                              height,
-                              useScale,
-                              glyph->s,
-                              glyph->t,
-                              glyph->s2,
-                              glyph->t2,
-                              glyph->glyph);
+static void UI_Text_WhiteColor(const vec4_t in, vec4_t out) {
+    out[0] = out[1] = out[2] = out[3] = 1.0f;
+}
 
-            x += (skip * useScale) + adjust;
-            s++;
-            count++;
-        }
+void UI_Text_Paint(float32 x, float32 y, float32 scale, vec4_t color,
+                   pointer text,
+                   float32 adjust, sint limit, sint style) {
+    textRun_t *run;
+    textRunGlyph_t *g;
+    sint i;
 
-        DC->setColor(nullptr);
+    if(!text) {
+        return;
+    }
+
+    run = UI_Text_GetRun(text, scale, adjust, limit);
+
+    if(style == ITEM_TEXTSTYLE_SHADOWED ||
+            style == ITEM_TEXTSTYLE_SHADOWEDMORE) {
+        sint ofs = style == ITEM_TEXTSTYLE_SHADOWED ? 1 : 2;
+
+        UI_Text_PaintRunPass(run, x, y, color, 0, ofs, &UI_Text_ShadowColor);
+        UI_Text_PaintRunPass(run, x, y, color, 0, 0, &UI_Text_OuterColor);
+    } else if(style == ITEM_TEXTSTYLE_NEON) {
+        UI_Text_PaintRunPass(run, x, y, color, 3, -1.5, &UI_Text_GlowColor);
+        UI_Text_PaintRunPass(run, x, y, color, 2, -1, &UI_Text_OuterColor);
+        UI_Text_PaintRunPass(run, x, y, color, 1, -0.5, &UI_Text_InnerColor);
+        UI_Text_PaintRunPass(run, x, y, color, 0, 0, &UI_Text_WhiteColor);
+    } else {
+        UI_Text_PaintRunPass(run, x, y, color, 0, 0, &UI_Text_OuterColor);
+    }
+
+    // emoticons go over the text, untinted
+    DC->setColor(nullptr);
+
+    for(i = 0, g = run->glyphs; i < run->numGlyphs; i++, g++) {
+        if(!g->glyph) {
+            DC->drawHandlePic(x + g->x, y - g->yadj, g->width, g->height,
+                              g->emoticon);
+        }
     }
 }
 
@@ -2737,13 +3003,7 @@ void UI_Text_PaintWithCursor(float32 x, float32 y, float32 scale,
     glyphInfo_t *glyph, * glyph2;
     float32 yadj;
     float32 useScale;
-    fontInfo_t *font = &DC->Assets.textFont;
-
-    if(scale <= DC->getCVarValue("ui_smallFont")) {
-        font = &DC->Assets.smallFont;
-    } else if(scale >= DC->getCVarValue("ui_bigFont")) {
-        font = &DC->Assets.bigFont;
-    }
+    fontInfo_t *font = UI_FontForScale(scale);
 
     useScale = scale * font->glyphScale;
 
@@ -2934,61 +3194,323 @@ commandDef_t commandList[] = {
 sint scriptCommandCount = sizeof(commandList) / sizeof(commandDef_t);
 
 
-void Item_RunScript(itemDef_t *item, pointer s) {
-    valueType script[1024], * p;
+/*
+ * Scripts are compiled once when they are parsed into a list of commands
+ * resolved against commandList, each with its argument text up to the
+ * next ; kept as an interned string. Programs are found again through
+ * the address of the interned script they were built from.
+ */
+typedef struct scriptOp_s {
+    sint command;                   // commandList index, -1 for DC->runScript
+    pointer args;
+}
+scriptOp_t;
+
+typedef struct scriptProgram_s {
+    pointer source;
+    scriptOp_t *ops;
+    sint numOps;
+    struct scriptProgram_s *next;
+}
+scriptProgram_t;
+
+static scriptProgram_t scriptPrograms[MAX_SCRIPT_PROGRAMS];
+static sint numScriptPrograms;
+static scriptProgram_t *scriptProgramHash[HASH_TABLE_SIZE];
+static scriptOp_t scriptOps[MAX_SCRIPT_OPS];
+static sint numScriptOps;
+
+static pointer cvarTestValues[MAX_CVAR_TEST_VALUES];
+static sint numCvarTestValues;
+
+/*
+=================
+Script_InitPrograms
+=================
+*/
+void Script_InitPrograms(void) {
+    numScriptPrograms = 0;
+    numScriptOps = 0;
+    numCvarTestValues = 0;
+    ::memset(scriptProgramHash, 0, sizeof(scriptProgramHash));
+}
+
+/*
+=================
+Script_ProgramHash
+=================
+*/
+static sint Script_ProgramHash(pointer source) {
+    return (sint)(((uintptr_t)source >> 2) & (HASH_TABLE_SIZE - 1));
+}
+
+/*
+=================
+Script_FindProgram
+=================
+*/
+static scriptProgram_t *Script_FindProgram(pointer source) {
+    scriptProgram_t *program;
+
+    for(program = scriptProgramHash[ Script_ProgramHash(source) ]; program;
+            program = program->next) {
+        if(program->source == source) {
+            return program;
+        }
+    }
+
+    return nullptr;
+}
+
+/*
+=================
+Script_CommandForName
+=================
+*/
+static sint Script_CommandForName(pointer name) {
     sint i;
-    bool bRan;
-    ::memset(script, 0, sizeof(script));
 
-    if(item && s && s[0]) {
-        Q_strcat(script, 1024, s);
-        p = script;
+    for(i = 0; i < scriptCommandCount; i++) {
+        if(Q_stricmp(name, commandList[i].name) == 0) {
+            return i;
+        }
+    }
 
-        while(1) {
-            pointer command;
-            // expect command then arguments, ; ends command, nullptr ends script
+    return -1;
+}
 
-            if(!String_Parse(&p, &command)) {
-                return;
+/*
+=================
+Script_Compile
+
+Only interned scripts can be compiled, anything else, or a script the
+pools have no room left for, is interpreted from its text as before
+=================
+*/
+static scriptProgram_t *Script_Compile(pointer source) {
+    valueType args[1024], *p, *token;
+    scriptProgram_t *program;
+    scriptOp_t *op = nullptr;
+    sint hash, firstOp = numScriptOps;
+
+    if(!source || !source[0] || source < strPool ||
+            source >= strPool + STRING_POOL_SIZE) {
+        return nullptr;
+    }
+
+    if((program = Script_FindProgram(source)) != nullptr) {
+        return program;
+    }
+
+    if(numScriptPrograms >= MAX_SCRIPT_PROGRAMS) {
+        return nullptr;
+    }
+
+    p = (valueType *)source;
+    args[0] = '\0';
+
+    while(1) {
+        token = COM_ParseExt(&p, false);
+
+        if(!token || !token[0] || (token[0] == ';' && token[1] == '\0')) {
+            // ; or the end of the script closes the current command
+            if(op) {
+                op->args = String_Alloc(args);
+                op = nullptr;
             }
 
-            if(command[0] == ';' && command[1] == '\0') {
-                continue;
+            if(!token || !token[0]) {
+                break;
             }
 
-            bRan = false;
+            continue;
+        }
 
-            for(i = 0; i < scriptCommandCount; i++) {
-                if(Q_stricmp(command, commandList[i].name) == 0) {
-                    (commandList[i].handler(item, &p));
-                    bRan = true;
-                    break;
-                }
+        if(!op) {
+            if(numScriptOps >= MAX_SCRIPT_OPS) {
+                numScriptOps = firstOp;
+                return nullptr;
             }
 
+            op = &scriptOps[ numScriptOps++ ];
+            op->command = Script_CommandForName(token);
+            op->args = nullptr;
+            args[0] = '\0';
+            continue;
+        }
+
+        // quoting every argument keeps whitespace inside it, a quote can't
+        // be kept that way so leave such a script to the interpreter
+        if(strchr(token, '"')) {
+            numScriptOps = firstOp;
+            return nullptr;
+        }
+
+        Q_strcat(args, sizeof(args), va("\"%s\" ", token));
+    }
+
+    program = &scriptPrograms[ numScriptPrograms++ ];
+    program->source = source;
+    program->ops = &scriptOps[ firstOp ];
+    program->numOps = numScriptOps - firstOp;
+
+    hash = Script_ProgramHash(source);
+    program->next = scriptProgramHash[ hash ];
+    scriptProgramHash[ hash ] = program;
+
+    return program;
+}
+
+/*
+=================
+Script_Interpret
+
+Runs script text command by command, expect command then arguments,
+; ends command, nullptr ends script
+=================
+*/
+static void Script_Interpret(itemDef_t *item, valueType **p) {
+    pointer command;
+    sint i;
+
+    while(String_Parse(p, &command)) {
+        if(command[0] == ';' && command[1] == '\0') {
+            continue;
+        }
+
+        i = Script_CommandForName(command);
+
+        if(i >= 0) {
+            commandList[i].handler(item, p);
+        } else {
             // not in our auto list, pass to handler
-            if(!bRan) {
-                DC->runScript(&p);
-            }
+            DC->runScript(p);
         }
     }
 }
 
+void Item_RunScript(itemDef_t *item, pointer s) {
+    valueType script[1024], * p;
+    scriptProgram_t *program;
+    scriptOp_t *op;
+    sint i;
 
-bool Item_EnableShowViaCvar(itemDef_t *item, sint flag) {
+    if(!item || !s || !s[0]) {
+        return;
+    }
+
+    program = Script_Compile(s);
+
+    if(!program) {
+        Q_strncpyz(script, s, sizeof(script));
+        p = script;
+        Script_Interpret(item, &p);
+        return;
+    }
+
+    for(i = 0, op = program->ops; i < program->numOps; i++, op++) {
+        p = (valueType *)op->args;
+
+        if(op->command >= 0) {
+            commandList[ op->command ].handler(item, &p);
+        } else {
+            DC->runScript(&p);
+        }
+
+        // arguments a command didn't use are commands of their own
+        if(p && *p) {
+            Script_Interpret(item, &p);
+        }
+    }
+}
+
+/*
+=================
+PC_Script_Compile
+
+Parses a script and compiles it ready for Item_RunScript
+=================
+*/
+bool PC_Script_Compile(sint handle, pointer *out) {
+    if(!PC_Script_Parse(handle, out)) {
+        return false;
+    }
+
+    Script_Compile(*out);
+    return true;
+}
+
+/*
+=================
+Item_CompileCvarTest
+
+Splits an enableCvar list into its values once, the ; separators are
+dropped
+=================
+*/
+void Item_CompileCvarTest(itemDef_t *item) {
+    valueType *p, *token;
+    sint first = numCvarTestValues;
+
+    item->cvarTestValues = nullptr;
+    item->numCvarTestValues = 0;
+
+    if(!item->enableCvar) {
+        return;
+    }
+
+    p = (valueType *)item->enableCvar;
+
+    while(1) {
+        token = COM_ParseExt(&p, false);
+
+        if(!token || !token[0]) {
+            break;
+        }
+
+        if(token[0] == ';' && token[1] == '\0') {
+            continue;
+        }
+
+        if(numCvarTestValues >= MAX_CVAR_TEST_VALUES) {
+            // leave it to Item_TestCvar to parse the list each time
+            numCvarTestValues = first;
+            return;
+        }
+
+        cvarTestValues[ numCvarTestValues++ ] = String_Alloc(token);
+    }
+
+    item->cvarTestValues = &cvarTestValues[ first ];
+    item->numCvarTestValues = numCvarTestValues - first;
+}
+
+bool Item_TestCvar(itemDef_t *item, sint flag) {
     valueType script[1024], * p;
-    ::memset(script, 0, sizeof(script));
+    valueType buff[1024];
+    pointer val;
+    sint i;
 
     if(item && item->enableCvar && *item->enableCvar && item->cvarTest &&
             *item->cvarTest) {
-        valueType buff[1024];
         DC->getCVarString(item->cvarTest, buff, sizeof(buff));
 
-        Q_strcat(script, 1024, item->enableCvar);
+        if(item->cvarTestValues) {
+            for(i = 0; i < item->numCvarTestValues; i++) {
+                if(Q_stricmp(buff, item->cvarTestValues[ i ]) == 0) {
+                    // enable it if any of the values are true, disable it
+                    // otherwise
+                    return (item->cvarFlags & flag) ? true : false;
+                }
+            }
+
+            return (item->cvarFlags & flag) ? false : true;
+        }
+
+        Q_strncpyz(script, item->enableCvar, sizeof(script));
         p = script;
 
         while(1) {
-            pointer val;
             // expect value then ; or nullptr, nullptr ends list
 
             if(!String_Parse(&p, &val)) {
@@ -3020,6 +3542,46 @@ bool Item_EnableShowViaCvar(itemDef_t *item, sint flag) {
     return true;
 }
 
+bool Item_EnableShowViaCvar(itemDef_t *item, sint flag) {
+    sint generation = -1;
+    bool result;
+
+    if(!item || !item->enableCvar || !*item->enableCvar || !item->cvarTest ||
+            !*item->cvarTest) {
+        return true;
+    }
+
+    // state backed cvars only need testing again when they change
+    if(DC->stateGeneration) {
+        generation = DC->stateGeneration(item->cvarTest);
+    }
+
+    if(generation >= 0) {
+        if(item->cvarTestGeneration != generation) {
+            item->cvarTestGeneration = generation;
+            item->cvarTestKnown = 0;
+        }
+
+        if(item->cvarTestKnown & flag) {
+            return (item->cvarTestResults & flag) ? true : false;
+        }
+    }
+
+    result = Item_TestCvar(item, flag);
+
+    if(generation >= 0) {
+        item->cvarTestKnown |= flag;
+
+        if(result) {
+            item->cvarTestResults |= flag;
+        } else {
+            item->cvarTestResults &= ~flag;
+        }
+    }
+
+    return result;
+}
+
 
 // will optionaly set focus to this item
 bool Item_SetFocus(itemDef_t *item, float32 x, float32 y) {
@@ -4816,6 +5378,7 @@ void Rect_ToWindowCoords(rectDef_t *rect, windowDef_t *window) {
 void Item_SetTextExtents(itemDef_t *item, sint *width, sint *height,
                          pointer text) {
     pointer textPtr = (text) ? text : item->text;
+    uint32 key;
 
     if(textPtr == nullptr) {
         return;
@@ -4830,6 +5393,24 @@ void Item_SetTextExtents(itemDef_t *item, sint *width, sint *height,
                        item->textalignment == ALIGN_CENTER)) {
         sint originalWidth;
 
+        // owner draws change their text under the item, but seldom every frame
+        key = UI_LayoutHashString(UI_LAYOUT_HASH_INIT, textPtr);
+        key = UI_LayoutHash(key, &item->text, sizeof(item->text));
+        key = UI_LayoutHash(key, &item->textscale, sizeof(item->textscale));
+        key = UI_LayoutHash(key, &item->textalignx, sizeof(item->textalignx));
+        key = UI_LayoutHash(key, &item->textaligny, sizeof(item->textaligny));
+        key = UI_LayoutHash(key, &item->textalignment,
+                            sizeof(item->textalignment));
+        key = UI_LayoutHash(key, &item->textvalignment,
+                            sizeof(item->textvalignment));
+        key = UI_LayoutHash(key, &item->window.rect, sizeof(item->window.rect));
+
+        if(*width != 0 && key == item->textExtentsKey) {
+            return;
+        }
+
+        item->textExtentsKey = key;
+
         if(item->type == ITEM_TYPE_EDITFIELD &&
                 item->textalignment == ALIGN_CENTER && item->cvar) {
             //FIXME: this will only be called once?
@@ -5038,49 +5619,93 @@ static pointer Item_Text_Wrap(pointer text, float32 scale, float32 width) {
     return out;
 }
 
-#define MAX_WRAP_CACHE  16
+#define MAX_WRAP_CACHE  32
 #define MAX_WRAP_LINES  128
-#define MAX_WRAP_TEXT   512
+#define MAX_WRAP_TEXT   8192
 
 typedef struct {
-    valueType      text[MAX_WRAP_TEXT *
-                                      MAX_WRAP_LINES]; //FIXME: augment with hash?
-    rectDef_t rect;
+    bool        valid;
+    uint32      hash;
+    sint        lastUsed;
+    valueType   text[MAX_WRAP_TEXT];
+    rectDef_t   rect;
     float32     scale;
-    valueType      lines[MAX_WRAP_LINES][MAX_WRAP_TEXT];
+    valueType   lineText[MAX_WRAP_TEXT + MAX_WRAP_LINES];
+    sint        lineTextLength;
+    sint        lineOffsets[MAX_WRAP_LINES];
     float32     lineCoords[MAX_WRAP_LINES][2];
-    sint       numLines;
+    sint        numLines;
 }
 
 wrapCache_t;
 
 static wrapCache_t  wrapCache[MAX_WRAP_CACHE];
-static sint          cacheWriteIndex = 0;
+static sint          wrapCacheTime = 0;
+static sint          cacheWriteIndex = -1;
 static sint          cacheReadIndex = 0;
 static sint          cacheReadLineNum = 0;
 
 static void UI_CreateCacheEntry(pointer text, rectDef_t *rect,
                                 float32 scale) {
-    wrapCache_t *cacheEntry = &wrapCache[cacheWriteIndex];
+    wrapCache_t *cacheEntry;
+    sint i;
+
+    cacheWriteIndex = -1;
+
+    // text that doesn't fit is never cached rather than cached cut short
+    if(strlen(text) >= MAX_WRAP_TEXT) {
+        return;
+    }
+
+    // replace an unused entry or else the least recently used one
+    cacheWriteIndex = 0;
+
+    for(i = 0; i < MAX_WRAP_CACHE; i++) {
+        if(!wrapCache[i].valid) {
+            cacheWriteIndex = i;
+            break;
+        }
+
+        if(wrapCache[i].lastUsed < wrapCache[cacheWriteIndex].lastUsed) {
+            cacheWriteIndex = i;
+        }
+    }
 
+    cacheEntry = &wrapCache[cacheWriteIndex];
+
+    cacheEntry->valid = false;
+    cacheEntry->hash = UI_LayoutHashString(UI_LAYOUT_HASH_INIT, text);
     Q_strncpyz(cacheEntry->text, text, sizeof(cacheEntry->text));
     cacheEntry->rect.x = rect->x;
     cacheEntry->rect.y = rect->y;
     cacheEntry->rect.w = rect->w;
     cacheEntry->rect.h = rect->h;
     cacheEntry->scale = scale;
+    cacheEntry->lineTextLength = 0;
     cacheEntry->numLines = 0;
 }
 
 static void UI_AddCacheEntryLine(pointer text, float32 x, float32 y) {
-    wrapCache_t *cacheEntry = &wrapCache[cacheWriteIndex];
+    wrapCache_t *cacheEntry;
+    sint len;
+
+    if(cacheWriteIndex < 0) {
+        return;
+    }
+
+    cacheEntry = &wrapCache[cacheWriteIndex];
+    len = strlen(text) + 1;
 
-    if(cacheEntry->numLines >= MAX_WRAP_LINES) {
+    if(cacheEntry->numLines >= MAX_WRAP_LINES ||
+            cacheEntry->lineTextLength + len > sizeof(cacheEntry->lineText)) {
         return;
     }
 
-    Q_strncpyz(cacheEntry->lines[cacheEntry->numLines], text,
-               sizeof(cacheEntry->lines[0]));
+    memcpy(&cacheEntry->lineText[cacheEntry->lineTextLength], text, len);
+
+    cacheEntry->lineOffsets[cacheEntry->numLines] = cacheEntry->lineTextLength;
+
+    cacheEntry->lineTextLength += len;
 
     cacheEntry->lineCoords[cacheEntry->numLines][0] = x;
 
@@ -5090,17 +5715,24 @@ static void UI_AddCacheEntryLine(pointer text, float32 x, float32 y) {
 }
 
 static void UI_FinishCacheEntry(void) {
-    cacheWriteIndex = (cacheWriteIndex + 1) % MAX_WRAP_CACHE;
+    if(cacheWriteIndex < 0) {
+        return;
+    }
+
+    wrapCache[cacheWriteIndex].valid = true;
+    wrapCache[cacheWriteIndex].lastUsed = ++wrapCacheTime;
+    cacheWriteIndex = -1;
 }
 
 static bool UI_CheckWrapCache(pointer text, rectDef_t *rect,
                               float32 scale) {
     sint i;
+    uint32 hash = UI_LayoutHashString(UI_LAYOUT_HASH_INIT, text);
 
     for(i = 0; i < MAX_WRAP_CACHE; i++) {
         wrapCache_t *cacheEntry = &wrapCache[i];
 
-        if(Q_stricmp(text, cacheEntry->text)) {
+        if(!cacheEntry->valid || cacheEntry->hash != hash) {
             continue;
         }
 
@@ -5115,11 +5747,17 @@ static bool UI_CheckWrapCache(pointer text, rectDef_t *rect,
             continue;
         }
 
+        if(strcmp(text, cacheEntry->text)) {
+            continue;
+        }
+
         // This is a match
         cacheReadIndex = i;
 
         cacheReadLineNum = 0;
 
+        cacheEntry->lastUsed = ++wrapCacheTime;
+
         return true;
     }
 
@@ -5134,7 +5772,7 @@ static bool UI_NextWrapLine(pointer *text, float32 *x, float32 *y) {
         return false;
     }
 
-    *text = cacheEntry->lines[cacheReadLineNum];
+    *text = &cacheEntry->lineText[cacheEntry->lineOffsets[cacheReadLineNum]];
 
     *x = cacheEntry->lineCoords[cacheReadLineNum][0];
 
@@ -7688,7 +8326,7 @@ bool ItemParse_doubleClick(itemDef_t *item, sint handle) {
 
     listPtr = (listBoxDef_t *)item->typeData;
 
-    if(!PC_Script_Parse(handle, &listPtr->doubleClick)) {
+    if(!PC_Script_Compile(handle, &listPtr->doubleClick)) {
         return false;
     }
 
@@ -7696,7 +8334,7 @@ bool ItemParse_doubleClick(itemDef_t *item, sint handle) {
 }
 
 bool ItemParse_onFocus(itemDef_t *item, sint handle) {
-    if(!PC_Script_Parse(handle, &item->onFocus)) {
+    if(!PC_Script_Compile(handle, &item->onFocus)) {
         return false;
     }
 
@@ -7704,7 +8342,7 @@ bool ItemParse_onFocus(itemDef_t *item, sint handle) {
 }
 
 bool ItemParse_leaveFocus(itemDef_t *item, sint handle) {
-    if(!PC_Script_Parse(handle, &item->leaveFocus)) {
+    if(!PC_Script_Compile(handle, &item->leaveFocus)) {
         return false;
     }
 
@@ -7712,7 +8350,7 @@ bool ItemParse_leaveFocus(itemDef_t *item, sint handle) {
 }
 
 bool ItemParse_mouseEnter(itemDef_t *item, sint handle) {
-    if(!PC_Script_Parse(handle, &item->mouseEnter)) {
+    if(!PC_Script_Compile(handle, &item->mouseEnter)) {
         return false;
     }
 
@@ -7720,7 +8358,7 @@ bool ItemParse_mouseEnter(itemDef_t *item, sint handle) {
 }
 
 bool ItemParse_mouseExit(itemDef_t *item, sint handle) {
-    if(!PC_Script_Parse(handle, &item->mouseExit)) {
+    if(!PC_Script_Compile(handle, &item->mouseExit)) {
         return false;
     }
 
@@ -7728,7 +8366,7 @@ bool ItemParse_mouseExit(itemDef_t *item, sint handle) {
 }
 
 bool ItemParse_mouseEnterText(itemDef_t *item, sint handle) {
-    if(!PC_Script_Parse(handle, &item->mouseEnterText)) {
+    if(!PC_Script_Compile(handle, &item->mouseEnterText)) {
         return false;
     }
 
@@ -7736,7 +8374,7 @@ bool ItemParse_mouseEnterText(itemDef_t *item, sint handle) {
 }
 
 bool ItemParse_mouseExitText(itemDef_t *item, sint handle) {
-    if(!PC_Script_Parse(handle, &item->mouseExitText)) {
+    if(!PC_Script_Compile(handle, &item->mouseExitText)) {
         return false;
     }
 
@@ -7744,7 +8382,7 @@ bool ItemParse_mouseExitText(itemDef_t *item, sint handle) {
 }
 
 bool ItemParse_onTextEntry(itemDef_t *item, sint handle) {
-    if(!PC_Script_Parse(handle, &item->onTextEntry)) {
+    if(!PC_Script_Compile(handle, &item->onTextEntry)) {
         return false;
     }
 
@@ -7752,7 +8390,7 @@ bool ItemParse_onTextEntry(itemDef_t *item, sint handle) {
 }
 
 bool ItemParse_action(itemDef_t *item, sint handle) {
-    if(!PC_Script_Parse(handle, &item->action)) {
+    if(!PC_Script_Compile(handle, &item->action)) {
         return false;
     }
 
@@ -8026,6 +8664,7 @@ bool ItemParse_ownerdrawFlag(itemDef_t *item, sint handle) {
 
 bool ItemParse_enableCvar(itemDef_t *item, sint handle) {
     if(PC_Script_Parse(handle, &item->enableCvar)) {
+        Item_CompileCvarTest(item);
         item->cvarFlags = CVAR_ENABLE;
         return true;
     }
@@ -8035,6 +8674,7 @@ bool ItemParse_enableCvar(itemDef_t *item, sint handle) {
 
 bool ItemParse_disableCvar(itemDef_t *item, sint handle) {
     if(PC_Script_Parse(handle, &item->enableCvar)) {
+        Item_CompileCvarTest(item);
         item->cvarFlags = CVAR_DISABLE;
         return true;
     }
@@ -8044,6 +8684,7 @@ bool ItemParse_disableCvar(itemDef_t *item, sint handle) {
 
 bool ItemParse_showCvar(itemDef_t *item, sint handle) {
     if(PC_Script_Parse(handle, &item->enableCvar)) {
+        Item_CompileCvarTest(item);
         item->cvarFlags = CVAR_SHOW;
         return true;
     }
@@ -8053,6 +8694,7 @@ bool ItemParse_showCvar(itemDef_t *item, sint handle) {
 
 bool ItemParse_hideCvar(itemDef_t *item, sint handle) {
     if(PC_Script_Parse(handle, &item->enableCvar)) {
+        Item_CompileCvarTest(item);
         item->cvarFlags = CVAR_HIDE;
         return true;
     }
@@ -8061,7 +8703,7 @@ bool ItemParse_hideCvar(itemDef_t *item, sint handle) {
 }
 
 bool ItemParse_onCharEntry(itemDef_t *item, int handle) {
-    if(!PC_Script_Parse(handle, &item->onCharEntry)) {
+    if(!PC_Script_Compile(handle, &item->onCharEntry)) {
         return false;
     }
 
@@ -8333,7 +8975,7 @@ bool MenuParse_dontCloseAll(itemDef_t *item, sint handle) {
 bool MenuParse_onOpen(itemDef_t *item, sint handle) {
     menuDef_t *menu = (menuDef_t *)item;
 
-    if(!PC_Script_Parse(handle, &menu->onOpen)) {
+    if(!PC_Script_Compile(handle, &menu->onOpen)) {
         return false;
     }
 
@@ -8343,7 +8985,7 @@ bool MenuParse_onOpen(itemDef_t *item, sint handle) {
 bool MenuParse_onClose(itemDef_t *item, sint handle) {
     menuDef_t *menu = (menuDef_t *)item;
 
-    if(!PC_Script_Parse(handle, &menu->onClose)) {
+    if(!PC_Script_Compile(handle, &menu->onClose)) {
         return false;
     }
 
@@ -8353,7 +8995,7 @@ bool MenuParse_onClose(itemDef_t *item, sint handle) {
 bool MenuParse_onESC(itemDef_t *item, sint handle) {
     menuDef_t *menu = (menuDef_t *)item;
 
-    if(!PC_Script_Parse(handle, &menu->onESC)) {
+    if(!PC_Script_Compile(handle, &menu->onESC)) {
         return false;
     }
 
@@ -8720,6 +9362,7 @@ void Menu_New(sint handle) {
 
         if(Menu_Parse(handle, menu)) {
             Menu_PostParse(menu);
+            Menu_IndexItems(menu);
             menuCount++;
         }
     }
@@ -8757,6 +9400,7 @@ void Menu_PaintAll(void) {
 
 void Menu_Reset(void) {
     menuCount = 0;
+    Menu_ClearNameIndex();
 }
 
 displayContextDef_t *Display_GetContext(void) {
@@ -81,6 +81,9 @@
 #define MAX_STRING_HANDLES 4096
 
 #define MAX_SCRIPT_ARGS 12
+#define MAX_SCRIPT_PROGRAMS 2048
+#define MAX_SCRIPT_OPS 8192
+#define MAX_CVAR_TEST_VALUES 2048
 #define MAX_EDITFIELD 256
 #define ITEM_VALUE_OFFSET 8
 
@@ -261,6 +264,7 @@ typedef enum { TYPE_ANY = -1, TYPE_NONE, TYPE_LIST, TYPE_EDIT, TYPE_MULTI, TYPE_
 typedef struct itemDef_s {
     WinDow window;                 // common positional, border, style, layout info
     rectangle textRect;            // rectangle the text ( if any ) consumes
+    uint32 textExtentsKey;          // hash of what textRect was last computed from
     sint type;                      // text, button, radiobutton, checkbox, textfield, listbox, combo
     sint alignment;                 // left center right
     sint textalignment;             // ( optional ) alignment for text within rect based on text width
@@ -271,6 +275,7 @@ typedef struct itemDef_s {
     sint textStyle;                 // ( optional ) style, normal and shadowed are it for now
     pointer text;              // display text
     void *parent;                  // menu owner
+    struct itemDef_s *nameHashNext; // next in the item name hash chain
     qhandle_t asset;               // handle to asset
     pointer mouseEnterText;    // mouse enter script
     pointer mouseExitText;     // mouse exit script
@@ -284,7 +289,12 @@ typedef struct itemDef_s {
     pointer cvar;              // associated cvar
     pointer cvarTest;          // associated cvar for enable actions
     pointer enableCvar;         // enable, disable, show, or hide based on value, this can contain a list
+    pointer *cvarTestValues;        // enableCvar split into its values at parse time
+    sint numCvarTestValues;
     sint cvarFlags;                 //  what type of action to take on cvarenables
+    sint cvarTestGeneration;        // DC->stateGeneration the results below are from
+    sint cvarTestKnown;             // cvarFlags tests with a cached result
+    sint cvarTestResults;
     sfxHandle_t focusSound;
     sint numColors;                 // number of color ranges
     colorRangeDef_t colorRanges[MAX_COLOR_RANGES];
@@ -402,6 +412,7 @@ typedef struct {
     void (*runScript)(valueType **p);
     void (*getCVarString)(pointer cvar, valueType *buffer, uint64 bufsize);
     float32(*getCVarValue)(pointer cvar);
+    sint(*stateGeneration)(pointer cvar);   // optional, -1 if cvar has no generation
     void (*setCVar)(pointer cvar, pointer value);
     void (*drawTextWithCursor)(float32 x, float32 y, float32 scale,
                                vec4_t color, pointer text, sint cursorPos, valueType cursor, sint limit,
@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////////////
+// Copyright(C) 2011 - 2021 Dusan Jocic <dusanjocic@msn.com>
+//
+// This file is part of OpenWolf.
+//
+// OpenWolf is free software; you can redistribute it
+// and / or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of the License,
+// or (at your option) any later version.
+//
+// OpenWolf is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenWolf; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110 - 1301  USA
+//
+// -------------------------------------------------------------------------------------
+// File name:   bgame_cache.cpp
+// Created:
+// Compilers:   Microsoft (R) C/C++ Optimizing Compiler Version 19.26.28806 for x64,
+//              gcc (Ubuntu 9.3.0-10ubuntu2) 9.3.0
+// Description: binary cache of parsed configuration scripts
+// -------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef CGAMEDLL
+#include <cgame/cgame_precompiled.hpp>
+#elif GAMEDLL
+#include <sgame/sgame_precompiled.hpp>
+#else
+#include <GUI/gui_precompiled.hpp>
+#endif // !GAMEDLL
+
+/*
+===================================================================
+CONFIGURATION CACHE
+
+Parsed script data is written to cache/<name>.bin together with the
+size and hash of the text it came from. On the next load the text is
+only hashed, and if it still matches the stored structures are read
+back directly instead of being tokenised again. Any mismatch, missing
+or truncated cache file falls back to parsing the text.
+===================================================================
+*/
+
+#define CACHE_IDENT     ( ( 'H' << 24 ) + ( 'C' << 16 ) + ( 'G' << 8 ) + 'B' )
+#define CACHE_VERSION   1
+
+typedef struct {
+    sint ident;
+    sint version;
+    sint layout;        // caller defined, changes when the structures do
+    sint sourceSize;
+    uint32 sourceHash;
+    sint dataSize;
+} cacheHeader_t;
+
+/*
+===============
+idBothGamesLocal::CacheHash
+
+32 bit FNV-1a, pass the previous result as hash to chain several buffers
+===============
+*/
+uint32 idBothGamesLocal::CacheHash(const void *data, sint len,
+                                   uint32 hash) {
+    const uchar8 *p = (const uchar8 *)data;
+    sint i;
+
+    if(!hash) {
+        hash = 2166136261u;
+    }
+
+    for(i = 0; i < len; i++) {
+        hash ^= p[ i ];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/*
+===============
+idBothGamesLocal::CacheOpenRead
+
+Opens a cache file and positions it at the data if it was built from the
+same source with the same layout, otherwise returns 0
+===============
+*/
+fileHandle_t idBothGamesLocal::CacheOpenRead(pointer name, sint layout,
+        sint sourceSize, uint32 sourceHash, sint *dataSize) {
+    cacheHeader_t header;
+    fileHandle_t f;
+    sint len;
+
+    len = trap_FS_FOpenFile(va("cache/%s.bin", name), &f, FS_READ);
+
+    if(len < 0) {
+        return 0;
+    }
+
+    if(len < (sint)sizeof(header)) {
+        trap_FS_FCloseFile(f);
+        return 0;
+    }
+
+    trap_FS_Read(&header, sizeof(header), f);
+
+    if(header.ident != CACHE_IDENT || header.version != CACHE_VERSION ||
+            header.layout != layout || header.sourceSize != sourceSize ||
+            header.sourceHash != sourceHash ||
+            header.dataSize != len - (sint)sizeof(header)) {
+        trap_FS_FCloseFile(f);
+        return 0;
+    }
+
+    *dataSize = header.dataSize;
+
+    return f;
+}
+
+/*
+===============
+idBothGamesLocal::CacheOpenWrite
+
+Creates a cache file and writes its header, the caller writes exactly
+dataSize bytes after it
+===============
+*/
+fileHandle_t idBothGamesLocal::CacheOpenWrite(pointer name, sint layout,
+        sint sourceSize, uint32 sourceHash, sint dataSize) {
+    cacheHeader_t header;
+    fileHandle_t f;
+
+    trap_FS_FOpenFile(va("cache/%s.bin", name), &f, FS_WRITE);
+
+    if(!f) {
+        return 0;
+    }
+
+    header.ident = CACHE_IDENT;
+    header.version = CACHE_VERSION;
+    header.layout = layout;
+    header.sourceSize = sourceSize;
+    header.sourceHash = sourceHash;
+    header.dataSize = dataSize;
+
+    trap_FS_Write(&header, sizeof(header), f);
+
+    return f;
+}
+
+/*
+===============
+idBothGamesLocal::CacheRead
+
+Single structure convenience wrapper around CacheOpenRead
+===============
+*/
+bool idBothGamesLocal::CacheRead(pointer name, sint sourceSize,
+                                 uint32 sourceHash, void *data, sint dataSize) {
+    fileHandle_t f;
+    sint len;
+
+    f = CacheOpenRead(name, dataSize, sourceSize, sourceHash, &len);
+
+    if(!f) {
+        return false;
+    }
+
+    if(len != dataSize) {
+        trap_FS_FCloseFile(f);
+        return false;
+    }
+
+    trap_FS_Read(data, dataSize, f);
+    trap_FS_FCloseFile(f);
+
+    return true;
+}
+
+/*
+===============
+idBothGamesLocal::CacheWrite
+
+Single structure convenience wrapper around CacheOpenWrite
+===============
+*/
+void idBothGamesLocal::CacheWrite(pointer name, sint sourceSize,
+                                  uint32 sourceHash, const void *data, sint dataSize) {
+    fileHandle_t f;
+
+    f = CacheOpenWrite(name, dataSize, sourceSize, sourceHash, dataSize);
+
+    if(!f) {
+        return;
+    }
+
+    trap_FS_Write(data, dataSize, f);
+    trap_FS_FCloseFile(f);
+}
@@ -244,6 +244,15 @@ public:
     virtual void Free(void *ptr);
     virtual void InitMemory(void);
     virtual void DefragmentMemory(void);
+    virtual uint32 CacheHash(const void *data, sint len, uint32 hash);
+    virtual fileHandle_t CacheOpenRead(pointer name, sint layout,
+                                       sint sourceSize, uint32 sourceHash, sint *dataSize);
+    virtual fileHandle_t CacheOpenWrite(pointer name, sint layout,
+                                        sint sourceSize, uint32 sourceHash, sint dataSize);
+    virtual bool CacheRead(pointer name, sint sourceSize, uint32 sourceHash,
+                           void *data, sint dataSize);
+    virtual void CacheWrite(pointer name, sint sourceSize, uint32 sourceHash,
+                            const void *data, sint dataSize);
 
 };
 
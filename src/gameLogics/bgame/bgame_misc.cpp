@@ -608,6 +608,17 @@ sint bg_numBuildables = sizeof(bg_buildableList) / sizeof(
 
 static const buildableAttributes_t nullBuildable = { (buildable_t)0 };
 
+static nameIndex_t buildableNameIndex;
+static nameIndex_t buildableEntityNameIndex;
+
+static pointer BG_BuildableName(sint i) {
+    return bg_buildableList[ i ].name;
+}
+
+static pointer BG_BuildableEntityName(sint i) {
+    return bg_buildableList[ i ].entityName;
+}
+
 /*
 ==============
 idBothGamesLocal::BuildableByName
@@ -615,12 +626,11 @@ idBothGamesLocal::BuildableByName
 */
 const buildableAttributes_t *idBothGamesLocal::BuildableByName(
     pointer name) {
-    sint i;
+    sint i = Com_NameIndexFind(&buildableNameIndex, bg_numBuildables,
+                               BG_BuildableName, name);
 
-    for(i = 0; i < bg_numBuildables; i++) {
-        if(!Q_stricmp(bg_buildableList[i].name, name)) {
-            return &bg_buildableList[i];
-        }
+    if(i >= 0) {
+        return &bg_buildableList[i];
     }
 
     return &nullBuildable;
@@ -633,12 +643,11 @@ idBothGamesLocal::BuildableByEntityName
 */
 const buildableAttributes_t *idBothGamesLocal::BuildableByEntityName(
     pointer name) {
-    sint i;
+    sint i = Com_NameIndexFind(&buildableEntityNameIndex, bg_numBuildables,
+                               BG_BuildableEntityName, name);
 
-    for(i = 0; i < bg_numBuildables; i++) {
-        if(!Q_stricmp(bg_buildableList[i].entityName, name)) {
-            return &bg_buildableList[i];
-        }
+    if(i >= 0) {
+        return &bg_buildableList[i];
     }
 
     return &nullBuildable;
@@ -716,6 +725,7 @@ bool idBothGamesLocal::ParseBuildableFile(pointer filename,
     valueType *token;
     valueType text[ 20000 ];
     fileHandle_t f;
+    uint32 hash;
     float32 scale;
     sint defined = 0;
     enum {
@@ -746,6 +756,13 @@ bool idBothGamesLocal::ParseBuildableFile(pointer filename,
     text[ len ] = 0;
     trap_FS_FCloseFile(f);
 
+    // use the cached result if the text hasn't changed
+    hash = CacheHash(text, len, 0);
+
+    if(CacheRead(filename, len, hash, bc, sizeof(*bc))) {
+        return true;
+    }
+
     // parse the text
     text_p = text;
 
@@ -872,6 +889,8 @@ bool idBothGamesLocal::ParseBuildableFile(pointer filename,
         return false;
     }
 
+    CacheWrite(filename, len, hash, bc, sizeof(*bc));
+
     return true;
 }
 
@@ -1260,18 +1279,23 @@ sint bg_numClasses = sizeof(bg_classList) / sizeof(bg_classList[ 0 ]);
 
 static const classAttributes_t nullClass = { (class_t)0 };
 
+static nameIndex_t classNameIndex;
+
+static pointer BG_ClassName(sint i) {
+    return bg_classList[ i ].name;
+}
+
 /*
 ==============
 idBothGamesLocal::ClassByName
 ==============
 */
 const classAttributes_t *idBothGamesLocal::ClassByName(pointer name) {
-    sint i;
+    sint i = Com_NameIndexFind(&classNameIndex, bg_numClasses, BG_ClassName,
+                               name);
 
-    for(i = 0; i < bg_numClasses; i++) {
-        if(!Q_stricmp(bg_classList[i].name, name)) {
-            return &bg_classList[i];
-        }
+    if(i >= 0) {
+        return &bg_classList[i];
     }
 
     return &nullClass;
@@ -1450,6 +1474,7 @@ bool idBothGamesLocal::ParseClassFile(pointer filename,
     valueType *token;
     valueType text[20000];
     fileHandle_t f;
+    uint32 hash;
     float32 scale = 0.0f;
     sint defined = 0;
     enum parseClass {
@@ -1487,6 +1512,13 @@ bool idBothGamesLocal::ParseClassFile(pointer filename,
     text[len] = 0;
     trap_FS_FCloseFile(f);
 
+    // use the cached result if the text hasn't changed
+    hash = CacheHash(text, len, 0);
+
+    if(CacheRead(filename, len, hash, cc, sizeof(*cc))) {
+        return true;
+    }
+
     // parse the text
     text_p = text;
 
@@ -1714,6 +1746,8 @@ bool idBothGamesLocal::ParseClassFile(pointer filename,
         return false;
     }
 
+    CacheWrite(filename, len, hash, cc, sizeof(*cc));
+
     return true;
 }
 
@@ -2408,18 +2442,23 @@ sint bg_numWeapons = sizeof(bg_weapons) / sizeof(bg_weapons[ 0 ]);
 
 static const weaponAttributes_t nullWeapon = { (weapon_t)0 };
 
+static nameIndex_t weaponNameIndex;
+
+static pointer BG_WeaponName(sint i) {
+    return bg_weapons[ i ].name;
+}
+
 /*
 ==============
 idBothGamesLocal::WeaponByName
 ==============
 */
 const weaponAttributes_t *idBothGamesLocal::WeaponByName(pointer name) {
-    sint i;
+    sint i = Com_NameIndexFind(&weaponNameIndex, bg_numWeapons, BG_WeaponName,
+                               name);
 
-    for(i = 0; i < bg_numWeapons; i++) {
-        if(!Q_stricmp(bg_weapons[ i ].name, name)) {
-            return &bg_weapons[ i ];
-        }
+    if(i >= 0) {
+        return &bg_weapons[ i ];
     }
 
     return &nullWeapon;
@@ -2567,18 +2606,23 @@ sint bg_numUpgrades = sizeof(bg_upgrades) / sizeof(bg_upgrades[ 0 ]);
 
 static const upgradeAttributes_t nullUpgrade = { (upgrade_t)0 };
 
+static nameIndex_t upgradeNameIndex;
+
+static pointer BG_UpgradeName(sint i) {
+    return bg_upgrades[ i ].name;
+}
+
 /*
 ==============
 idBothGamesLocal::UpgradeByName
 ==============
 */
 const upgradeAttributes_t *idBothGamesLocal::UpgradeByName(pointer name) {
-    sint i;
+    sint i = Com_NameIndexFind(&upgradeNameIndex, bg_numUpgrades,
+                               BG_UpgradeName, name);
 
-    for(i = 0; i < bg_numUpgrades; i++) {
-        if(!Q_stricmp(bg_upgrades[ i ].name, name)) {
-            return &bg_upgrades[ i ];
-        }
+    if(i >= 0) {
+        return &bg_upgrades[ i ];
     }
 
     return &nullUpgrade;
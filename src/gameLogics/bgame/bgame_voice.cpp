@@ -400,6 +400,7 @@ voiceCmd_t *idBothGamesLocal::VoiceParse(valueType *name) {
         }
 
         Q_strncpyz(voiceCmds->cmd, token.string, sizeof(voiceCmds->cmd));
+        voiceCmds->hash = Com_NameHash(voiceCmds->cmd);
         voiceCmds->next = nullptr;
         parsingCmd = true;
 
@@ -527,12 +528,13 @@ idBothGamesLocal::VoiceCmdFind
 voiceCmd_t *idBothGamesLocal::VoiceCmdFind(voiceCmd_t *head,
         valueType *name, sint *cmdNum) {
     voiceCmd_t *vc = head;
+    uint32 hash = Com_NameHash(name);
     sint i = 0;
 
     while(vc) {
         i++;
 
-        if(!Q_stricmp(vc->cmd, name)) {
+        if(vc->hash == hash && !Q_stricmp(vc->cmd, name)) {
             *cmdNum = i;
             return vc;
         }
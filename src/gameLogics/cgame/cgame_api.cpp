@@ -104,6 +104,10 @@ void trap_Cvar_Update(vmConvar_t *vmCvar) {
     imports->cvarSystem->Update(vmCvar);
 }
 
+convar_t *trap_Cvar_Find(pointer var_name) {
+    return imports->cvarSystem->FindVar(var_name);
+}
+
 void trap_Cvar_Set(pointer var_name, pointer value) {
     imports->cvarSystem->Set(var_name, value);
 }
@@ -214,6 +218,7 @@ sint trap_CM_TransformedPointContents(const vec3_t p, clipHandle_t model,
 void trap_CM_BoxTrace(trace_t *results, const vec3_t start,
                       const vec3_t end, const vec3_t mins, const vec3_t maxs, clipHandle_t model,
                       sint brushmask) {
+    cg_profileCounters[ PROF_COUNT_TRACES ]++;
     imports->collisionModelManager->BoxTrace(results, start, end, mins, maxs,
             model, brushmask, TT_AABB);
 }
@@ -221,6 +226,7 @@ void trap_CM_BoxTrace(trace_t *results, const vec3_t start,
 void trap_CM_TransformedBoxTrace(trace_t *results, const vec3_t start,
                                  const vec3_t end, const vec3_t mins, const vec3_t maxs, clipHandle_t model,
                                  sint brushmask, const vec3_t origin, const vec3_t angles) {
+    cg_profileCounters[ PROF_COUNT_TRACES ]++;
     imports->collisionModelManager->TransformedBoxTrace(results, start, end,
             mins, maxs, model, brushmask, origin, angles, TT_AABB);
 }
@@ -228,6 +234,7 @@ void trap_CM_TransformedBoxTrace(trace_t *results, const vec3_t start,
 void trap_CM_CapsuleTrace(trace_t *results, const vec3_t start,
                           const vec3_t end, const vec3_t mins, const vec3_t maxs, clipHandle_t model,
                           sint brushmask) {
+    cg_profileCounters[ PROF_COUNT_TRACES ]++;
     imports->collisionModelManager->BoxTrace(results, start, end, mins, maxs,
             model, brushmask, TT_CAPSULE);
 }
@@ -235,6 +242,7 @@ void trap_CM_CapsuleTrace(trace_t *results, const vec3_t start,
 void trap_CM_TransformedCapsuleTrace(trace_t *results, const vec3_t start,
                                      const vec3_t end, const vec3_t mins, const vec3_t maxs, clipHandle_t model,
                                      sint brushmask, const vec3_t origin, const vec3_t angles) {
+    cg_profileCounters[ PROF_COUNT_TRACES ]++;
     imports->collisionModelManager->TransformedBoxTrace(results, start, end,
             mins, maxs, model, brushmask, origin, angles, TT_CAPSULE);
 }
@@ -242,6 +250,7 @@ void trap_CM_TransformedCapsuleTrace(trace_t *results, const vec3_t start,
 void trap_CM_BiSphereTrace(trace_t *results, const vec3_t start,
                            const vec3_t end, float32 startRad, float32 endRad, clipHandle_t model,
                            sint mask) {
+    cg_profileCounters[ PROF_COUNT_TRACES ]++;
     imports->collisionModelManager->BiSphereTrace(results, start, end,
             PASSFLOAT(startRad), PASSFLOAT(endRad), model, mask);
 }
@@ -249,6 +258,7 @@ void trap_CM_BiSphereTrace(trace_t *results, const vec3_t start,
 void trap_CM_TransformedBiSphereTrace(trace_t *results, const vec3_t start,
                                       const vec3_t end, float32 startRad, float32 endRad, clipHandle_t model,
                                       sint mask, const vec3_t origin) {
+    cg_profileCounters[ PROF_COUNT_TRACES ]++;
     imports->collisionModelManager->TransformedBiSphereTrace(results, start,
             end, PASSFLOAT(startRad), PASSFLOAT(endRad), model, mask, origin);
 }
@@ -371,16 +381,19 @@ void trap_R_ClearScene(void) {
 }
 
 void trap_R_AddRefEntityToScene(const refEntity_t *re) {
+    cg_profileCounters[ PROF_COUNT_SUBMITS ]++;
     imports->renderSystem->AddRefEntityToScene(re);
 }
 
 void trap_R_AddPolyToScene(qhandle_t hShader, sint numVerts,
                            const polyVert_t *verts) {
+    cg_profileCounters[ PROF_COUNT_SUBMITS ]++;
     imports->renderSystem->AddPolyToScene(hShader, numVerts, verts, 1);
 }
 
 void trap_R_AddPolysToScene(qhandle_t hShader, sint numVerts,
                             const polyVert_t *verts, sint numPolys) {
+    cg_profileCounters[ PROF_COUNT_SUBMITS ]++;
     imports->renderSystem->AddPolyToScene(hShader, numVerts, verts, numPolys);
 }
 
@@ -391,6 +404,7 @@ void trap_R_AddPolysToScene(qhandle_t hShader, sint numVerts,
 
 void trap_R_AddLightToScene(const vec3_t org, float32 intensity, float32 r,
                             float32 g, float32 b) {
+    cg_profileCounters[ PROF_COUNT_SUBMITS ]++;
     imports->renderSystem->AddLightToScene(org, PASSFLOAT(intensity),
                                            PASSFLOAT(r), PASSFLOAT(g), PASSFLOAT(b));
 }
@@ -437,6 +451,7 @@ void trap_R_SetClipRegion(const float32 *region) {
 
 void trap_R_DrawStretchPic(float32 x, float32 y, float32 w, float32 h,
                            float32 s1, float32 t1, float32 s2, float32 t2, qhandle_t hShader) {
+    cg_profileCounters[ PROF_COUNT_SUBMITS ]++;
     imports->renderSystem->DrawStretchPic(PASSFLOAT(x), PASSFLOAT(y),
                                           PASSFLOAT(w), PASSFLOAT(h), PASSFLOAT(s1), PASSFLOAT(t1), PASSFLOAT(s2),
                                           PASSFLOAT(t2), hShader);
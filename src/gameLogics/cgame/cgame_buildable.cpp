@@ -49,6 +49,11 @@ valueType *cg_buildableSoundNames[ MAX_BUILDABLE_ANIMATIONS ] = {
 static sfxHandle_t defaultAlienSounds[ MAX_BUILDABLE_ANIMATIONS ];
 static sfxHandle_t defaultHumanSounds[ MAX_BUILDABLE_ANIMATIONS ];
 
+// buildables to draw status for, gathered by AddPacketEntities
+static sint buildableStatusList[ MAX_ENTITIES_IN_SNAPSHOT ];
+static sint numBuildableStatus;
+static sint buildableStatusFrame = -1;
+
 /*
 ===============
 idCGameBuildable::idCGameBuildable
@@ -186,6 +191,7 @@ bool idCGameBuildable::ParseBuildableAnimationFile(pointer filename,
     float32 fps;
     valueType text[ 20000 ];
     fileHandle_t f;
+    uint32 hash;
     animation_t *animations;
 
     animations = cg_buildables[ buildable ].animations;
@@ -207,6 +213,14 @@ bool idCGameBuildable::ParseBuildableAnimationFile(pointer filename,
     text[ len ] = 0;
     trap_FS_FCloseFile(f);
 
+    // use the cached result if the text hasn't changed
+    hash = bggame->CacheHash(text, len, 0);
+
+    if(bggame->CacheRead(filename, len, hash, animations,
+                         sizeof(cg_buildables[ buildable ].animations))) {
+        return true;
+    }
+
     // parse the text
     text_p = text;
 
@@ -265,6 +279,9 @@ bool idCGameBuildable::ParseBuildableAnimationFile(pointer filename,
         return false;
     }
 
+    bggame->CacheWrite(filename, len, hash, animations,
+                       sizeof(cg_buildables[ buildable ].animations));
+
     return true;
 }
 
@@ -1197,6 +1214,35 @@ bool idCGameBuildable::BuildableRemovalPending(sint entityNum) {
     return false;
 }
 
+/*
+==================
+idCGameBuildable::ClearBuildableStatus
+==================
+*/
+void idCGameBuildable::ClearBuildableStatus(void) {
+    numBuildableStatus = 0;
+    buildableStatusFrame = cg.clientFrame;
+}
+
+/*
+==================
+idCGameBuildable::AddBuildableStatus
+
+Called for each entity in the snapshot as it is added to the scene
+==================
+*/
+void idCGameBuildable::AddBuildableStatus(centity_t *cent) {
+    entityState_t *es = &cent->currentState;
+
+    if(es->eType == ET_BUILDABLE &&
+            (PlayerIsBuilder((buildable_t)es->modelindex) ||
+             (cg_drawBuildableStatus.integer &&
+              bggame->Buildable((buildable_t)es->modelindex)->team ==
+              bggame->Weapon((weapon_t)cg.predictedPlayerState.weapon)->team))) {
+        buildableStatusList[ numBuildableStatus++ ] = es->number;
+    }
+}
+
 /*
 ==================
 DrawBuildableStatus
@@ -1204,28 +1250,16 @@ DrawBuildableStatus
 */
 void idCGameBuildable::DrawBuildableStatus(void) {
     sint i;
-    centity_t *cent;
-    entityState_t *es;
-    sint buildableList[ MAX_ENTITIES_IN_SNAPSHOT ];
-    sint buildables = 0;
-
-    for(i = 0; i < cg.snap->numEntities; i++) {
-        cent = &cg_entities[ cg.snap->entities[ i ].number ];
-        es = &cent->currentState;
-
-        if(es->eType == ET_BUILDABLE &&
-                (PlayerIsBuilder((buildable_t)es->modelindex) ||
-                 (cg_drawBuildableStatus.integer &&
-                  bggame->Buildable((buildable_t)es->modelindex)->team ==
-                  bggame->Weapon((weapon_t)cg.predictedPlayerState.weapon)->team))) {
-            buildableList[ buildables++ ] = cg.snap->entities[ i ].number;
-        }
+
+    // the list is only valid for the frame the entities were added in
+    if(buildableStatusFrame != cg.clientFrame) {
+        return;
     }
 
-    qsort(buildableList, buildables, sizeof(sint), SortDistance);
+    qsort(buildableStatusList, numBuildableStatus, sizeof(sint), SortDistance);
 
-    for(i = 0; i < buildables; i++) {
-        BuildableStatusDisplay(&cg_entities[buildableList[i]]);
+    for(i = 0; i < numBuildableStatus; i++) {
+        BuildableStatusDisplay(&cg_entities[ buildableStatusList[ i ] ]);
     }
 }
 
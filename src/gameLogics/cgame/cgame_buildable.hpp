@@ -59,6 +59,8 @@ public:
     static sint SortDistance(const void *a, const void *b);
     static bool PlayerIsBuilder(buildable_t buildable);
     static bool BuildableRemovalPending(sint entityNum);
+    static void ClearBuildableStatus(void);
+    static void AddBuildableStatus(centity_t *cent);
     static void DrawBuildableStatus(void);
     static void Buildable(centity_t *cent);
 };
@@ -265,6 +265,7 @@ static consoleCommand_t commands[ ] = {
     { "destroyTestTS", &idCGameTrails::DestroyTestTS_f, "description" },
     { "reloadhud", &idCGameMain::LoadHudMenu, "description" },
     { "squadmark", &idCGameConsoleCmds::SquadMark_f, "description" },
+    { "profileDump", &idCGameProfile::Dump_f, "description" },
 };
 
 /*
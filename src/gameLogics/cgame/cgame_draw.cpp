@@ -1754,7 +1754,7 @@ pointer idCGameDraw::GetKillerText(void) {
     pointer s = "";
 
     if(cg.killerName[0]) {
-        s = va("Fragged by %s", cg.killerName);
+        s = Com_ScratchPrintf("Fragged by %s", cg.killerName);
     }
 
     return s;
@@ -1900,11 +1900,11 @@ void idCGameDraw::DrawTeamLabel(rectDef_t *rect, team_t team,
     switch(textalign) {
         default:
         case ALIGN_LEFT:
-            s = va("%s %s", t, stage);
+            s = Com_ScratchPrintf("%s %s", t, stage);
             break;
 
         case ALIGN_RIGHT:
-            s = va("%s %s", stage, t);
+            s = Com_ScratchPrintf("%s %s", stage, t);
             break;
     }
 
@@ -2032,7 +2032,7 @@ void idCGameDraw::DrawFPS(rectDef_t *rect, float32 text_x, float32 text_y,
 
         fps = 1000 * FPS_FRAMES / total;
 
-        s = va("%d", fps);
+        s = Com_ScratchPrintf("%d", fps);
         w = UI_Text_Width("0", scale, 0);
         h = UI_Text_Height("0", scale, 0);
         strLength = idCGameDrawTools::DrawStrlen(s);
@@ -2121,7 +2121,7 @@ void idCGameDraw::DrawSpeed(rectDef_t *rect, float32 text_x,
 
     previousSpeed = speed;
 
-    s = va("Speed: %.0f/%.0f", speed, speedRecord);
+    s = Com_ScratchPrintf("Speed: %.0f/%.0f", speed, speedRecord);
     w = UI_Text_Width("0", scale, 0);
     h = UI_Text_Height("0", scale, 0);
     strLength = idCGameDrawTools::DrawStrlen(s);
@@ -2210,7 +2210,7 @@ void idCGameDraw::DrawTimer(rectDef_t *rect, float32 text_x,
     tens = seconds / 10;
     seconds -= tens * 10;
 
-    s = va("%d:%d%d", mins, tens, seconds);
+    s = Com_ScratchPrintf("%d:%d%d", mins, tens, seconds);
     w = UI_Text_Width("0", scale, 0);
     h = UI_Text_Height("0", scale, 0);
     strLength = idCGameDrawTools::DrawStrlen(s);
@@ -2249,7 +2249,8 @@ void idCGameDraw::DrawClock(rectDef_t *rect, float32 text_x,
     t = trap_RealTime(&qt);
 
     if(cg_drawClock.integer == 2) {
-        s = va("%02d%s%02d", qt.tm_hour, (qt.tm_sec % 2) ? ":" : " ", qt.tm_min);
+        s = Com_ScratchPrintf("%02d%s%02d", qt.tm_hour,
+                              (qt.tm_sec % 2) ? ":" : " ", qt.tm_min);
     } else {
         valueType *pm = "am";
         sint h = qt.tm_hour;
@@ -2263,7 +2264,8 @@ void idCGameDraw::DrawClock(rectDef_t *rect, float32 text_x,
             pm = "pm";
         }
 
-        s = va("%d%s%02d%s", h, (qt.tm_sec % 2) ? ":" : " ", qt.tm_min, pm);
+        s = Com_ScratchPrintf("%d%s%02d%s", h, (qt.tm_sec % 2) ? ":" : " ",
+                              qt.tm_min, pm);
     }
 
     w = UI_Text_Width("0", scale, 0);
@@ -2299,8 +2301,8 @@ void idCGameDraw::DrawSnapshot(rectDef_t *rect, float32 text_x,
         return;
     }
 
-    s = va("time:%d snap:%d cmd:%d", cg.snap->serverTime, cg.latestSnapshotNum,
-           cgs.serverCommandSequence);
+    s = Com_ScratchPrintf("time:%d snap:%d cmd:%d", cg.snap->serverTime,
+                          cg.latestSnapshotNum, cgs.serverCommandSequence);
 
     AlignText(rect, s, scale, 0.0f, 0.0f, textalign, textvalign, &tx, &ty);
 
@@ -2451,6 +2453,8 @@ void idCGameDraw::DrawLagometer(rectDef_t *rect, float32 text_x,
         return;
     }
 
+    idCGameProfile::DrawGraph(rect);
+
     if(!cg_lagometer.integer) {
         return;
     }
@@ -2566,7 +2570,7 @@ void idCGameDraw::DrawLagometer(rectDef_t *rect, float32 text_x,
     } else {
         valueType *s;
 
-        s = va("%d", cg.ping);
+        s = Com_ScratchPrintf("%d", cg.ping);
         ax = rect->x + (rect->w / 2.0f) - (UI_Text_Width(s, scale,
                                            0) / 2.0f) + text_x;
         ay = rect->y + (rect->h / 2.0f) + (UI_Text_Height(s, scale,
@@ -3567,8 +3571,8 @@ void idCGameDraw::DrawVote(void) {
                sizeof(yeskey));
     Q_strncpyz(nokey, idCGameDrawTools::KeyBinding("vote no"), sizeof(nokey));
 
-    s = va("VOTE(%i): \"%s\"  [%s]Yes:%i [%s]No:%i", sec, cgs.voteString,
-           yeskey, cgs.voteYes, nokey, cgs.voteNo);
+    s = Com_ScratchPrintf("VOTE(%i): \"%s\"  [%s]Yes:%i [%s]No:%i", sec,
+                          cgs.voteString, yeskey, cgs.voteYes, nokey, cgs.voteNo);
 
     UI_Text_Paint(8, 340, 0.3f, white, s, 0, 0, ITEM_TEXTSTYLE_NORMAL);
 }
@@ -3613,9 +3617,9 @@ void idCGameDraw::DrawTeamVote(void) {
     Q_strncpyz(nokey, idCGameDrawTools::KeyBinding("teamvote no"),
                sizeof(nokey));
 
-    s = va("TEAMVOTE(%i): \"%s\"  [%s]Yes:%i   [%s]No:%i", sec,
-           cgs.teamVoteString[ cs_offset ], yeskey, cgs.teamVoteYes[cs_offset], nokey,
-           cgs.teamVoteNo[ cs_offset ]);
+    s = Com_ScratchPrintf("TEAMVOTE(%i): \"%s\"  [%s]Yes:%i   [%s]No:%i", sec,
+                          cgs.teamVoteString[ cs_offset ], yeskey,
+                          cgs.teamVoteYes[cs_offset], nokey, cgs.teamVoteNo[ cs_offset ]);
 
     UI_Text_Paint(8, 360, 0.3f, white, s, 0, 0, ITEM_TEXTSTYLE_NORMAL);
 }
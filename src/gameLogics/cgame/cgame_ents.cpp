@@ -1112,6 +1112,49 @@ void idCGameEnts::AddCEntity(centity_t *cent) {
     }
 }
 
+/*
+===============
+idCGameEnts::UpdatePVSEntities
+
+Merge the sorted entity numbers of the new cg.snap with those of the
+last one to find the entities entering and leaving the PVS
+===============
+*/
+void idCGameEnts::UpdatePVSEntities(void) {
+    sint i, j, oldNum, newNum;
+    centity_t *cent;
+
+    i = j = 0;
+
+    while(i < cg.numPVSEntities || j < cg.snap->numEntities) {
+        oldNum = i < cg.numPVSEntities ? cg.pvsEntities[ i ] : MAX_GENTITIES;
+        newNum = j < cg.snap->numEntities ? cg.snap->entities[ j ].number :
+                 MAX_GENTITIES;
+
+        if(oldNum == newNum) {
+            i++;
+            j++;
+        } else if(newNum < oldNum) {
+            cent = &cg_entities[ newNum ];
+            cent->valid = true;
+            CEntityPVSEnter(cent);
+            j++;
+        } else {
+            cent = &cg_entities[ oldNum ];
+            cent->valid = false;
+            CEntityPVSLeave(cent);
+            i++;
+        }
+    }
+
+    for(j = 0; j < cg.snap->numEntities; j++) {
+        cg.pvsEntities[ j ] = cg.snap->entities[ j ].number;
+    }
+
+    cg.numPVSEntities = cg.snap->numEntities;
+    cg.pvsChanged = false;
+}
+
 /*
 ===============
 idCGameEnts::AddPacketEntities
@@ -1121,6 +1164,7 @@ void idCGameEnts::AddPacketEntities(void) {
     sint num;
     centity_t *cent;
     playerState_t *ps;
+    bool scanner;
 
     // set cg.frameInterpolation
     if(cg.nextSnap) {
@@ -1160,35 +1204,24 @@ void idCGameEnts::AddPacketEntities(void) {
     // lerp the non-predicted value for lightning gun origins
     CalcEntityLerpPositions(&cg_entities[ cg.snap->ps.clientNum ]);
 
-    // scanner
-    idCGameScanner::UpdateEntityPositions();
-
-    for(num = 0; num < MAX_GENTITIES; num++) {
-        cg_entities[num].valid = false;
+    // the PVS only changes with the snapshot
+    if(cg.pvsChanged) {
+        UpdatePVSEntities();
     }
 
+    scanner = idCGameScanner::BeginEntityPositions();
+    idCGameBuildable::ClearBuildableStatus();
+
     // add each entity sent over by the server
     for(num = 0; num < cg.snap->numEntities; num++) {
         cent = &cg_entities[ cg.snap->entities[ num ].number ];
-        cent->valid = true;
-    }
-
-    for(num = 0; num < MAX_GENTITIES; num++) {
-        cent = &cg_entities[ num ];
+        AddCEntity(cent);
 
-        if(cent->valid && !cent->oldValid) {
-            CEntityPVSEnter(cent);
-        } else if(!cent->valid && cent->oldValid) {
-            CEntityPVSLeave(cent);
+        if(scanner) {
+            idCGameScanner::AddEntityPosition(cent);
         }
 
-        cent->oldValid = cent->valid;
-    }
-
-    // add each entity sent over by the server
-    for(num = 0; num < cg.snap->numEntities; num++) {
-        cent = &cg_entities[ cg.snap->entities[ num ].number ];
-        AddCEntity(cent);
+        idCGameBuildable::AddBuildableStatus(cent);
     }
 
     //make an attempt at drawing bounding boxes of selected entity types
@@ -1240,4 +1273,6 @@ void idCGameEnts::LinkLocation(centity_t *cent) {
 
     cent->nextLocation = cg.locationHead;
     cg.locationHead = cent;
+
+    idCGamePlayers::ClearLocationCache();
 }
@@ -58,6 +58,7 @@ public:
     static void CalcEntityLerpPositions(centity_t *cent);
     static void CEntityPVSEnter(centity_t *cent);
     static void CEntityPVSLeave(centity_t *cent);
+    static void UpdatePVSEntities(void);
     static void AddCEntity(centity_t *cent);
     static void AddPacketEntities(void);
     static void LinkLocation(centity_t *cent);
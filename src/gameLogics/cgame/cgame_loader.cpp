@@ -0,0 +1,350 @@
+////////////////////////////////////////////////////////////////////////////////////////
+// Copyright(C) 2018 - 2021 Dusan Jocic <dusanjocic@msn.com>
+//
+// This file is part of OpenWolf.
+//
+// OpenWolf is free software; you can redistribute it
+// and / or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 3 of the License,
+// or (at your option) any later version.
+//
+// OpenWolf is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenWolf; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110 - 1301  USA
+//
+// -------------------------------------------------------------------------------------
+// File name:   cgame_loader.cpp
+// Created:
+// Compilers:   Microsoft (R) C/C++ Optimizing Compiler Version 19.26.28806 for x64,
+//              gcc (Ubuntu 9.3.0-10ubuntu2) 9.3.0
+// Description: threaded script parsing and loading progress
+// -------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cgame/cgame_precompiled.hpp>
+
+/*
+===================================================================
+LOADER
+
+Script files are read on the main thread and parsed by a small worker
+pool while the main thread registers sounds and graphics. Jobs must not
+call into the engine, anything they print is held back until Wait.
+Loading screen progress is the fraction of announced work units that
+have been completed, by either thread.
+===================================================================
+*/
+
+#define LOADER_MAX_WORKERS      4
+#define LOADER_SCRIPT_TEXT      0x400000
+#define LOADER_PRINT_TEXT       0x4000
+
+typedef struct {
+    void (*func)(void *data);
+    void *data;
+} loaderJob_t;
+
+static std::thread loaderWorkers[ LOADER_MAX_WORKERS ];
+static sint loaderNumWorkers;
+static std::queue<loaderJob_t> loaderJobs;
+static std::mutex loaderMutex;
+static std::condition_variable loaderWake;
+static std::condition_variable loaderIdle;
+static sint loaderPending;
+static bool loaderQuit;
+static thread_local bool loaderIsWorker;
+
+static std::atomic<sint> loaderWorkerUnits;
+static sint loaderMainUnits;
+static sint loaderTotalUnits;
+static float32 loaderDrawnFraction;
+
+static valueType loaderScriptText[ LOADER_SCRIPT_TEXT ];
+static sint loaderScriptUsed;
+static valueType loaderPrints[ LOADER_PRINT_TEXT ];
+
+/*
+===============
+idCGameLoader::idCGameLoader
+===============
+*/
+idCGameLoader::idCGameLoader(void) {
+}
+
+/*
+===============
+idCGameLoader::~idCGameLoader
+===============
+*/
+idCGameLoader::~idCGameLoader(void) {
+}
+
+/*
+===============
+idCGameLoader::Begin
+===============
+*/
+void idCGameLoader::Begin(void) {
+    loaderWorkerUnits = 0;
+    loaderMainUnits = 0;
+    loaderTotalUnits = 0;
+    loaderDrawnFraction = 0.0f;
+    loaderScriptUsed = 0;
+    loaderPrints[ 0 ] = '\0';
+}
+
+/*
+===============
+idCGameLoader::End
+===============
+*/
+void idCGameLoader::End(void) {
+    Wait();
+
+    loaderTotalUnits = 0;
+    loaderScriptUsed = 0;
+
+    idCGameDraw::UpdateMediaFraction(1.0f);
+}
+
+/*
+===============
+idCGameLoader::AddWork
+
+Announce work units that will be completed later in the load
+===============
+*/
+void idCGameLoader::AddWork(sint units) {
+    loaderTotalUnits += units;
+}
+
+/*
+===============
+idCGameLoader::CompleteWork
+===============
+*/
+void idCGameLoader::CompleteWork(sint units) {
+    loaderMainUnits += units;
+    UpdateProgress();
+}
+
+/*
+===============
+idCGameLoader::WorkerProgress
+
+Called from jobs, the screen is updated by the main thread
+===============
+*/
+void idCGameLoader::WorkerProgress(sint units) {
+    loaderWorkerUnits += units;
+}
+
+/*
+===============
+idCGameLoader::UpdateProgress
+
+Redraws the loading screen when the progress moved at least a percent
+===============
+*/
+void idCGameLoader::UpdateProgress(void) {
+    float32 fraction;
+
+    if(loaderTotalUnits <= 0) {
+        return;
+    }
+
+    fraction = (float32)(loaderMainUnits + loaderWorkerUnits) /
+               (float32)loaderTotalUnits;
+
+    if(fraction > 1.0f) {
+        fraction = 1.0f;
+    }
+
+    if(fraction == loaderDrawnFraction ||
+            (fraction < 1.0f && fraction - loaderDrawnFraction < 0.01f)) {
+        return;
+    }
+
+    loaderDrawnFraction = fraction;
+    idCGameDraw::UpdateMediaFraction(fraction);
+}
+
+/*
+===============
+idCGameLoader::WorkerLoop
+===============
+*/
+void idCGameLoader::WorkerLoop(void) {
+    loaderJob_t job;
+
+    loaderIsWorker = true;
+
+    while(1) {
+        std::unique_lock<std::mutex> lock(loaderMutex);
+
+        while(!loaderQuit && loaderJobs.empty()) {
+            loaderWake.wait(lock);
+        }
+
+        if(loaderJobs.empty()) {
+            return;
+        }
+
+        job = loaderJobs.front();
+        loaderJobs.pop();
+        lock.unlock();
+
+        job.func(job.data);
+
+        lock.lock();
+        loaderPending--;
+
+        if(!loaderPending) {
+            loaderIdle.notify_all();
+        }
+    }
+}
+
+/*
+===============
+idCGameLoader::Submit
+
+Queue a job, the pool is started by the first one and stopped by Wait
+===============
+*/
+void idCGameLoader::Submit(void (*func)(void *data), void *data) {
+    loaderJob_t job;
+    sint i, count;
+
+    if(!loaderNumWorkers) {
+        count = (sint)std::thread::hardware_concurrency() - 1;
+        count = Com_Clampi(1, LOADER_MAX_WORKERS, count);
+
+        loaderQuit = false;
+
+        for(i = 0; i < count; i++) {
+            loaderWorkers[ i ] = std::thread(WorkerLoop);
+        }
+
+        loaderNumWorkers = count;
+    }
+
+    job.func = func;
+    job.data = data;
+
+    std::lock_guard<std::mutex> lock(loaderMutex);
+    loaderJobs.push(job);
+    loaderPending++;
+    loaderWake.notify_one();
+}
+
+/*
+===============
+idCGameLoader::Wait
+
+Block until every queued job is done while keeping the loading screen
+moving, then stop the pool and print what the jobs reported
+===============
+*/
+void idCGameLoader::Wait(void) {
+    sint i;
+
+    if(!loaderNumWorkers) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(loaderMutex);
+
+    while(loaderPending) {
+        loaderIdle.wait_for(lock, std::chrono::milliseconds(50));
+
+        lock.unlock();
+        UpdateProgress();
+        lock.lock();
+    }
+
+    loaderQuit = true;
+    loaderWake.notify_all();
+    lock.unlock();
+
+    for(i = 0; i < loaderNumWorkers; i++) {
+        loaderWorkers[ i ].join();
+    }
+
+    loaderNumWorkers = 0;
+
+    if(loaderPrints[ 0 ]) {
+        trap_Print(loaderPrints);
+        loaderPrints[ 0 ] = '\0';
+    }
+
+    UpdateProgress();
+}
+
+/*
+===============
+idCGameLoader::OnWorkerThread
+===============
+*/
+bool idCGameLoader::OnWorkerThread(void) {
+    return loaderIsWorker;
+}
+
+/*
+===============
+idCGameLoader::DeferPrint
+===============
+*/
+void idCGameLoader::DeferPrint(pointer text) {
+    std::lock_guard<std::mutex> lock(loaderMutex);
+
+    Q_strcat(loaderPrints, sizeof(loaderPrints), text);
+}
+
+/*
+===============
+idCGameLoader::ReadScript
+
+Read a whole script into the load arena so it can be handed to a job,
+returns nullptr if it is missing, empty or longer than maxLen
+===============
+*/
+valueType *idCGameLoader::ReadScript(pointer fileName, sint maxLen) {
+    valueType *text;
+    fileHandle_t f;
+    sint len;
+
+    len = trap_FS_FOpenFile(fileName, &f, FS_READ);
+
+    if(len < 0) {
+        return nullptr;
+    }
+
+    if(len == 0 || len >= maxLen - 1) {
+        trap_FS_FCloseFile(f);
+        Printf(S_COLOR_RED "ERROR: script file %s is %s\n", fileName,
+               len == 0 ? "empty" : "too long");
+        return nullptr;
+    }
+
+    if(loaderScriptUsed + len + 1 > LOADER_SCRIPT_TEXT) {
+        trap_FS_FCloseFile(f);
+        Printf(S_COLOR_RED "ERROR: out of script memory loading %s\n",
+               fileName);
+        return nullptr;
+    }
+
+    text = &loaderScriptText[ loaderScriptUsed ];
+    loaderScriptUsed += len + 1;
+
+    trap_FS_Read(text, len, f);
+    text[ len ] = 0;
+    trap_FS_FCloseFile(f);
+
+    return text;
+}
@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////////////
+// Copyright(C) 2018 - 2021 Dusan Jocic <dusanjocic@msn.com>
+//
+// This file is part of OpenWolf.
+//
+// OpenWolf is free software; you can redistribute it
+// and / or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 3 of the License,
+// or (at your option) any later version.
+//
+// OpenWolf is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenWolf; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110 - 1301  USA
+//
+// -------------------------------------------------------------------------------------
+// File name:   cgame_loader.hpp
+// Created:
+// Compilers:   Microsoft (R) C/C++ Optimizing Compiler Version 19.26.28806 for x64,
+//              gcc (Ubuntu 9.3.0-10ubuntu2) 9.3.0
+// Description:
+// -------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CGAME_LOADER_H__
+#define __CGAME_LOADER_H__
+
+// loading screen work units for the media that isn't counted per item
+#define LOAD_UNITS_WORLD        16
+#define LOAD_UNITS_MEDIA        4
+
+class idCGameLocal;
+
+class idCGameLoader : public idCGameLocal {
+public:
+    idCGameLoader();
+    ~idCGameLoader();
+
+    static void Begin(void);
+    static void End(void);
+    static void AddWork(sint units);
+    static void CompleteWork(sint units);
+    static void WorkerProgress(sint units);
+    static void Submit(void (*func)(void *data), void *data);
+    static void Wait(void);
+    static bool OnWorkerThread(void);
+    static void DeferPrint(pointer text);
+    static valueType *ReadScript(pointer fileName, sint maxLen);
+private:
+    static void WorkerLoop(void);
+    static void UpdateProgress(void);
+};
+
+#endif //!__CGAME_LOADER_H__
@@ -59,7 +59,7 @@
 #define PULSE_SCALE         1.5     // amount to scale up the icons when activating
 #define MAX_STEP_CHANGE     32
 #define MAX_VERTS_ON_POLY   10
-#define MAX_MARK_POLYS      256
+#define MAX_MARK_POLYS      1024
 #define STAT_MINUS          10  // num frame for '-' stats digit
 #define ICON_SIZE           48
 #ifndef Q3MAP2
@@ -649,7 +649,6 @@ typedef struct centity_s {
     sint muzzleTSDeathTime;
 
     bool valid;
-    bool oldValid;
     struct centity_s *nextLocation;
 } centity_t;
 
@@ -657,11 +656,15 @@ typedef struct centity_s {
 //======================================================================
 
 typedef struct markPoly_s {
-    struct markPoly_s *prevMark, *nextMark;
+    struct markPoly_s *prevMark, *nextMark;     // age ordered active list
+    struct markPoly_s *prevInCell, *nextInCell; // spatial bucket list
     sint time;
+    sint cell;      // spatial bucket this mark is linked into
     qhandle_t markShader;
     bool alphaFade; // fade alpha instead of rgb
     float32 color[ 4 ];
+    vec3_t origin;  // centre of the fragment bounds, used for culling
+    float32 radius;
     poly_t poly;
     polyVert_t verts[ MAX_VERTS_ON_POLY ];
 } markPoly_t;
@@ -878,12 +881,51 @@ typedef struct {
 
 #define NUM_SAVED_STATES ( CMD_BACKUP + 2 )
 
+// typed player state read by the HUD, see idCGameMain::UpdateHudState
+#define HUD_STATE_VERSION 1
+
+typedef enum {
+    HUD_HEALTH,
+    HUD_MAX_HEALTH,
+    HUD_TEAM,
+    HUD_STAGE,
+    HUD_CLASS,
+    HUD_WEAPON,
+    HUD_UPGRADES,
+    HUD_AMMO,
+    HUD_CLIPS,
+    HUD_CREDITS,
+    HUD_SCORE,
+    HUD_ATTACKER,
+    HUD_CROSSHAIR,
+
+    HUD_NUM_FIELDS
+} hudField_t;
+
+typedef struct {
+    sint version;
+    sint generation;                          // bumped when any field changes
+    sint values[ HUD_NUM_FIELDS ];
+    sint fieldGenerations[ HUD_NUM_FIELDS ];  // generation of the last change
+    sint mirrorGeneration;                    // last generation copied to cvars
+} hudState_t;
+
 // After this many msec the crosshair name fades out completely
 #define CROSSHAIR_CLIENT_TIMEOUT 1000
 
 typedef struct {
     sint clientFrame; // incremented each frame
 
+    sint entityTraces;        // entity clip traces run this frame
+    sint entityTracesAvoided; // entity clip traces rejected by bounds
+
+    hudState_t hud;
+
+    // entity numbers in the PVS, merged against each new cg.snap
+    bool pvsChanged;
+    sint numPVSEntities;
+    sint pvsEntities[ MAX_ENTITIES_IN_SNAPSHOT ];
+
     sint clientNum;
 
     bool demoPlayback;
@@ -1402,6 +1444,33 @@ typedef struct {
     void(*completer)(void);
 } consoleCommand_t;
 
+// client frame profiler stages and counters, see idCGameProfile
+typedef enum {
+    PROF_SNAPSHOTS,
+    PROF_PREDICT,
+    PROF_ENTITIES,
+    PROF_MARKS,
+    PROF_PARTICLES,
+    PROF_TRAILS,
+    PROF_DRAW,
+
+    PROF_NUM_STAGES
+} cgProfileStage_t;
+
+typedef enum {
+    PROF_COUNT_TRACES,
+    PROF_COUNT_SUBMITS,
+    PROF_COUNT_ALLOCS,
+
+    PROF_NUM_COUNTERS
+} cgProfileCounter_t;
+
+// script text read by the main thread for a loader job, see idCGameLoader
+typedef struct {
+    valueType name[ MAX_QPATH ];
+    valueType *text;
+} scriptText_t;
+
 //==============================================================================
 
 extern cgs_t cgs;
@@ -1416,6 +1485,8 @@ extern buildableInfo_t cg_buildables[ BA_NUM_BUILDABLES ];
 
 extern markPoly_t cg_markPolys[ MAX_MARK_POLYS ];
 
+extern sint cg_profileCounters[ PROF_NUM_COUNTERS ];
+
 extern vmConvar_t cg_version;
 extern vmConvar_t cg_teslaTrailTime;
 extern vmConvar_t cg_centertime;
@@ -1448,6 +1519,7 @@ extern vmConvar_t cg_noPlayerAnims;
 extern vmConvar_t cg_showmiss;
 extern vmConvar_t cg_footsteps;
 extern vmConvar_t cg_addMarks;
+extern vmConvar_t cg_marksDistance;
 extern vmConvar_t cg_brassTime;
 extern vmConvar_t cg_viewsize;
 extern vmConvar_t cg_drawGun;
@@ -1469,6 +1541,8 @@ extern vmConvar_t cg_shoulderViewRight;
 extern vmConvar_t cg_shoulderViewForward;
 extern vmConvar_t cg_stereoSeparation;
 extern vmConvar_t cg_lagometer;
+extern vmConvar_t cg_profile;
+extern vmConvar_t cg_hudCvars;
 extern vmConvar_t cg_synchronousClients;
 extern vmConvar_t cg_stats;
 extern vmConvar_t cg_paused;
@@ -80,6 +80,7 @@ vmConvar_t cg_noPlayerAnims;
 vmConvar_t cg_showmiss;
 vmConvar_t cg_footsteps;
 vmConvar_t cg_addMarks;
+vmConvar_t cg_marksDistance;
 vmConvar_t cg_brassTime;
 vmConvar_t cg_viewsize;
 vmConvar_t cg_drawGun;
@@ -101,6 +102,8 @@ vmConvar_t cg_shoulderViewRight;
 vmConvar_t cg_shoulderViewForward;
 vmConvar_t cg_stereoSeparation;
 vmConvar_t cg_lagometer;
+vmConvar_t cg_profile;
+vmConvar_t cg_hudCvars;
 vmConvar_t cg_synchronousClients;
 vmConvar_t cg_stats;
 vmConvar_t cg_paused;
@@ -172,6 +175,7 @@ typedef struct {
     valueType *defaultString;
     sint cvarFlags;
     valueType *description;
+    convar_t *cvar;             // the engine's cvar, to see changes without asking
 } cvarTable_t;
 
 static cvarTable_t cvarTable[ ] = {
@@ -196,7 +200,10 @@ static cvarTable_t cvarTable[ ] = {
     { &cg_drawAmmoStack, "cg_drawAmmoStack", "1", CVAR_ARCHIVE },
     { &cg_brassTime, "cg_brassTime", "2500", CVAR_ARCHIVE },
     { &cg_addMarks, "cg_marks", "1", CVAR_ARCHIVE },
+    { &cg_marksDistance, "cg_marksDistance", "3072", CVAR_ARCHIVE },
     { &cg_lagometer, "cg_lagometer", "1", CVAR_ARCHIVE },
+    { &cg_profile, "cg_profile", "0", 0 },
+    { &cg_hudCvars, "cg_hudCvars", "1", CVAR_ARCHIVE },
     { &cg_teslaTrailTime, "cg_teslaTrailTime", "250", CVAR_ARCHIVE  },
     { &cg_gun_x, "cg_gunX", "0", CVAR_CHEAT },
     { &cg_gun_y, "cg_gunY", "0", CVAR_CHEAT },
@@ -336,6 +343,7 @@ void idCGameMain::RegisterCvars(void) {
     for(i = 0, cv = cvarTable; i < cvarTableSize; i++, cv++) {
         trap_Cvar_Register(cv->vmCvar, cv->cvarName, cv->defaultString,
                            cv->cvarFlags, cv->description);
+        cv->cvar = trap_Cvar_Find(cv->cvarName);
     }
 
     //repress standard Q3 console
@@ -352,105 +360,327 @@ void idCGameMain::RegisterCvars(void) {
 
 /*
 ===============
-idCGameMain::SetUIVars
+HUD STATE
 
-Set some cvars used by the UI
+The player state the HUD shows is kept as integers in cg.hud with a
+generation per field, so menus read it without going through cvars and
+can tell when a value changed. The p_* and ui_* cvars are only a mirror
+of it, written when a field changes. The ui_* ones are always mirrored
+because the UI module can't see cgame memory, p_* only while
+cg_hudCvars is set.
 ===============
 */
-void idCGameMain::SetUIVars(void) {
-    sint i, upgrades = 0;
+
+typedef enum {
+    HUDV_INT,
+    HUDV_TEAMNAME,
+    HUDV_CLASSNAME,
+    HUDV_WEAPONNAME,
+    HUDV_CLIENTNAME,
+    HUDV_CARRIAGE
+} hudCvarType_t;
+
+typedef struct {
+    pointer name;
+    hudField_t field;
+    hudCvarType_t type;
+    bool ui;                // read by the UI module, always mirrored
+} hudCvar_t;
+
+static const hudCvar_t hudCvars[ ] = {
+    { "p_hp", HUD_HEALTH, HUDV_INT, false },
+    { "p_maxhp", HUD_MAX_HEALTH, HUDV_INT, false },
+    { "p_team", HUD_TEAM, HUDV_INT, false },
+    { "p_teamname", HUD_TEAM, HUDV_TEAMNAME, false },
+    { "p_stage", HUD_STAGE, HUDV_INT, false },
+    { "p_class", HUD_CLASS, HUDV_INT, false },
+    { "p_classname", HUD_CLASS, HUDV_CLASSNAME, false },
+    { "p_weapon", HUD_WEAPON, HUDV_INT, false },
+    { "p_weaponname", HUD_WEAPON, HUDV_WEAPONNAME, false },
+    { "p_ammo", HUD_AMMO, HUDV_INT, false },
+    { "p_clips", HUD_CLIPS, HUDV_INT, false },
+    { "p_credits", HUD_CREDITS, HUDV_INT, false },
+    { "p_score", HUD_SCORE, HUDV_INT, false },
+    { "p_attacker", HUD_ATTACKER, HUDV_INT, false },
+    { "p_attackername", HUD_ATTACKER, HUDV_CLIENTNAME, false },
+    { "p_crosshair", HUD_CROSSHAIR, HUDV_INT, false },
+    { "p_crosshairrname", HUD_CROSSHAIR, HUDV_CLIENTNAME, false },
+    { "ui_stage", HUD_STAGE, HUDV_INT, true },
+    { "ui_carriage", HUD_WEAPON, HUDV_CARRIAGE, true }
+};
+
+static const sint numHudCvars = sizeof(hudCvars) / sizeof(hudCvars[0]);
+
+/*
+===============
+idCGameMain::UpdateHudState
+
+Copy the player state into cg.hud, bumping the generation of anything
+that changed
+===============
+*/
+void idCGameMain::UpdateHudState(void) {
+    sint i, upgrades = 0, values[ HUD_NUM_FIELDS ];
+    hudState_t *hud = &cg.hud;
+    playerState_t *ps;
+    bool changed = false;
 
     if(!cg.snap) {
         return;
     }
 
+    ps = &cg.snap->ps;
+
     //determine what the player is carrying
     for(i = UP_NONE + 1; i < UP_NUM_UPGRADES; i++) {
-        if(bggame->InventoryContainsUpgrade(i, cg.snap->ps.stats) &&
+        if(bggame->InventoryContainsUpgrade(i, ps->stats) &&
                 bggame->Upgrade((upgrade_t)i)->purchasable) {
             upgrades |= (1 << i);
         }
     }
 
-    trap_Cvar_Set("ui_carriage", va("%d %d %d",
-                                    cg.snap->ps.stats[ STAT_WEAPON ], upgrades,
-                                    cg.snap->ps.persistant[ PERS_CREDIT ]));
-
-    switch(cg.snap->ps.stats[ STAT_TEAM ]) {
-        case TEAM_NONE:
-            trap_Cvar_Set("ui_stage", "0");
-            break;
+    values[ HUD_HEALTH ] = ps->stats[ STAT_HEALTH ];
+    values[ HUD_MAX_HEALTH ] = ps->stats[ STAT_MAX_HEALTH ];
+    values[ HUD_TEAM ] = ps->stats[ STAT_TEAM ];
 
+    switch(ps->stats[ STAT_TEAM ]) {
         case TEAM_ALIENS:
-            trap_Cvar_Set("ui_stage", va("%d", cgs.alienStage));
+            values[ HUD_STAGE ] = cgs.alienStage;
             break;
 
         case TEAM_HUMANS:
-            trap_Cvar_Set("ui_stage", va("%d", cgs.humanStage));
+            values[ HUD_STAGE ] = cgs.humanStage;
+            break;
+
+        default:
+            values[ HUD_STAGE ] = 0;
             break;
     }
+
+    values[ HUD_CLASS ] = ps->stats[ STAT_CLASS ];
+    values[ HUD_WEAPON ] = ps->stats[ STAT_WEAPON ];
+    values[ HUD_UPGRADES ] = upgrades;
+    values[ HUD_AMMO ] = ps->ammo;
+    values[ HUD_CLIPS ] = ps->clips;
+    values[ HUD_CREDITS ] = ps->persistant[ PERS_CREDIT ];
+    values[ HUD_SCORE ] = ps->persistant[ PERS_SCORE ];
+    values[ HUD_ATTACKER ] = cgameLocal.LastAttacker();
+    values[ HUD_CROSSHAIR ] = cgameLocal.CrosshairPlayer();
+
+    for(i = 0; i < HUD_NUM_FIELDS; i++) {
+        if(hud->generation && hud->values[ i ] == values[ i ]) {
+            continue;
+        }
+
+        if(!changed) {
+            hud->generation++;
+            changed = true;
+        }
+
+        hud->values[ i ] = values[ i ];
+        hud->fieldGenerations[ i ] = hud->generation;
+    }
+
+    hud->version = HUD_STATE_VERSION;
 }
 
 /*
 ===============
-idCGameMain::SetPVars
+idCGameMain::HudClientChanged
 
-Set the p_* cvars
+The fields holding a client number don't change when that client's
+name does, so bump the ones that point at it for the name mirrors
 ===============
 */
-void idCGameMain::SetPVars(void) {
-    playerState_t *ps;
+void idCGameMain::HudClientChanged(sint clientNum) {
+    static const hudField_t clientFields[ ] = { HUD_ATTACKER, HUD_CROSSHAIR };
+    hudState_t *hud = &cg.hud;
+    sint i;
+    bool changed = false;
 
-    if(!cg.snap) {
+    if(!hud->generation) {
         return;
     }
 
-    ps = &cg.snap->ps;
+    for(i = 0; i < ARRAY_LEN(clientFields); i++) {
+        if(hud->values[ clientFields[ i ] ] != clientNum) {
+            continue;
+        }
 
-    trap_Cvar_Set("p_hp", va("%d", ps->stats[ STAT_HEALTH ]));
-    trap_Cvar_Set("p_maxhp", va("%d", ps->stats[ STAT_MAX_HEALTH ]));
-    trap_Cvar_Set("p_team", va("%d", ps->stats[ STAT_TEAM ]));
+        if(!changed) {
+            hud->generation++;
+            changed = true;
+        }
 
-    switch(ps->stats[ STAT_TEAM ]) {
-        case TEAM_NONE:
-            trap_Cvar_Set("p_teamname", "^3Spectator");
-            trap_Cvar_Set("p_stage", "0");
+        hud->fieldGenerations[ clientFields[ i ] ] = hud->generation;
+    }
+}
+
+/*
+===============
+idCGameMain::FindHudCvar
+
+Returns the hudCvars index for a cvar name or -1
+===============
+*/
+sint idCGameMain::FindHudCvar(pointer cvar) {
+    sint i;
+
+    if(Q_stricmpn(cvar, "p_", 2) && Q_stricmpn(cvar, "ui_", 3)) {
+        return -1;
+    }
+
+    for(i = 0; i < numHudCvars; i++) {
+        if(!Q_stricmp(cvar, hudCvars[ i ].name)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/*
+===============
+idCGameMain::HudCvarString
+
+Format a HUD state cvar the way it used to be set, returns false if it
+has no value
+===============
+*/
+bool idCGameMain::HudCvarString(sint index, valueType *buffer,
+                                uint64 bufsize) {
+    const hudCvar_t *hc = &hudCvars[ index ];
+    sint *values = cg.hud.values;
+    sint value = values[ hc->field ];
+
+    switch(hc->type) {
+        case HUDV_INT:
+            Q_vsprintf_s(buffer, bufsize, bufsize, "%d", value);
             break;
 
-        case TEAM_ALIENS:
-            trap_Cvar_Set("p_teamname", "^1Alien");
-            trap_Cvar_Set("p_stage", va("%d", cgs.alienStage));
+        case HUDV_TEAMNAME:
+            Q_strncpyz(buffer, value == TEAM_ALIENS ? "^1Alien" :
+                       value == TEAM_HUMANS ? "^4Human" : "^3Spectator", bufsize);
             break;
 
-        case TEAM_HUMANS:
-            trap_Cvar_Set("p_teamname", "^4Human");
-            trap_Cvar_Set("p_stage", va("%d", cgs.humanStage));
+        case HUDV_CLASSNAME:
+            Q_strncpyz(buffer, bggame->ClassConfig((class_t)value)->humanName,
+                       bufsize);
+            break;
+
+        case HUDV_WEAPONNAME:
+            Q_strncpyz(buffer, bggame->Weapon((weapon_t)value)->humanName,
+                       bufsize);
+            break;
+
+        case HUDV_CLIENTNAME:
+            if(value < 0 || value >= MAX_CLIENTS) {
+                buffer[ 0 ] = '\0';
+                return false;
+            }
+
+            Q_strncpyz(buffer, cgs.clientinfo[ value ].name, bufsize);
             break;
+
+        case HUDV_CARRIAGE:
+            Q_vsprintf_s(buffer, bufsize, bufsize, "%d %d %d",
+                         values[ HUD_WEAPON ], values[ HUD_UPGRADES ],
+                         values[ HUD_CREDITS ]);
+            break;
+    }
+
+    return true;
+}
+
+/*
+===============
+idCGameMain::MirrorHudCvars
+
+Write the fields that changed since the last call to their cvars
+===============
+*/
+void idCGameMain::MirrorHudCvars(void) {
+    static sint modificationCount = -1;
+    valueType buffer[ MAX_CVAR_VALUE_STRING ];
+    const hudCvar_t *hc;
+    sint i, generation;
+    bool all = false;
+
+    if(!cg.hud.generation) {
+        return;
     }
 
-    trap_Cvar_Set("p_class", va("%d", ps->stats[ STAT_CLASS ]));
-    trap_Cvar_Set("p_classname",
-                  bggame->ClassConfig((class_t)ps->stats[ STAT_CLASS ])->humanName);
-    trap_Cvar_Set("p_weapon", va("%d", ps->stats[ STAT_WEAPON ]));
-    trap_Cvar_Set("p_weaponname",
-                  bggame->Weapon((weapon_t)ps->stats[ STAT_WEAPON ])->humanName);
-    trap_Cvar_Set("p_ammo", va("%d", ps->ammo));
-    trap_Cvar_Set("p_clips", va("%d", ps->clips));
-    trap_Cvar_Set("p_credits", va("%d", ps->persistant[ PERS_CREDIT ]));
-    trap_Cvar_Set("p_score", va("%d", ps->persistant[ PERS_SCORE ]));
-    trap_Cvar_Set("p_attacker", va("%d", cgameLocal.LastAttacker()));
+    // everything again when the p_* mirror is switched on
+    if(cg_hudCvars.modificationCount != modificationCount) {
+        modificationCount = cg_hudCvars.modificationCount;
+        all = true;
+    }
+
+    for(i = 0, hc = hudCvars; i < numHudCvars; i++, hc++) {
+        if(!hc->ui && !cg_hudCvars.integer) {
+            continue;
+        }
+
+        generation = cg.hud.fieldGenerations[ hc->field ];
+
+        if(hc->type == HUDV_CARRIAGE) {
+            generation = MAX(generation, cg.hud.fieldGenerations[ HUD_UPGRADES ]);
+            generation = MAX(generation, cg.hud.fieldGenerations[ HUD_CREDITS ]);
+        }
+
+        if(!all && generation <= cg.hud.mirrorGeneration) {
+            continue;
+        }
 
-    if(cgameLocal.LastAttacker() != -1) {
-        trap_Cvar_Set("p_attackername",
-                      cgs.clientinfo[cgameLocal.LastAttacker()].name);
+        if(HudCvarString(i, buffer, sizeof(buffer))) {
+            trap_Cvar_Set(hc->name, buffer);
+        }
     }
 
-    trap_Cvar_Set("p_crosshair", va("%d", cgameLocal.CrosshairPlayer()));
+    cg.hud.mirrorGeneration = cg.hud.generation;
+}
+
+/*
+===============
+idCGameMain::GetCVarString
+
+Menu cvar reads, HUD state cvars come straight from cg.hud
+===============
+*/
+void idCGameMain::GetCVarString(pointer cvar, valueType *buffer,
+                                uint64 bufsize) {
+    sint index = FindHudCvar(cvar);
 
-    if(cgameLocal.CrosshairPlayer() != -1) {
-        trap_Cvar_Set("p_crosshairrname",
-                      cgs.clientinfo[cgameLocal.CrosshairPlayer()].name);
+    if(index >= 0 && cg.hud.generation) {
+        HudCvarString(index, buffer, bufsize);
+        return;
     }
+
+    trap_Cvar_VariableStringBuffer(cvar, buffer, bufsize);
+}
+
+/*
+===============
+idCGameMain::HudStateGeneration
+
+Generation a HUD state cvar last changed in, -1 for any other cvar
+===============
+*/
+sint idCGameMain::HudStateGeneration(pointer cvar) {
+    sint index = FindHudCvar(cvar), generation;
+
+    if(index < 0 || !cg.hud.generation) {
+        return -1;
+    }
+
+    generation = cg.hud.fieldGenerations[ hudCvars[ index ].field ];
+
+    if(hudCvars[ index ].type == HUDV_CARRIAGE) {
+        generation = MAX(generation, cg.hud.fieldGenerations[ HUD_UPGRADES ]);
+        generation = MAX(generation, cg.hud.fieldGenerations[ HUD_CREDITS ]);
+    }
+
+    return generation;
 }
 
 /*
@@ -462,15 +692,23 @@ void idCGameMain::UpdateCvars(void) {
     sint i;
     cvarTable_t *cv;
 
+    // only ask the engine for the cvars that changed
     for(i = 0, cv = cvarTable; i < cvarTableSize; i++, cv++) {
-        if(cv->vmCvar) {
-            trap_Cvar_Update(cv->vmCvar);
+        if(!cv->vmCvar) {
+            continue;
+        }
+
+        if(cv->cvar &&
+                cv->cvar->modificationCount == cv->vmCvar->modificationCount) {
+            continue;
         }
+
+        trap_Cvar_Update(cv->vmCvar);
     }
 
     // check for modications here
-    SetUIVars();
-    SetPVars();
+    UpdateHudState();
+    MirrorHudCvars();
 }
 
 /*
@@ -577,6 +815,12 @@ void idCGameLocal::Printf(pointer msg, ...) {
     Q_vsprintf_s(text, sizeof(text), msg, argptr);
     va_end(argptr);
 
+    // loader jobs can't call into the engine
+    if(idCGameLoader::OnWorkerThread()) {
+        idCGameLoader::DeferPrint(text);
+        return;
+    }
+
     trap_Print(text);
 }
 
@@ -731,6 +975,8 @@ void idCGameMain::RegisterSounds(void) {
         cgs.media.footsteps[ FOOTSTEP_METAL ][ i ] = trap_S_RegisterSound(name);
     }
 
+    idCGameLoader::CompleteWork(LOAD_UNITS_MEDIA);
+
     for(i = 1 ; i < MAX_SOUNDS ; i++) {
         soundName = ConfigString(CS_SOUNDS + i);
 
@@ -738,6 +984,8 @@ void idCGameMain::RegisterSounds(void) {
             break;
         }
 
+        idCGameLoader::CompleteWork(1);
+
         if(soundName[0] == '*') {
             continue; // custom sound
         }
@@ -871,7 +1119,7 @@ void idCGameMain::RegisterGraphics(void) {
     trap_R_ClearScene();
 
     trap_R_LoadWorldMap(cgs.mapname);
-    idCGameDraw::UpdateMediaFraction(0.66f);
+    idCGameLoader::CompleteWork(LOAD_UNITS_WORLD);
 
     for(i = 0; i < 11; i++) {
         cgs.media.numberShaders[i] = trap_R_RegisterShader(sb_nums[i]);
@@ -936,7 +1184,7 @@ void idCGameMain::RegisterGraphics(void) {
     cgs.media.disconnectPS =
         idCGameParticles::RegisterParticleSystem("disconnectPS");
 
-    idCGameDraw::UpdateMediaFraction(0.7f);
+    idCGameLoader::CompleteWork(LOAD_UNITS_MEDIA);
 
     ::memset(cg_weapons, 0, sizeof(cg_weapons));
     ::memset(cg_upgrades, 0, sizeof(cg_upgrades));
@@ -987,6 +1235,8 @@ void idCGameMain::RegisterGraphics(void) {
     idCGameBuildable::BuildableStatusParse("gui/assets/alien/buildstat.cfg",
                                            &cgs.alienBuildStat);
 
+    idCGameLoader::CompleteWork(LOAD_UNITS_MEDIA);
+
     // register the inline models
     cgs.numInlineModels = trap_CM_NumInlineModels();
 
@@ -995,6 +1245,8 @@ void idCGameMain::RegisterGraphics(void) {
         vec3_t  mins, maxs;
         sint j;
 
+        idCGameLoader::CompleteWork(1);
+
         Q_vsprintf_s(name, sizeof(name), sizeof(name), "*%i", i);
 
         cgs.inlineDrawModel[ i ] = trap_R_RegisterModel(name);
@@ -1016,10 +1268,9 @@ void idCGameMain::RegisterGraphics(void) {
         }
 
         cgs.gameModels[ i ] = trap_R_RegisterModel(modelName);
+        idCGameLoader::CompleteWork(1);
     }
 
-    idCGameDraw::UpdateMediaFraction(0.8f);
-
     // register all the server specified shaders
     for(i = 1; i < MAX_GAME_SHADERS; i++) {
         pointer shaderName;
@@ -1031,10 +1282,9 @@ void idCGameMain::RegisterGraphics(void) {
         }
 
         cgs.gameShaders[ i ] = trap_R_RegisterShader(shaderName);
+        idCGameLoader::CompleteWork(1);
     }
 
-    idCGameDraw::UpdateMediaFraction(0.9f);
-
     // register all the server specified particle systems
     for(i = 1; i < MAX_GAME_PARTICLE_SYSTEMS; i++) {
         pointer psName;
@@ -1047,9 +1297,53 @@ void idCGameMain::RegisterGraphics(void) {
 
         cgs.gameParticleSystems[ i ] = idCGameParticles::RegisterParticleSystem((
                                            valueType *)psName);
+        idCGameLoader::CompleteWork(1);
     }
 }
 
+/*
+=================
+idCGameMain::CountConfigStrings
+
+Number of consecutive config strings set from start + 1, the way the
+registration loops walk them
+=================
+*/
+sint idCGameMain::CountConfigStrings(sint start, sint max) {
+    sint i;
+
+    for(i = 1; i < max; i++) {
+        if(!ConfigString(start + i)[ 0 ]) {
+            break;
+        }
+    }
+
+    return i - 1;
+}
+
+/*
+=================
+idCGameMain::MediaWork
+
+Loading screen work units for RegisterSounds, RegisterGraphics,
+InitWeapons and InitUpgrades
+=================
+*/
+sint idCGameMain::MediaWork(void) {
+    sint units;
+
+    units = LOAD_UNITS_WORLD + LOAD_UNITS_MEDIA * 3;
+    units += CountConfigStrings(CS_SOUNDS, MAX_SOUNDS);
+    units += CountConfigStrings(CS_MODELS, MAX_MODELS);
+    units += CountConfigStrings(CS_SHADERS, MAX_GAME_SHADERS);
+    units += CountConfigStrings(CS_PARTICLE_SYSTEMS, MAX_GAME_PARTICLE_SYSTEMS);
+    units += MAX(trap_CM_NumInlineModels() - 1, 0);
+    units += WP_NUM_WEAPONS - (WP_NONE + 1);
+    units += UP_NUM_UPGRADES - (UP_NONE + 1);
+
+    return units;
+}
+
 /*
 =======================
 idCGameMain::BuildSpectatorString
@@ -1813,10 +2107,15 @@ idCGameMain::Cvar_Get
 */
 float32 idCGameMain::Cvar_Get(pointer cvar) {
     valueType buff[ 128 ];
+    sint index = FindHudCvar(cvar);
+
+    if(index >= 0 && cg.hud.generation && hudCvars[ index ].type == HUDV_INT) {
+        return cg.hud.values[ hudCvars[ index ].field ];
+    }
 
     ::memset(buff, 0, sizeof(buff));
 
-    trap_Cvar_VariableStringBuffer(cvar, buff, sizeof(buff));
+    GetCVarString(cvar, buff, sizeof(buff));
     return atof(buff);
 }
 
@@ -1931,8 +2230,9 @@ void idCGameMain::LoadHudMenu(void) {
     cgDC.ownerDrawVisible = &idCGameMain::OwnerDrawVisible;
     cgDC.runScript = &idCGameDraw::RunMenuScript;
     cgDC.setCVar = trap_Cvar_Set;
-    cgDC.getCVarString = trap_Cvar_VariableStringBuffer;
+    cgDC.getCVarString = &idCGameMain::GetCVarString;
     cgDC.getCVarValue = &idCGameMain::Cvar_Get;
+    cgDC.stateGeneration = &idCGameMain::HudStateGeneration;
     //cgDC.setOverstrikeMode = &trap_Key_SetOverstrikeMode;
     //cgDC.getOverstrikeMode = &trap_Key_GetOverstrikeMode;
     cgDC.startLocalSound = &trap_S_StartLocalSound;
@@ -2102,23 +2402,27 @@ void idCGameLocal::Init(sint serverMessageNum, sint serverCommandSequence,
 
     cg.loading = true; // force players to load instead of defer
 
-    idCGameTrails::LoadTrailSystems();
-    idCGameDraw::UpdateMediaFraction(0.05f);
+    idCGameLoader::Begin();
 
-    idCGameParticles::LoadParticleSystems();
-    idCGameDraw::UpdateMediaFraction(0.05f);
+    // the scripts are parsed by loader threads while the sounds register
+    idCGameTrails::BeginLoadTrailSystems();
+    idCGameParticles::BeginLoadParticleSystems();
+
+    idCGameLoader::AddWork(idCGameMain::MediaWork());
 
     idCGameMain::RegisterSounds();
-    idCGameDraw::UpdateMediaFraction(0.60f);
 
-    idCGameMain::RegisterGraphics();
-    idCGameDraw::UpdateMediaFraction(0.90f);
+    // graphics and weapons register particle and trail systems by name
+    idCGameLoader::Wait();
 
-    idCGameWeapons::InitWeapons();
-    idCGameDraw::UpdateMediaFraction(0.95f);
+    idCGameTrails::FinishLoadTrailSystems();
+    idCGameParticles::FinishLoadParticleSystems();
 
+    idCGameMain::RegisterGraphics();
+    idCGameWeapons::InitWeapons();
     idCGameWeapons::InitUpgrades();
-    idCGameDraw::UpdateMediaFraction(1.0f);
+
+    idCGameLoader::End();
 
     idCGameBuildable::InitBuildables();
 
@@ -37,8 +37,13 @@ public:
     ~idCGameMain();
 
     static void RegisterCvars(void);
-    static void SetUIVars(void);
-    static void SetPVars(void);
+    static void UpdateHudState(void);
+    static void HudClientChanged(sint clientNum);
+    static sint FindHudCvar(pointer cvar);
+    static bool HudCvarString(sint index, valueType *buffer, uint64 bufsize);
+    static void MirrorHudCvars(void);
+    static void GetCVarString(pointer cvar, valueType *buffer, uint64 bufsize);
+    static sint HudStateGeneration(pointer cvar);
     static void UpdateCvars(void);
     static void RemoveNotifyLine(void);
     static void AddNotifyText(void);
@@ -46,6 +51,8 @@ public:
     static bool FileExists(valueType *filename);
     static void RegisterSounds(void);
     static void RegisterGraphics(void);
+    static sint CountConfigStrings(sint start, sint max);
+    static sint MediaWork(void);
     static void BuildSpectatorString(void);
     static void RegisterClients(void);
     static pointer ConfigString(sint index);
@@ -33,14 +33,35 @@
 /*
 ===================================================================
 MARK POLYS
+
+Persistent marks live in a fixed pool and are linked into two lists:
+an age ordered active list used for expiry and eviction, and a bucket
+of a hashed 2D grid over the world so that AddMarks only visits the
+cells around the view. Visible marks are sorted by shader and submitted
+in batches through a single contiguous vertex buffer.
 ===================================================================
 */
 
+#define MARK_TOTAL_TIME         10000
+#define MARK_FADE_TIME          1000
+#define MARK_CELL_SIZE          512
+#define MARK_CELL_BUCKETS       256     // must be a power of two
+#define MARK_EVICT_CANDIDATES   32      // oldest marks considered for eviction
+#define MARK_RANGE_FADE         0.25f   // part of cg_marksDistance faded over
+#define MARK_BATCH_POLYS        600     // the renderer's minimum r_maxpolys
+#define MARK_BATCH_VERTS        3000    // the renderer's minimum r_maxpolyverts
+
 markPoly_t cg_activeMarkPolys;     // double linked list
 markPoly_t *cg_freeMarkPolys;      // single linked list
 markPoly_t cg_markPolys[ MAX_MARK_POLYS ];
+static markPoly_t cg_markCells[ MARK_CELL_BUCKETS ];   // bucket sentinels
+static sint markCellVisited[ MARK_CELL_BUCKETS ];
+static sint markVisitCount;
 static sint markTotal;
 
+static markPoly_t *markVisible[ MAX_MARK_POLYS ];
+static polyVert_t markBatchVerts[ MAX_MARK_POLYS * MAX_VERTS_ON_POLY ];
+
 /*
 ===============
 idCGameMarks::idCGameMarks
@@ -68,6 +89,9 @@ void idCGameMarks::InitMarkPolys(void) {
     sint i;
 
     ::memset(cg_markPolys, 0, sizeof(cg_markPolys));
+    ::memset(markCellVisited, 0, sizeof(markCellVisited));
+    markVisitCount = 0;
+    markTotal = 0;
 
     cg_activeMarkPolys.nextMark = &cg_activeMarkPolys;
     cg_activeMarkPolys.prevMark = &cg_activeMarkPolys;
@@ -76,6 +100,51 @@ void idCGameMarks::InitMarkPolys(void) {
     for(i = 0; i < MAX_MARK_POLYS - 1; i++) {
         cg_markPolys[i].nextMark = &cg_markPolys[i + 1];
     }
+
+    for(i = 0; i < MARK_CELL_BUCKETS; i++) {
+        cg_markCells[ i ].nextInCell = &cg_markCells[ i ];
+        cg_markCells[ i ].prevInCell = &cg_markCells[ i ];
+    }
+}
+
+/*
+===================
+idCGameMarks::CellForCoords
+
+Hashes a grid cell to its bucket
+===================
+*/
+sint idCGameMarks::CellForCoords(sint x, sint y) {
+    return (x * 73856093 ^ y * 19349663) & (MARK_CELL_BUCKETS - 1);
+}
+
+/*
+===================
+idCGameMarks::LinkMarkToCell
+===================
+*/
+void idCGameMarks::LinkMarkToCell(markPoly_t *mark) {
+    markPoly_t *sentinel;
+
+    mark->cell = CellForCoords((sint)floor(mark->origin[ 0 ] / MARK_CELL_SIZE),
+                               (sint)floor(mark->origin[ 1 ] / MARK_CELL_SIZE));
+    sentinel = &cg_markCells[ mark->cell ];
+
+    mark->nextInCell = sentinel->nextInCell;
+    mark->prevInCell = sentinel;
+    sentinel->nextInCell->prevInCell = mark;
+    sentinel->nextInCell = mark;
+}
+
+/*
+===================
+idCGameMarks::UnlinkMarkFromCell
+===================
+*/
+void idCGameMarks::UnlinkMarkFromCell(markPoly_t *mark) {
+    mark->prevInCell->nextInCell = mark->nextInCell;
+    mark->nextInCell->prevInCell = mark->prevInCell;
+    mark->prevInCell = mark->nextInCell = nullptr;
 }
 
 /*
@@ -88,13 +157,75 @@ void idCGameMarks::FreeMarkPoly(markPoly_t *le) {
         Error("idCGameLocal::FreeLocalEntity: not active");
     }
 
+    UnlinkMarkFromCell(le);
+
     // remove from the doubly linked active list
     le->prevMark->nextMark = le->nextMark;
     le->nextMark->prevMark = le->prevMark;
+    le->prevMark = nullptr;
 
     // the free list is only singly linked
     le->nextMark = cg_freeMarkPolys;
     cg_freeMarkPolys = le;
+
+    markTotal--;
+}
+
+/*
+===================
+idCGameMarks::MarkOffScreen
+
+Conservative test against a cone around the view direction
+===================
+*/
+bool idCGameMarks::MarkOffScreen(const markPoly_t *mark) {
+    vec3_t delta;
+    float32 forward, lateral, tanX, tanY, tanFov;
+
+    VectorSubtract(mark->origin, cg.refdef.vieworg, delta);
+    forward = DotProduct(delta, cg.refdef.viewaxis[ 0 ]);
+
+    if(forward < -mark->radius) {
+        return true;
+    }
+
+    if(cg.refdef.fov_x >= 180.0f || cg.refdef.fov_y >= 180.0f) {
+        return false;
+    }
+
+    // the cone has to reach the frustum corners, so use the diagonal
+    tanX = tan(DEG2RAD(cg.refdef.fov_x * 0.5f));
+    tanY = tan(DEG2RAD(cg.refdef.fov_y * 0.5f));
+    tanFov = sqrt(tanX * tanX + tanY * tanY);
+
+    lateral = sqrt(MAX(DotProduct(delta, delta) - forward * forward, 0.0f));
+
+    // radius / cos( halfFov ) without going through the angle
+    return lateral > forward * tanFov +
+           mark->radius * sqrt(1.0f + tanFov * tanFov);
+}
+
+/*
+===================
+idCGameMarks::EvictionScore
+
+Higher scores are evicted first: off-screen and distant marks go before
+old ones that are still in view
+===================
+*/
+float32 idCGameMarks::EvictionScore(const markPoly_t *mark) {
+    float32 score, range;
+
+    score = (float32)(cg.time - mark->time) / MARK_TOTAL_TIME;
+
+    if(MarkOffScreen(mark)) {
+        score += 2.0f;
+    }
+
+    range = cg_marksDistance.value > 0.0f ? cg_marksDistance.value : 4096.0f;
+    score += MIN(Distance(mark->origin, cg.refdef.vieworg) / range, 2.0f);
+
+    return score;
 }
 
 /*
@@ -105,18 +236,30 @@ Will allways succeed, even if it requires freeing an old active mark
 ===================
 */
 markPoly_t *idCGameMarks::AllocMark(void) {
-    markPoly_t *le;
-    sint time;
+    markPoly_t *le, *mp, *victim;
+    float32 score, bestScore;
+    sint i;
 
-    if(!cg_freeMarkPolys) {
-        // no free entities, so free the one at the end of the chain
-        // remove the oldest active entity
-        time = cg_activeMarkPolys.prevMark->time;
+    cg_profileCounters[ PROF_COUNT_ALLOCS ]++;
 
-        while(cg_activeMarkPolys.prevMark &&
-                time == cg_activeMarkPolys.prevMark->time) {
-            FreeMarkPoly(cg_activeMarkPolys.prevMark);
+    if(!cg_freeMarkPolys) {
+        // no free marks, so pick one of the oldest, preferring those
+        // the player can't see
+        victim = nullptr;
+        bestScore = -1.0f;
+
+        for(i = 0, mp = cg_activeMarkPolys.prevMark;
+                i < MARK_EVICT_CANDIDATES && mp != &cg_activeMarkPolys;
+                i++, mp = mp->prevMark) {
+            score = EvictionScore(mp);
+
+            if(score > bestScore) {
+                bestScore = score;
+                victim = mp;
+            }
         }
+
+        FreeMarkPoly(victim);
     }
 
     le = cg_freeMarkPolys;
@@ -130,6 +273,8 @@ markPoly_t *idCGameMarks::AllocMark(void) {
     cg_activeMarkPolys.nextMark->prevMark = le;
     cg_activeMarkPolys.nextMark = le;
 
+    markTotal++;
+
     return le;
 }
 
@@ -167,11 +312,6 @@ void idCGameMarks::ImpactMark(qhandle_t markShader, const vec3_t origin,
         Error("CG_ImpactMark called with <= 0 radius");
     }
 
-    //if ( markTotal >= MAX_MARK_POLYS )
-    //{
-    //    return;
-    //}
-
     // create the texture axis
     VectorNormalize2(dir, axis[ 0 ]);
     PerpendicularVector(axis[ 1 ], axis[ 0 ]);
@@ -207,6 +347,7 @@ void idCGameMarks::ImpactMark(qhandle_t markShader, const vec3_t origin,
         polyVert_t *v;
         polyVert_t verts[ MAX_VERTS_ON_POLY ];
         markPoly_t *mark;
+        vec3_t mins, maxs;
 
         // we have an upper limit on the complexity of polygons
         // that we store persistantly
@@ -214,10 +355,13 @@ void idCGameMarks::ImpactMark(qhandle_t markShader, const vec3_t origin,
             mf->numPoints = MAX_VERTS_ON_POLY;
         }
 
+        ClearBounds(mins, maxs);
+
         for(j = 0, v = verts; j < mf->numPoints; j++, v++) {
             vec3_t delta;
 
             VectorCopy(markPoints[ mf->firstPoint + j ], v->xyz);
+            AddPointToBounds(v->xyz, mins, maxs);
 
             VectorSubtract(v->xyz, origin, delta);
             v->st[ 0 ] = 0.5 + DotProduct(delta, axis[ 1 ]) * texCoordScale;
@@ -242,59 +386,203 @@ void idCGameMarks::ImpactMark(qhandle_t markShader, const vec3_t origin,
         mark->color[ 2 ] = blue;
         mark->color[ 3 ] = alpha;
         ::memcpy(mark->verts, verts, mf->numPoints * sizeof(verts[ 0 ]));
-        markTotal++;
+
+        VectorAdd(mins, maxs, mark->origin);
+        VectorScale(mark->origin, 0.5f, mark->origin);
+        mark->radius = RadiusFromBounds(mins, maxs);
+
+        LinkMarkToCell(mark);
     }
 }
 
+/*
+===============
+idCGameMarks::FreeExpiredMarks
+
+The active list is ordered by age, so only expired marks are touched
+===============
+*/
+void idCGameMarks::FreeExpiredMarks(void) {
+    while(cg_activeMarkPolys.prevMark != &cg_activeMarkPolys &&
+            cg.time > cg_activeMarkPolys.prevMark->time + MARK_TOTAL_TIME) {
+        FreeMarkPoly(cg_activeMarkPolys.prevMark);
+    }
+}
+
+/*
+===============
+idCGameMarks::SortMarks
+
+Groups marks by shader and vertex count so they can be batched
+===============
+*/
+sint idCGameMarks::SortMarks(const void *a, const void *b) {
+    const markPoly_t *ma = *(const markPoly_t * const *)a;
+    const markPoly_t *mb = *(const markPoly_t * const *)b;
+
+    if(ma->markShader != mb->markShader) {
+        return ma->markShader - mb->markShader;
+    }
+
+    return ma->poly.numVerts - mb->poly.numVerts;
+}
+
+/*
+===============
+idCGameMarks::GatherCell
+
+Appends the visible marks of a bucket to markVisible
+===============
+*/
+sint idCGameMarks::GatherCell(sint cell, float32 range, sint numVisible) {
+    markPoly_t *mp, *sentinel;
+
+    if(markCellVisited[ cell ] == markVisitCount) {
+        return numVisible;
+    }
+
+    markCellVisited[ cell ] = markVisitCount;
+    sentinel = &cg_markCells[ cell ];
+
+    for(mp = sentinel->nextInCell; mp != sentinel; mp = mp->nextInCell) {
+        if(range > 0.0f &&
+                DistanceSquared(mp->origin, cg.refdef.vieworg) >
+                Square(range + mp->radius)) {
+            continue;
+        }
+
+        if(MarkOffScreen(mp)) {
+            continue;
+        }
+
+        markVisible[ numVisible++ ] = mp;
+    }
+
+    return numVisible;
+}
+
 /*
 ===============
 idCGameMarks::AddMarks
 ===============
 */
-#define MARK_TOTAL_TIME   10000
-#define MARK_FADE_TIME    1000
 void idCGameMarks::AddMarks(void) {
-    sint j;
-    markPoly_t *mp, *next;
-    sint t, fade;
+    sint i, j, x, y, numVisible, numBatch, t, fade;
+    sint minX, maxX, minY, maxY;
+    float32 range, fadeStart, dist;
+    markPoly_t *mp, *first;
+    polyVert_t *v;
 
     if(!cg_addMarks.integer) {
         return;
     }
 
-    mp = cg_activeMarkPolys.nextMark;
+    FreeExpiredMarks();
 
-    for(; mp != &cg_activeMarkPolys; mp = next) {
-        // grab next now, so if the local entity is freed we
-        // still have it
-        next = mp->nextMark;
+    if(!markTotal) {
+        return;
+    }
 
-        // see if it is time to completely remove it
-        if(cg.time > mp->time + MARK_TOTAL_TIME) {
-            FreeMarkPoly(mp);
-            continue;
+    // gather the marks from the cells around the view, a bucket can be
+    // reached from several cells so only visit each once
+    markVisitCount++;
+    numVisible = 0;
+    range = cg_marksDistance.value;
+
+    if(range > 0.0f) {
+        minX = (sint)floor((cg.refdef.vieworg[ 0 ] - range) / MARK_CELL_SIZE);
+        maxX = (sint)floor((cg.refdef.vieworg[ 0 ] + range) / MARK_CELL_SIZE);
+        minY = (sint)floor((cg.refdef.vieworg[ 1 ] - range) / MARK_CELL_SIZE);
+        maxY = (sint)floor((cg.refdef.vieworg[ 1 ] + range) / MARK_CELL_SIZE);
+
+        if((maxX - minX + 1) * (maxY - minY + 1) < MARK_CELL_BUCKETS) {
+            for(x = minX; x <= maxX; x++) {
+                for(y = minY; y <= maxY; y++) {
+                    numVisible = GatherCell(CellForCoords(x, y), range, numVisible);
+                }
+            }
+        } else {
+            range = 0.0f;
+        }
+    }
+
+    if(range <= 0.0f) {
+        for(i = 0; i < MARK_CELL_BUCKETS; i++) {
+            numVisible = GatherCell(i, cg_marksDistance.value, numVisible);
+        }
+    }
+
+    if(!numVisible) {
+        return;
+    }
+
+    qsort(markVisible, numVisible, sizeof(markVisible[ 0 ]), SortMarks);
+
+    fadeStart = cg_marksDistance.value * (1.0f - MARK_RANGE_FADE);
+
+    // copy each run of matching marks into the vertex buffer, fading as
+    // we go, and submit the run with one renderer call
+    v = markBatchVerts;
+    numBatch = 0;
+    first = markVisible[ 0 ];
+
+    for(i = 0; i <= numVisible; i++) {
+        mp = i < numVisible ? markVisible[ i ] : nullptr;
+
+        // the renderer drops a whole call that exceeds its limits, so
+        // long runs are split
+        if(numBatch && (!mp || mp->markShader != first->markShader ||
+                        mp->poly.numVerts != first->poly.numVerts ||
+                        numBatch >= MARK_BATCH_POLYS ||
+                        (numBatch + 1) * first->poly.numVerts > MARK_BATCH_VERTS)) {
+            trap_R_AddPolysToScene(first->markShader, first->poly.numVerts,
+                                   v - numBatch * first->poly.numVerts, numBatch);
+            numBatch = 0;
+        }
+
+        if(!mp) {
+            break;
+        }
+
+        if(!numBatch) {
+            first = mp;
         }
 
+        ::memcpy(v, mp->verts, mp->poly.numVerts * sizeof(polyVert_t));
+
         // fade all marks out with time
         t = mp->time + MARK_TOTAL_TIME - cg.time;
+        fade = 255;
 
         if(t < MARK_FADE_TIME) {
             fade = 255 * t / MARK_FADE_TIME;
+        }
+
+        // and towards the edge of cg_marksDistance, so they don't pop
+        if(fadeStart > 0.0f) {
+            dist = Distance(mp->origin, cg.refdef.vieworg);
 
+            if(dist > fadeStart) {
+                fade = (sint)(fade * MAX(cg_marksDistance.value - dist, 0.0f) /
+                              (cg_marksDistance.value - fadeStart));
+            }
+        }
+
+        if(fade < 255) {
             if(mp->alphaFade) {
                 for(j = 0; j < mp->poly.numVerts; j++) {
-                    mp->verts[j].modulate[3] = fade;
+                    v[ j ].modulate[ 3 ] = fade;
                 }
             } else {
                 for(j = 0; j < mp->poly.numVerts; j++) {
-                    mp->verts[ j ].modulate[ 0 ] = mp->color[ 0 ] * fade;
-                    mp->verts[ j ].modulate[ 1 ] = mp->color[ 1 ] * fade;
-                    mp->verts[ j ].modulate[ 2 ] = mp->color[ 2 ] * fade;
+                    v[ j ].modulate[ 0 ] = mp->color[ 0 ] * fade;
+                    v[ j ].modulate[ 1 ] = mp->color[ 1 ] * fade;
+                    v[ j ].modulate[ 2 ] = mp->color[ 2 ] * fade;
                 }
             }
         }
 
-        trap_R_AddPolyToScene(mp->markShader, mp->poly.numVerts, mp->verts);
+        v += mp->poly.numVerts;
+        numBatch++;
     }
 }
-
@@ -45,6 +45,16 @@ public:
                            bool temporary);
     static void AddMarks(void);
 
+private:
+    static sint CellForCoords(sint x, sint y);
+    static void LinkMarkToCell(markPoly_t *mark);
+    static void UnlinkMarkFromCell(markPoly_t *mark);
+    static bool MarkOffScreen(const markPoly_t *mark);
+    static float32 EvictionScore(const markPoly_t *mark);
+    static void FreeExpiredMarks(void);
+    static sint GatherCell(sint cell, float32 range, sint numVisible);
+    static sint SortMarks(const void *a, const void *b);
+
 };
 
 #endif //!__CGAME_MARKS_H__
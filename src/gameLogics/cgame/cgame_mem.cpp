@@ -72,6 +72,8 @@ void *idCGameMem::Alloc(sint size) {
     valueType *endptr;
     sint *ptr;
 
+    cg_profileCounters[ PROF_COUNT_ALLOCS ]++;
+
     allocsize = (size + sizeof(sint) + ROUNDBITS) &
                 ~ROUNDBITS;     // Round to 32-byte boundary
     ptr = nullptr;
@@ -37,6 +37,20 @@ static baseParticle_t baseParticles[ MAX_BASEPARTICLES ];
 static sint numBaseParticleSystems = 0;
 static sint numBaseParticleEjectors = 0;
 static sint numBaseParticles = 0;
+static nameIndex_t baseParticleSystemIndex;
+
+static pointer BaseParticleSystemName(sint i) {
+    return baseParticleSystems[ i ].name;
+}
+
+#define PARTICLE_SCRIPT_TEXT 32000
+
+static scriptText_t particleScripts[ MAX_PARTICLE_FILES ];
+static sint numParticleScripts;
+static sint particleSourceSize;
+static uint32 particleSourceHash;
+static bool particlesCached;
+static sint particleLoadStart;
 
 static particleSystem_t particleSystems[ MAX_PARTICLE_SYSTEMS ];
 static particleEjector_t particleEjectors[ MAX_PARTICLE_EJECTORS ];
@@ -157,6 +171,8 @@ particle_t *idCGameParticles::SpawnNewParticle(baseParticle_t *bp,
     particleSystem_t *ps = parent->parent;
     vec3_t attachmentPoint, attachmentVelocity, transform[ 3 ];
 
+    cg_profileCounters[ PROF_COUNT_ALLOCS ]++;
+
     for(i = 0; i < MAX_PARTICLES; i++) {
         p = &particles[ i ];
 
@@ -419,6 +435,8 @@ particleEjector_t *idCGameParticles::SpawnNewParticleEjector(
     particleEjector_t *pe = nullptr;
     particleSystem_t *ps = parent;
 
+    cg_profileCounters[ PROF_COUNT_ALLOCS ]++;
+
     for(i = 0; i < MAX_PARTICLE_EJECTORS; i++) {
         pe = &particleEjectors[ i ];
 
@@ -465,6 +483,8 @@ particleSystem_t *idCGameParticles::SpawnNewParticleSystem(
     particleSystem_t *ps = nullptr;
     baseParticleSystem_t *bps = &baseParticleSystems[ psHandle - 1 ];
 
+    cg_profileCounters[ PROF_COUNT_ALLOCS ]++;
+
     if(!bps->registered) {
         Printf(S_COLOR_RED
                "ERROR: a particle system has not been registered yet\n");
@@ -511,66 +531,67 @@ qhandle_t idCGameParticles::RegisterParticleSystem(valueType *name) {
     baseParticleEjector_t *bpe;
     baseParticle_t *bp;
 
-    for(i = 0; i < MAX_BASEPARTICLE_SYSTEMS; i++) {
+    i = Com_NameIndexFind(&baseParticleSystemIndex, numBaseParticleSystems,
+                          BaseParticleSystemName, name);
+
+    if(i >= 0) {
         bps = &baseParticleSystems[ i ];
 
-        if(!Q_stricmpn(bps->name, name, MAX_QPATH)) {
-            //already registered
-            if(bps->registered) {
-                return i + 1;
-            }
+        //already registered
+        if(bps->registered) {
+            return i + 1;
+        }
 
-            for(j = 0; j < bps->numEjectors; j++) {
-                bpe = bps->ejectors[ j ];
+        for(j = 0; j < bps->numEjectors; j++) {
+            bpe = bps->ejectors[ j ];
 
-                for(l = 0; l < bpe->numParticles; l++) {
-                    bp = bpe->particles[ l ];
+            for(l = 0; l < bpe->numParticles; l++) {
+                bp = bpe->particles[ l ];
 
-                    for(k = 0; k < bp->numFrames; k++) {
-                        bp->shaders[k] = trap_R_RegisterShader(bp->shaderNames[k]);
-                    }
+                for(k = 0; k < bp->numFrames; k++) {
+                    bp->shaders[k] = trap_R_RegisterShader(bp->shaderNames[k]);
+                }
 
-                    for(k = 0; k < bp->numModels; k++) {
-                        bp->models[k] = trap_R_RegisterModel(bp->modelNames[k]);
-                    }
+                for(k = 0; k < bp->numModels; k++) {
+                    bp->models[k] = trap_R_RegisterModel(bp->modelNames[k]);
+                }
 
-                    if(bp->bounceMarkName[0] != '\0') {
-                        bp->bounceMark = trap_R_RegisterShader(bp->bounceMarkName);
-                    }
+                if(bp->bounceMarkName[0] != '\0') {
+                    bp->bounceMark = trap_R_RegisterShader(bp->bounceMarkName);
+                }
 
-                    if(bp->bounceSoundName[0] != '\0') {
-                        bp->bounceSound = trap_S_RegisterSound(bp->bounceSoundName);
-                    }
+                if(bp->bounceSoundName[0] != '\0') {
+                    bp->bounceSound = trap_S_RegisterSound(bp->bounceSoundName);
+                }
 
-                    //recursively register any children
-                    if(bp->childSystemName[ 0 ] != '\0') {
-                        //don't care about a handle for children since
-                        //the system deals with it
-                        RegisterParticleSystem(bp->childSystemName);
-                    }
+                //recursively register any children
+                if(bp->childSystemName[ 0 ] != '\0') {
+                    //don't care about a handle for children since
+                    //the system deals with it
+                    RegisterParticleSystem(bp->childSystemName);
+                }
 
-                    if(bp->onDeathSystemName[ 0 ] != '\0') {
-                        //don't care about a handle for children since
-                        //the system deals with it
-                        RegisterParticleSystem(bp->onDeathSystemName);
-                    }
+                if(bp->onDeathSystemName[ 0 ] != '\0') {
+                    //don't care about a handle for children since
+                    //the system deals with it
+                    RegisterParticleSystem(bp->onDeathSystemName);
+                }
 
-                    if(bp->childTrailSystemName[0] != '\0') {
-                        bp->childTrailSystemHandle = idCGameTrails::RegisterTrailSystem(
-                                                         bp->childTrailSystemName);
-                    }
+                if(bp->childTrailSystemName[0] != '\0') {
+                    bp->childTrailSystemHandle = idCGameTrails::RegisterTrailSystem(
+                                                     bp->childTrailSystemName);
                 }
             }
+        }
 
-            if(cg_debugParticles.integer >= 1) {
-                Printf("Registered particle system %s\n", name);
-            }
+        if(cg_debugParticles.integer >= 1) {
+            Printf("Registered particle system %s\n", name);
+        }
 
-            bps->registered = true;
+        bps->registered = true;
 
-            //avoid returning 0
-            return i + 1;
-        }
+        //avoid returning 0
+        return i + 1;
     }
 
     Printf(S_COLOR_RED "ERROR: failed to register particle system %s\n", name);
@@ -1629,34 +1650,15 @@ bool idCGameParticles::ParseParticleSystem(baseParticleSystem_t *bps,
 ===============
 idCGameParticles::ParseParticleFile
 
-Load the particle systems from a particle file
+Load the particle systems from the text of a particle file, runs on a
+loader thread
 ===============
 */
-bool idCGameParticles::ParseParticleFile(pointer fileName) {
+bool idCGameParticles::ParseParticleFile(pointer fileName, valueType *text) {
     valueType *text_p;
-    sint i, len;
     valueType *token;
-    valueType text[ 32000 ], psName[ MAX_QPATH ];
+    valueType psName[ MAX_QPATH ];
     bool psNameSet = false;
-    fileHandle_t f;
-
-    // load the file
-    len = trap_FS_FOpenFile(fileName, &f, FS_READ);
-
-    if(len < 0) {
-        return false;
-    }
-
-    if(len == 0 || len >= sizeof(text) - 1) {
-        trap_FS_FCloseFile(f);
-        Printf(S_COLOR_RED "ERROR: particle file %s is %s\n", fileName,
-               len == 0 ? "empty" : "too long");
-        return false;
-    }
-
-    trap_FS_Read(text, len, f);
-    text[ len ] = 0;
-    trap_FS_FCloseFile(f);
 
     // parse the text
     text_p = text;
@@ -1672,12 +1674,11 @@ bool idCGameParticles::ParseParticleFile(pointer fileName) {
         if(!Q_stricmp(token, "{")) {
             if(psNameSet) {
                 //check for name space clashes
-                for(i = 0; i < numBaseParticleSystems; i++) {
-                    if(!Q_stricmp(baseParticleSystems[ i ].name, psName)) {
-                        Printf(S_COLOR_RED "ERROR: a particle system is already named %s\n",
-                               psName);
-                        return false;
-                    }
+                if(Com_NameIndexFind(&baseParticleSystemIndex, numBaseParticleSystems,
+                                     BaseParticleSystemName, psName) >= 0) {
+                    Printf(S_COLOR_RED "ERROR: a particle system is already named %s\n",
+                           psName);
+                    return false;
                 }
 
                 Q_strncpyz(baseParticleSystems[ numBaseParticleSystems ].name, psName,
@@ -1724,21 +1725,178 @@ bool idCGameParticles::ParseParticleFile(pointer fileName) {
 
 /*
 ===============
-idCGameParticles::LoadParticleSystems
+idCGameParticles::ParticleCacheLayout
+
+Changes whenever one of the cached structures does
+===============
+*/
+sint idCGameParticles::ParticleCacheLayout(void) {
+    sint sizes[ 4 ];
+
+    sizes[ 0 ] = sizeof(baseParticleSystem_t);
+    sizes[ 1 ] = sizeof(baseParticleEjector_t);
+    sizes[ 2 ] = sizeof(baseParticle_t);
+    sizes[ 3 ] = sizeof(void *);
+
+    return (sint)bggame->CacheHash(sizes, sizeof(sizes), 0);
+}
+
+/*
+===============
+idCGameParticles::ReadParticleCache
+
+Restore the parsed templates from the cache, pointers between them are
+stored as index + 1
+===============
+*/
+bool idCGameParticles::ReadParticleCache(sint sourceSize,
+        uint32 sourceHash) {
+    sint i, j, index, counts[ 3 ], dataSize;
+    fileHandle_t f;
+
+    f = bggame->CacheOpenRead("particles", ParticleCacheLayout(), sourceSize,
+                              sourceHash, &dataSize);
+
+    if(!f) {
+        return false;
+    }
+
+    trap_FS_Read(counts, sizeof(counts), f);
+
+    if(counts[ 0 ] < 0 || counts[ 0 ] > MAX_BASEPARTICLE_SYSTEMS ||
+            counts[ 1 ] < 0 || counts[ 1 ] > MAX_BASEPARTICLE_EJECTORS ||
+            counts[ 2 ] < 0 || counts[ 2 ] > MAX_BASEPARTICLES ||
+            dataSize != (sint)(sizeof(counts) +
+                               counts[ 0 ] * sizeof(baseParticleSystem_t) +
+                               counts[ 1 ] * sizeof(baseParticleEjector_t) +
+                               counts[ 2 ] * sizeof(baseParticle_t))) {
+        trap_FS_FCloseFile(f);
+        return false;
+    }
+
+    numBaseParticleSystems = counts[ 0 ];
+    numBaseParticleEjectors = counts[ 1 ];
+    Com_NameIndexClear(&baseParticleSystemIndex);
+    numBaseParticles = counts[ 2 ];
+
+    trap_FS_Read(baseParticleSystems,
+                 numBaseParticleSystems * sizeof(baseParticleSystem_t), f);
+    trap_FS_Read(baseParticleEjectors,
+                 numBaseParticleEjectors * sizeof(baseParticleEjector_t), f);
+    trap_FS_Read(baseParticles, numBaseParticles * sizeof(baseParticle_t), f);
+    trap_FS_FCloseFile(f);
+
+    for(i = 0; i < numBaseParticleSystems; i++) {
+        baseParticleSystem_t *bps = &baseParticleSystems[ i ];
+
+        for(j = 0; j < MAX_EJECTORS_PER_SYSTEM; j++) {
+            index = (sint)(intptr_t)bps->ejectors[ j ];
+
+            if(index > 0 && index <= numBaseParticleEjectors) {
+                bps->ejectors[ j ] = &baseParticleEjectors[ index - 1 ];
+            } else {
+                bps->ejectors[ j ] = nullptr;
+            }
+        }
+    }
+
+    for(i = 0; i < numBaseParticleEjectors; i++) {
+        baseParticleEjector_t *bpe = &baseParticleEjectors[ i ];
+
+        for(j = 0; j < MAX_PARTICLES_PER_EJECTOR; j++) {
+            index = (sint)(intptr_t)bpe->particles[ j ];
+
+            if(index > 0 && index <= numBaseParticles) {
+                bpe->particles[ j ] = &baseParticles[ index - 1 ];
+            } else {
+                bpe->particles[ j ] = nullptr;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+===============
+idCGameParticles::WriteParticleCache
+===============
+*/
+void idCGameParticles::WriteParticleCache(sint sourceSize,
+        uint32 sourceHash) {
+    sint i, j, counts[ 3 ], dataSize;
+    fileHandle_t f;
+
+    counts[ 0 ] = numBaseParticleSystems;
+    counts[ 1 ] = numBaseParticleEjectors;
+    counts[ 2 ] = numBaseParticles;
+
+    dataSize = sizeof(counts) +
+               numBaseParticleSystems * sizeof(baseParticleSystem_t) +
+               numBaseParticleEjectors * sizeof(baseParticleEjector_t) +
+               numBaseParticles * sizeof(baseParticle_t);
+
+    f = bggame->CacheOpenWrite("particles", ParticleCacheLayout(), sourceSize,
+                               sourceHash, dataSize);
+
+    if(!f) {
+        return;
+    }
+
+    trap_FS_Write(counts, sizeof(counts), f);
+
+    for(i = 0; i < numBaseParticleSystems; i++) {
+        baseParticleSystem_t bps = baseParticleSystems[ i ];
+
+        for(j = 0; j < MAX_EJECTORS_PER_SYSTEM; j++) {
+            if(bps.ejectors[ j ]) {
+                bps.ejectors[ j ] = (baseParticleEjector_t *)(intptr_t)
+                                    (bps.ejectors[ j ] - baseParticleEjectors + 1);
+            }
+        }
+
+        bps.registered = false;
+        trap_FS_Write(&bps, sizeof(bps), f);
+    }
+
+    for(i = 0; i < numBaseParticleEjectors; i++) {
+        baseParticleEjector_t bpe = baseParticleEjectors[ i ];
+
+        for(j = 0; j < MAX_PARTICLES_PER_EJECTOR; j++) {
+            if(bpe.particles[ j ]) {
+                bpe.particles[ j ] = (baseParticle_t *)(intptr_t)
+                                     (bpe.particles[ j ] - baseParticles + 1);
+            }
+        }
+
+        trap_FS_Write(&bpe, sizeof(bpe), f);
+    }
+
+    trap_FS_Write(baseParticles, numBaseParticles * sizeof(baseParticle_t), f);
+    trap_FS_FCloseFile(f);
+}
+
+/*
+===============
+idCGameParticles::BeginLoadParticleSystems
 
-Load particle systems from .particle files
+Read the .particle files and queue them for parsing unless the cache
+is still valid for them
 ===============
 */
-void idCGameParticles::LoadParticleSystems(void) {
-    sint i, j, numFiles, fileLen;
+void idCGameParticles::BeginLoadParticleSystems(void) {
+    sint i, numFiles, fileLen, len;
     valueType fileList[ MAX_PARTICLE_FILES * MAX_QPATH ];
-    valueType fileName[ MAX_QPATH ];
-    valueType *filePtr;
+    valueType *filePtr, *text;
+    scriptText_t *script;
+
+    particleLoadStart = trap_Milliseconds();
 
     //clear out the old
     numBaseParticleSystems = 0;
     numBaseParticleEjectors = 0;
     numBaseParticles = 0;
+    Com_NameIndexClear(&baseParticleSystemIndex);
 
     for(i = 0; i < MAX_BASEPARTICLE_SYSTEMS; i++) {
         baseParticleSystem_t  *bps = &baseParticleSystems[ i ];
@@ -1761,12 +1919,73 @@ void idCGameParticles::LoadParticleSystems(void) {
                                    MAX_PARTICLE_FILES * MAX_QPATH);
     filePtr = fileList;
 
+    numParticleScripts = 0;
+    particleSourceSize = 0;
+    particleSourceHash = 0;
+
     for(i = 0; i < numFiles; i++, filePtr += fileLen + 1) {
         fileLen = strlen(filePtr);
-        strcpy(fileName, "scripts/");
-        strcat(fileName, filePtr);
-        //Printf( "...loading '%s'\n", fileName );
-        ParseParticleFile(fileName);
+        script = &particleScripts[ numParticleScripts ];
+
+        Q_vsprintf_s(script->name, sizeof(script->name), sizeof(script->name),
+                     "scripts/%s", filePtr);
+
+        text = idCGameLoader::ReadScript(script->name, PARTICLE_SCRIPT_TEXT);
+
+        if(!text) {
+            continue;
+        }
+
+        script->text = text;
+        numParticleScripts++;
+
+        //key the cache on the name, size and contents of every file
+        len = strlen(text);
+        particleSourceSize += len;
+        particleSourceHash = bggame->CacheHash(filePtr, fileLen,
+                                               particleSourceHash);
+        particleSourceHash = bggame->CacheHash(text, len, particleSourceHash);
+    }
+
+    particlesCached = ReadParticleCache(particleSourceSize, particleSourceHash);
+
+    if(!particlesCached) {
+        idCGameLoader::AddWork(numParticleScripts);
+        idCGameLoader::Submit(ParseParticleFiles, nullptr);
+    }
+}
+
+/*
+===============
+idCGameParticles::ParseParticleFiles
+
+Loader job, files are parsed in order so handles don't depend on timing
+===============
+*/
+void idCGameParticles::ParseParticleFiles(void *data) {
+    sint i;
+
+    for(i = 0; i < numParticleScripts; i++) {
+        //Printf( "...loading '%s'\n", particleScripts[ i ].name );
+        ParseParticleFile(particleScripts[ i ].name, particleScripts[ i ].text);
+        idCGameLoader::WorkerProgress(1);
+    }
+}
+
+/*
+===============
+idCGameParticles::FinishLoadParticleSystems
+
+Resolve the parsed systems once the loader job is done
+===============
+*/
+void idCGameParticles::FinishLoadParticleSystems(void) {
+    sint i, j;
+
+    if(particlesCached) {
+        Printf("Loaded %d particle systems from cache in %d msec\n",
+               numBaseParticleSystems, trap_Milliseconds() - particleLoadStart);
+        return;
     }
 
     //connect any child systems to their psHandle
@@ -1815,6 +2034,11 @@ void idCGameParticles::LoadParticleSystems(void) {
             }
         }
     }
+
+    WriteParticleCache(particleSourceSize, particleSourceHash);
+
+    Printf("Parsed %d particle systems in %d msec\n", numBaseParticleSystems,
+           trap_Milliseconds() - particleLoadStart);
 }
 
 /*
@@ -56,8 +56,13 @@ public:
                                      valueType **text_p);
     static bool ParseParticleSystem(baseParticleSystem_t *bps,
                                     valueType **text_p, pointer name);
-    static bool ParseParticleFile(pointer fileName);
-    static void LoadParticleSystems(void);
+    static bool ParseParticleFile(pointer fileName, valueType *text);
+    static sint ParticleCacheLayout(void);
+    static bool ReadParticleCache(sint sourceSize, uint32 sourceHash);
+    static void WriteParticleCache(sint sourceSize, uint32 sourceHash);
+    static void BeginLoadParticleSystems(void);
+    static void ParseParticleFiles(void *data);
+    static void FinishLoadParticleSystems(void);
     static void SetParticleSystemNormal(particleSystem_t *ps, vec3_t normal);
     static void DestroyParticleSystem(particleSystem_t **ps);
     static bool IsParticleSystemInfinite(particleSystem_t *ps);
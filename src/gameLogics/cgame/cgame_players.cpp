@@ -817,6 +817,10 @@ void idCGamePlayers::NewClientInfo(sint clientNum) {
     configstring = idCGameMain::ConfigString(clientNum + CS_PLAYERS);
 
     if(!configstring[ 0 ]) {
+        if(ci->name[ 0 ]) {
+            idCGameMain::HudClientChanged(clientNum);
+        }
+
         ::memset(ci, 0, sizeof(*ci));
         return;   // player just left
     }
@@ -887,6 +891,11 @@ void idCGamePlayers::NewClientInfo(sint clientNum) {
     v = Info_ValueForKey(configstring, "v");
     Q_strncpyz(newInfo.voice, v, sizeof(newInfo.voice));
 
+    // the HUD shows names by client number, let it know about a rename
+    if(strcmp(ci->name, newInfo.name)) {
+        idCGameMain::HudClientChanged(clientNum);
+    }
+
     // replace whatever was there with the new one
     newInfo.infoValid = true;
     *ci = newInfo;
@@ -2908,21 +2917,33 @@ void idCGamePlayers::DrawTeamStatus(void) {
     }
 }
 
+static cellCache_t locationCache;
+
 /*
 ==================
-idCGamePlayers::GetPlayerLocation
+idCGamePlayers::ClearLocationCache
+
+Called when a location entity is linked
 ==================
 */
-centity_t *idCGamePlayers::GetPlayerLocation(void) {
+void idCGamePlayers::ClearLocationCache(void) {
+    Com_CellCacheClear(&locationCache, LOCATION_CELL_SIZE);
+}
+
+/*
+==================
+idCGamePlayers::LocationForPoint
+
+The closest location entity in the PVS of origin, or -1
+==================
+*/
+sint idCGamePlayers::LocationForPoint(const vec3_t origin) {
     centity_t *eloc, *best;
     float32 bestlen, len;
-    vec3_t origin;
 
     best = nullptr;
     bestlen = 3.0f * 8192.0f * 8192.0f;
 
-    VectorCopy(cg.predictedPlayerState.origin, origin);
-
     for(eloc = cg.locationHead; eloc; eloc = eloc->nextLocation) {
         len = DistanceSquared(origin, eloc->lerpOrigin);
 
@@ -2938,5 +2959,19 @@ centity_t *idCGamePlayers::GetPlayerLocation(void) {
         best = eloc;
     }
 
-    return best;
+    return best ? best->currentState.number : -1;
+}
+
+/*
+==================
+idCGamePlayers::GetPlayerLocation
+==================
+*/
+centity_t *idCGamePlayers::GetPlayerLocation(void) {
+    sint location;
+
+    location = Com_CellCacheLookup(&locationCache,
+                                   cg.predictedPlayerState.origin, LocationForPoint);
+
+    return location >= 0 ? &cg_entities[ location ] : nullptr;
 }
@@ -88,6 +88,8 @@ public:
     static void TeamStatusDisplay(centity_t *cent);
     static sint SortDistance2(const void *a, const void *b);
     static void DrawTeamStatus(void);
+    static void ClearLocationCache(void);
+    static sint LocationForPoint(const vec3_t origin);
     static centity_t *GetPlayerLocation(void);
 };
 
@@ -36,6 +36,10 @@
 #include <setjmp.h>
 #include <iostream>
 #include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
 #include <queue>
 #include <assert.h>
 #include <cstddef>
@@ -101,6 +105,7 @@
 #include <cgame/cgame_drawtools.hpp>
 #include <cgame/cgame_ents.hpp>
 #include <cgame/cgame_event.hpp>
+#include <cgame/cgame_loader.hpp>
 #include <cgame/cgame_main.hpp>
 #include <cgame/cgame_marks.hpp>
 #include <cgame/cgame_mem.hpp>
@@ -108,6 +113,7 @@
 #include <cgame/cgame_players.hpp>
 #include <cgame/cgame_playerstate.hpp>
 #include <cgame/cgame_predict.hpp>
+#include <cgame/cgame_profile.hpp>
 #include <cgame/cgame_ptr.hpp>
 #include <cgame/cgame_scanner.hpp>
 #include <cgame/cgame_servercmds.hpp>
@@ -36,8 +36,14 @@
 
 static pmove_t cg_pmove;
 
+typedef struct {
+    centity_t *cent;
+    sint solid;         // encoded value the bounds were decoded from
+    vec3_t mins, maxs;  // decoded bounds relative to the entity origin
+} solidEntity_t;
+
 static sint cg_numSolidEntities;
-static centity_t *cg_solidEntities[MAX_GENTITIES];
+static solidEntity_t cg_solidEntities[MAX_ENTITIES_IN_SNAPSHOT];
 static sint cg_numTriggerEntities;
 static centity_t *cg_triggerEntities[MAX_ENTITIES_IN_SNAPSHOT];
 
@@ -63,7 +69,9 @@ idCGamePredict::BuildSolidList
 
 When a new cg.snap has been set, this function builds a sublist
 of the entities that are actually solid, to make for more
-efficient collision detection
+efficient collision detection. The encoded bounding boxes are
+decoded here once so traces can reject entities they can't touch
+without asking the collision model.
 ====================
 */
 void idCGamePredict::BuildSolidList(void) {
@@ -71,6 +79,7 @@ void idCGamePredict::BuildSolidList(void) {
     centity_t *cent;
     snapshot_t *snap;
     entityState_t *ent;
+    solidEntity_t *solid;
 
     cg_numSolidEntities = 0;
     cg_numTriggerEntities = 0;
@@ -93,13 +102,42 @@ void idCGamePredict::BuildSolidList(void) {
         }
 
         if(cent->nextState.solid && ent->eType != ET_MISSILE) {
-            cg_solidEntities[cg_numSolidEntities] = cent;
+            solid = &cg_solidEntities[cg_numSolidEntities];
+            solid->cent = cent;
+            solid->solid = ent->solid;
+            DecodeSolidBounds(solid->solid, solid->mins, solid->maxs);
             cg_numSolidEntities++;
             continue;
         }
     }
 }
 
+/*
+====================
+idCGamePredict::DecodeSolidBounds
+====================
+*/
+void idCGamePredict::DecodeSolidBounds(sint solid, vec3_t mins,
+                                       vec3_t maxs) {
+    sint x, zd, zu;
+
+    if(solid == SOLID_BMODEL) {
+        VectorClear(mins);
+        VectorClear(maxs);
+        return;
+    }
+
+    // encoded bbox
+    x = (solid & 255);
+    zd = ((solid >> 8) & 255);
+    zu = ((solid >> 16) & 255) - 32;
+
+    mins[ 0 ] = mins[ 1 ] = -x;
+    maxs[ 0 ] = maxs[ 1 ] = x;
+    mins[ 2 ] = -zd;
+    maxs[ 2 ] = zu;
+}
+
 /*
 ====================
 idCGamePredict::ClipMoveToEntities
@@ -108,12 +146,27 @@ idCGamePredict::ClipMoveToEntities
 void idCGamePredict::ClipMoveToEntities(const vec3_t start,
                                         const vec3_t mins, const vec3_t maxs, const vec3_t end, sint skipNumber,
                                         sint mask, trace_t *tr, traceType_t collisionType) {
-    sint i, j, x, zd, zu;
+    sint i, j, k;
     trace_t trace;
     entityState_t *ent;
     clipHandle_t cmodel;
-    vec3_t bmins, bmaxs, origin, angles;
+    vec3_t bmins, bmaxs, origin, angles, traceMins, traceMaxs;
     centity_t *cent;
+    solidEntity_t *solid;
+
+    // bounds of the whole move, bispheres pass their radii in mins/maxs[ 0 ]
+    for(k = 0; k < 3; k++) {
+        if(collisionType == TT_BISPHERE) {
+            traceMins[ k ] = MIN(start[ k ] - mins[ 0 ], end[ k ] - maxs[ 0 ]);
+            traceMaxs[ k ] = MAX(start[ k ] + mins[ 0 ], end[ k ] + maxs[ 0 ]);
+        } else {
+            traceMins[ k ] = MIN(start[ k ], end[ k ]) + mins[ k ];
+            traceMaxs[ k ] = MAX(start[ k ], end[ k ]) + maxs[ k ];
+        }
+
+        traceMins[ k ] -= 1.0f;
+        traceMaxs[ k ] += 1.0f;
+    }
 
     //SUPAR HACK
     //this causes a trace to collide with the local player
@@ -125,8 +178,10 @@ void idCGamePredict::ClipMoveToEntities(const vec3_t start,
 
     for(i = 0; i < j; i++) {
         if(i < cg_numSolidEntities) {
-            cent = cg_solidEntities[i];
+            solid = &cg_solidEntities[i];
+            cent = solid->cent;
         } else {
+            solid = nullptr;
             cent = &cg.predictedPlayerEntity;
         }
 
@@ -136,6 +191,27 @@ void idCGamePredict::ClipMoveToEntities(const vec3_t start,
             continue;
         }
 
+        if(solid && ent->solid != SOLID_BMODEL) {
+            // the list may have been built before the last transition
+            if(ent->solid != solid->solid) {
+                solid->solid = ent->solid;
+                DecodeSolidBounds(solid->solid, solid->mins, solid->maxs);
+            }
+
+            // cheap rejection before building a box model and tracing it
+            for(k = 0; k < 3; k++) {
+                if(cent->lerpOrigin[ k ] + solid->mins[ k ] > traceMaxs[ k ] ||
+                        cent->lerpOrigin[ k ] + solid->maxs[ k ] < traceMins[ k ]) {
+                    break;
+                }
+            }
+
+            if(k < 3) {
+                cg.entityTracesAvoided++;
+                continue;
+            }
+        }
+
         if(ent->solid == SOLID_BMODEL) {
             // special value for bmodel
             cmodel = trap_CM_InlineModel(ent->modelindex);
@@ -143,17 +219,11 @@ void idCGamePredict::ClipMoveToEntities(const vec3_t start,
             bggame->EvaluateTrajectory(&cent->currentState.pos, cg.physicsTime,
                                        origin);
         } else {
-            // encoded bbox
-            x = (ent->solid & 255);
-            zd = ((ent->solid >> 8) & 255);
-            zu = ((ent->solid >> 16) & 255) - 32;
-
-            bmins[ 0 ] = bmins[ 1 ] = -x;
-            bmaxs[ 0 ] = bmaxs[ 1 ] = x;
-            bmins[ 2 ] = -zd;
-            bmaxs[ 2 ] = zu;
-
-            if(i == cg_numSolidEntities) {
+            if(solid) {
+                VectorCopy(solid->mins, bmins);
+                VectorCopy(solid->maxs, bmaxs);
+            } else {
+                DecodeSolidBounds(ent->solid, bmins, bmaxs);
                 bggame->ClassBoundingBox((class_t)((ent->misc >> 8) & 0xFF), bmins, bmaxs,
                                          nullptr, nullptr, nullptr);
             }
@@ -163,6 +233,8 @@ void idCGamePredict::ClipMoveToEntities(const vec3_t start,
             VectorCopy(cent->lerpOrigin, origin);
         }
 
+        cg.entityTraces++;
+
         if(collisionType == TT_CAPSULE) {
             trap_CM_TransformedCapsuleTrace(&trace, start, end, mins, maxs, cmodel,
                                             mask, origin, angles);
@@ -273,7 +345,7 @@ sint idCGamePredict::PointContents(const vec3_t point,
     contents = trap_CM_PointContents(point, 0);
 
     for(i = 0; i < cg_numSolidEntities; i++) {
-        cent = cg_solidEntities[ i ];
+        cent = cg_solidEntities[ i ].cent;
 
         ent = &cent->currentState;
 
@@ -37,6 +37,7 @@ public:
     ~idCGamePredict();
 
     static void BuildSolidList(void);
+    static void DecodeSolidBounds(sint solid, vec3_t mins, vec3_t maxs);
     static void ClipMoveToEntities(const vec3_t start, const vec3_t mins,
                                    const vec3_t maxs, const vec3_t end, sint skipNumber, sint mask,
                                    trace_t *tr, traceType_t collisionType);
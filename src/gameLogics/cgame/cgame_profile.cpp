@@ -0,0 +1,302 @@
+////////////////////////////////////////////////////////////////////////////////////////
+// Copyright(C) 2018 - 2021 Dusan Jocic <dusanjocic@msn.com>
+//
+// This file is part of OpenWolf.
+//
+// OpenWolf is free software; you can redistribute it
+// and / or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 3 of the License,
+// or (at your option) any later version.
+//
+// OpenWolf is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenWolf; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110 - 1301  USA
+//
+// -------------------------------------------------------------------------------------
+// File name:   cgame_profile.cpp
+// Created:
+// Compilers:   Microsoft (R) C/C++ Optimizing Compiler Version 19.26.28806 for x64,
+//              gcc (Ubuntu 9.3.0-10ubuntu2) 9.3.0
+// Description: client frame profiler
+// -------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cgame/cgame_precompiled.hpp>
+
+#define PROF_FRAMES         512     // must be a power of two
+#define PROF_GRAPH_USEC     16000   // graph height in microseconds
+
+typedef struct {
+    sint clientFrame;
+    sint time;
+    sint usec[ PROF_NUM_STAGES ];
+    sint counts[ PROF_NUM_STAGES ][ PROF_NUM_COUNTERS ];
+    sint totalUsec;
+} profileFrame_t;
+
+static pointer profileStageNames[ PROF_NUM_STAGES ] = {
+    "snapshots",
+    "predict",
+    "entities",
+    "marks",
+    "particles",
+    "trails",
+    "draw"
+};
+
+static pointer profileCounterNames[ PROF_NUM_COUNTERS ] = {
+    "traces",
+    "submits",
+    "allocs"
+};
+
+static sint profileStageColors[ PROF_NUM_STAGES ] = {
+    COLOR_RED,
+    COLOR_GREEN,
+    COLOR_YELLOW,
+    COLOR_BLUE,
+    COLOR_CYAN,
+    COLOR_MAGENTA,
+    COLOR_WHITE
+};
+
+sint cg_profileCounters[ PROF_NUM_COUNTERS ];
+
+static profileFrame_t profileFrames[ PROF_FRAMES ];
+static sint profileFrameCount;
+static profileFrame_t profileCurrent;
+static bool profileActive;
+static std::chrono::steady_clock::time_point profileFrameStart;
+static std::chrono::steady_clock::time_point profileStageStart[ PROF_NUM_STAGES ];
+static sint profileStageCounters[ PROF_NUM_STAGES ][ PROF_NUM_COUNTERS ];
+
+/*
+===============
+idCGameProfile::idCGameProfile
+===============
+*/
+idCGameProfile::idCGameProfile(void) {
+}
+
+/*
+===============
+idCGameProfile::~idCGameProfile
+===============
+*/
+idCGameProfile::~idCGameProfile(void) {
+}
+
+/*
+===============
+idCGameProfile::BeginFrame
+
+Called at the top of DrawActiveFrame, the cvar is only sampled here
+so a frame is either fully profiled or not at all
+===============
+*/
+void idCGameProfile::BeginFrame(void) {
+    profileActive = cg_profile.integer != 0;
+
+    if(!profileActive) {
+        return;
+    }
+
+    ::memset(&profileCurrent, 0, sizeof(profileCurrent));
+    profileFrameStart = std::chrono::steady_clock::now();
+}
+
+/*
+===============
+idCGameProfile::EndFrame
+===============
+*/
+void idCGameProfile::EndFrame(void) {
+    if(!profileActive) {
+        return;
+    }
+
+    profileCurrent.clientFrame = cg.clientFrame;
+    profileCurrent.time = cg.time;
+    profileCurrent.totalUsec = (sint)
+                               std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::steady_clock::now() - profileFrameStart).count();
+
+    profileFrames[ profileFrameCount & (PROF_FRAMES - 1) ] = profileCurrent;
+    profileFrameCount++;
+    profileActive = false;
+}
+
+/*
+===============
+idCGameProfile::BeginStage
+===============
+*/
+void idCGameProfile::BeginStage(cgProfileStage_t stage) {
+    if(!profileActive) {
+        return;
+    }
+
+    ::memcpy(profileStageCounters[ stage ], cg_profileCounters,
+             sizeof(cg_profileCounters));
+    profileStageStart[ stage ] = std::chrono::steady_clock::now();
+}
+
+/*
+===============
+idCGameProfile::EndStage
+===============
+*/
+void idCGameProfile::EndStage(cgProfileStage_t stage) {
+    sint i;
+
+    if(!profileActive) {
+        return;
+    }
+
+    profileCurrent.usec[ stage ] += (sint)
+                                    std::chrono::duration_cast<std::chrono::microseconds>(
+                                        std::chrono::steady_clock::now() - profileStageStart[ stage ]).count();
+
+    for(i = 0; i < PROF_NUM_COUNTERS; i++) {
+        profileCurrent.counts[ stage ][ i ] += cg_profileCounters[ i ] -
+                                               profileStageCounters[ stage ][ i ];
+    }
+}
+
+/*
+===============
+idCGameProfile::DrawGraph
+
+Draws one stacked column per profiled frame to the left of rect
+===============
+*/
+void idCGameProfile::DrawGraph(rectDef_t *rect) {
+    sint a, i, stage, frames;
+    float32 ax, ay, aw, ah, vscale, y, v;
+    profileFrame_t *frame;
+    vec4_t background = { 0.0f, 0.0f, 0.0f, 0.25f };
+
+    if(!cg_profile.integer || !profileFrameCount) {
+        return;
+    }
+
+    ax = rect->x - rect->w;
+    ay = rect->y;
+    aw = rect->w;
+    ah = rect->h;
+
+    trap_R_SetColor(background);
+    idCGameDrawTools::DrawPic(ax, ay, aw, ah, cgs.media.whiteShader);
+
+    idCGameDrawTools::AdjustFrom640(&ax, &ay, &aw, &ah);
+
+    vscale = ah / PROF_GRAPH_USEC;
+    frames = MIN(profileFrameCount, PROF_FRAMES);
+
+    for(stage = 0; stage < PROF_NUM_STAGES; stage++) {
+        trap_R_SetColor(g_color_table[ ColorIndex(profileStageColors[ stage ]) ]);
+
+        for(a = 0; a < aw && a < frames; a++) {
+            frame = &profileFrames[ (profileFrameCount - 1 - a) & (PROF_FRAMES - 1) ];
+
+            // stack this stage on top of the ones before it
+            for(i = 0, y = 0.0f; i < stage; i++) {
+                y += frame->usec[ i ] * vscale;
+            }
+
+            v = frame->usec[ stage ] * vscale;
+
+            if(y >= ah || v <= 0.0f) {
+                continue;
+            }
+
+            if(y + v > ah) {
+                v = ah - y;
+            }
+
+            trap_R_DrawStretchPic(ax + aw - a, ay + ah - y - v, 1, v, 0, 0, 0, 0,
+                                  cgs.media.whiteShader);
+        }
+    }
+
+    trap_R_SetColor(nullptr);
+}
+
+/*
+===============
+idCGameProfile::Dump_f
+
+Writes the last N profiled frames to a CSV file
+===============
+*/
+void idCGameProfile::Dump_f(void) {
+    sint i, stage, counter, frames, first;
+    fileHandle_t f;
+    valueType filename[ MAX_QPATH ], line[ MAX_STRING_CHARS ];
+    profileFrame_t *frame;
+
+    frames = MIN(profileFrameCount, PROF_FRAMES);
+
+    if(trap_Argc() > 1) {
+        frames = MIN(frames, atoi(idCGameMain::Argv(1)));
+    }
+
+    if(frames <= 0) {
+        Printf("profileDump: no profiled frames, set cg_profile 1 first\n");
+        return;
+    }
+
+    if(trap_Argc() > 2) {
+        Q_strncpyz(filename, idCGameMain::Argv(2), sizeof(filename));
+    } else {
+        Q_strncpyz(filename, "profile.csv", sizeof(filename));
+    }
+
+    if(trap_FS_FOpenFile(filename, &f, FS_WRITE) < 0 || !f) {
+        Printf("profileDump: couldn't open %s\n", filename);
+        return;
+    }
+
+    Q_strncpyz(line, "frame,time,total_us", sizeof(line));
+
+    for(stage = 0; stage < PROF_NUM_STAGES; stage++) {
+        Q_strcat(line, sizeof(line), va(",%s_us", profileStageNames[ stage ]));
+
+        for(counter = 0; counter < PROF_NUM_COUNTERS; counter++) {
+            Q_strcat(line, sizeof(line), va(",%s_%s", profileStageNames[ stage ],
+                                            profileCounterNames[ counter ]));
+        }
+    }
+
+    Q_strcat(line, sizeof(line), "\n");
+    trap_FS_Write(line, strlen(line), f);
+
+    first = profileFrameCount - frames;
+
+    for(i = first; i < profileFrameCount; i++) {
+        frame = &profileFrames[ i & (PROF_FRAMES - 1) ];
+
+        Q_vsprintf_s(line, sizeof(line), sizeof(line), "%d,%d,%d", frame->clientFrame,
+                     frame->time, frame->totalUsec);
+
+        for(stage = 0; stage < PROF_NUM_STAGES; stage++) {
+            Q_strcat(line, sizeof(line), va(",%d", frame->usec[ stage ]));
+
+            for(counter = 0; counter < PROF_NUM_COUNTERS; counter++) {
+                Q_strcat(line, sizeof(line), va(",%d", frame->counts[ stage ][ counter ]));
+            }
+        }
+
+        Q_strcat(line, sizeof(line), "\n");
+        trap_FS_Write(line, strlen(line), f);
+    }
+
+    trap_FS_FCloseFile(f);
+
+    Printf("profileDump: wrote %d frames to %s\n", frames, filename);
+}
@@ -49,20 +49,18 @@ idCGameScanner::~idCGameScanner(void) {
 
 /*
 =============
-idCGameScanner::UpdateEntityPositions
+idCGameScanner::BeginEntityPositions
 
-Update this client's perception of entity positions
+Start updating this client's perception of entity positions, returns
+false if the scanner isn't due an update this frame
 =============
 */
 #define HUMAN_SCANNER_UPDATE_PERIOD 700
-void idCGameScanner::UpdateEntityPositions(void) {
-    centity_t *cent = nullptr;
-    sint i;
-
+bool idCGameScanner::BeginEntityPositions(void) {
     if(cg.predictedPlayerState.stats[ STAT_TEAM ] == TEAM_HUMANS) {
         if(entityPositions.lastUpdateTime + HUMAN_SCANNER_UPDATE_PERIOD >
                 cg.time) {
-            return;
+            return false;
         }
     }
 
@@ -75,45 +73,52 @@ void idCGameScanner::UpdateEntityPositions(void) {
     entityPositions.numAlienClients = 0;
     entityPositions.numHumanClients = 0;
 
-    for(i = 0; i < cg.snap->numEntities; i++) {
-        cent = &cg_entities[ cg.snap->entities[ i ].number ];
-
-        if(cent->currentState.eType == ET_BUILDABLE) {
-            // add to list of item positions (for creep)
-            if(cent->currentState.modelindex2 == TEAM_ALIENS) {
-                VectorCopy(cent->lerpOrigin,
-                           entityPositions.alienBuildablePos[ entityPositions.numAlienBuildables ]);
-                entityPositions.alienBuildableTimes[entityPositions.numAlienBuildables ] =
-                    cent->miscTime;
-
-                if(entityPositions.numAlienBuildables < MAX_GENTITIES) {
-                    entityPositions.numAlienBuildables++;
-                }
-            } else if(cent->currentState.modelindex2 == TEAM_HUMANS) {
-                VectorCopy(cent->lerpOrigin,
-                           entityPositions.humanBuildablePos[ entityPositions.numHumanBuildables ]);
-
-                if(entityPositions.numHumanBuildables < MAX_GENTITIES) {
-                    entityPositions.numHumanBuildables++;
-                }
+    return true;
+}
+
+/*
+=============
+idCGameScanner::AddEntityPosition
+
+Called for each entity in the snapshot after BeginEntityPositions
+=============
+*/
+void idCGameScanner::AddEntityPosition(centity_t *cent) {
+    if(cent->currentState.eType == ET_BUILDABLE) {
+        // add to list of item positions (for creep)
+        if(cent->currentState.modelindex2 == TEAM_ALIENS) {
+            VectorCopy(cent->lerpOrigin,
+                       entityPositions.alienBuildablePos[ entityPositions.numAlienBuildables ]);
+            entityPositions.alienBuildableTimes[entityPositions.numAlienBuildables ] =
+                cent->miscTime;
+
+            if(entityPositions.numAlienBuildables < MAX_GENTITIES) {
+                entityPositions.numAlienBuildables++;
+            }
+        } else if(cent->currentState.modelindex2 == TEAM_HUMANS) {
+            VectorCopy(cent->lerpOrigin,
+                       entityPositions.humanBuildablePos[ entityPositions.numHumanBuildables ]);
+
+            if(entityPositions.numHumanBuildables < MAX_GENTITIES) {
+                entityPositions.numHumanBuildables++;
+            }
+        }
+    } else if(cent->currentState.eType == ET_PLAYER) {
+        sint team = cent->currentState.misc & 0x00FF;
+
+        if(team == TEAM_ALIENS) {
+            VectorCopy(cent->lerpOrigin,
+                       entityPositions.alienClientPos[ entityPositions.numAlienClients ]);
+
+            if(entityPositions.numAlienClients < MAX_CLIENTS) {
+                entityPositions.numAlienClients++;
             }
-        } else if(cent->currentState.eType == ET_PLAYER) {
-            sint team = cent->currentState.misc & 0x00FF;
-
-            if(team == TEAM_ALIENS) {
-                VectorCopy(cent->lerpOrigin,
-                           entityPositions.alienClientPos[ entityPositions.numAlienClients ]);
-
-                if(entityPositions.numAlienClients < MAX_CLIENTS) {
-                    entityPositions.numAlienClients++;
-                }
-            } else if(team == TEAM_HUMANS) {
-                VectorCopy(cent->lerpOrigin,
-                           entityPositions.humanClientPos[ entityPositions.numHumanClients ]);
-
-                if(entityPositions.numHumanClients < MAX_CLIENTS) {
-                    entityPositions.numHumanClients++;
-                }
+        } else if(team == TEAM_HUMANS) {
+            VectorCopy(cent->lerpOrigin,
+                       entityPositions.humanClientPos[ entityPositions.numHumanClients ]);
+
+            if(entityPositions.numHumanClients < MAX_CLIENTS) {
+                entityPositions.numHumanClients++;
             }
         }
     }
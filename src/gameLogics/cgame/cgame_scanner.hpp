@@ -36,7 +36,8 @@ public:
     idCGameScanner();
     ~idCGameScanner();
 
-    static void UpdateEntityPositions(void);
+    static bool BeginEntityPositions(void);
+    static void AddEntityPosition(centity_t *cent);
     static void DrawBlips(rectDef_t *rect, vec3_t origin, vec4_t colour);
     static void DrawDir(rectDef_t *rect, vec3_t origin, vec4_t colour);
     static void AlienSense(rectDef_t *rect);
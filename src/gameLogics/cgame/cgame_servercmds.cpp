@@ -134,14 +134,14 @@ and whenever the server updates any serverinfo flagged cvars
 ================
 */
 void idCGameServerCmds::ParseServerinfo(void) {
-    pointer info;
-    valueType *mapname;
-
-    info = idCGameMain::ConfigString(CS_SERVERINFO);
-    cgs.timelimit = atoi(Info_ValueForKey(info, "timelimit"));
-    cgs.maxclients = atoi(Info_ValueForKey(info, "sv_maxclients"));
-    cgs.markDeconstruct = atoi(Info_ValueForKey(info, "g_markDeconstruct"));
-    mapname = Info_ValueForKey(info, "mapname");
+    infoView_t info;
+    valueType mapname[ MAX_QPATH ];
+
+    Info_ParseView(&info, idCGameMain::ConfigString(CS_SERVERINFO));
+    cgs.timelimit = Info_ViewInt(&info, "timelimit");
+    cgs.maxclients = Info_ViewInt(&info, "sv_maxclients");
+    cgs.markDeconstruct = Info_ViewInt(&info, "g_markDeconstruct");
+    Info_ViewString(&info, "mapname", mapname, sizeof(mapname));
     Q_vsprintf_s(cgs.mapname, sizeof(cgs.mapname), sizeof(cgs.mapname),
                  "maps/%s.bsp", mapname);
 }
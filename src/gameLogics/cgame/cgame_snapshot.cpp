@@ -109,6 +109,7 @@ void idCGameSnapshot::SetInitialSnapshot(snapshot_t *snap) {
     entityState_t *state;
 
     cg.snap = snap;
+    cg.pvsChanged = true;
 
     bggame->PlayerStateToEntityState(&snap->ps,
                                      &cg_entities[ snap->ps.clientNum ].currentState, false);
@@ -177,6 +178,7 @@ void idCGameSnapshot::TransitionSnapshot(void) {
     // move nextSnap to snap and do the transitions
     oldFrame = cg.snap;
     cg.snap = cg.nextSnap;
+    cg.pvsChanged = true;
 
     bggame->PlayerStateToEntityState(&cg.snap->ps,
                                      &cg_entities[ cg.snap->ps.clientNum ].currentState, false);
@@ -34,6 +34,20 @@ static baseTrailSystem_t baseTrailSystems[ MAX_BASETRAIL_SYSTEMS ];
 static baseTrailBeam_t baseTrailBeams[ MAX_BASETRAIL_BEAMS ];
 static sint numBaseTrailSystems = 0;
 static sint numBaseTrailBeams = 0;
+static nameIndex_t baseTrailSystemIndex;
+
+static pointer BaseTrailSystemName(sint i) {
+    return baseTrailSystems[ i ].name;
+}
+
+#define TRAIL_SCRIPT_TEXT 32000
+
+static scriptText_t trailScripts[ MAX_TRAIL_FILES ];
+static sint numTrailScripts;
+static sint trailSourceSize;
+static uint32 trailSourceHash;
+static bool trailsCached;
+static sint trailLoadStart;
 
 static trailSystem_t trailSystems[ MAX_TRAIL_SYSTEMS ];
 static trailBeam_t trailBeams[ MAX_TRAIL_BEAMS ];
@@ -276,6 +290,8 @@ trailBeamNode_t *idCGameTrails::AllocateBeamNode(trailBeam_t *tb) {
     sint i;
     trailBeamNode_t *tbn;
 
+    cg_profileCounters[ PROF_COUNT_ALLOCS ]++;
+
     for(i = 0; i < MAX_TRAIL_BEAM_NODES; i++) {
         tbn = &tb->nodePool[ i ];
 
@@ -1018,35 +1034,15 @@ bool idCGameTrails::ParseTrailSystem(baseTrailSystem_t *bts,
 ===============
 idCGameTrails::ParseTrailFile
 
-Load the trail systems from a trail file
+Load the trail systems from the text of a trail file, runs on a loader
+thread
 ===============
 */
-bool idCGameTrails::ParseTrailFile(pointer fileName) {
+bool idCGameTrails::ParseTrailFile(pointer fileName, valueType *text) {
     valueType *text_p;
-    sint i, len;
     valueType *token;
-    valueType text[ 32000 ];
     valueType tsName[ MAX_QPATH ];
     bool tsNameSet = false;
-    fileHandle_t f;
-
-    // load the file
-    len = trap_FS_FOpenFile(fileName, &f, FS_READ);
-
-    if(len <= 0) {
-        return false;
-    }
-
-    if(len == 0 || len >= sizeof(text) - 1) {
-        trap_FS_FCloseFile(f);
-        Printf(S_COLOR_RED "ERROR: trail file %s is %s\n", fileName,
-               len == 0 ? "empty" : "too long");
-        return false;
-    }
-
-    trap_FS_Read(text, len, f);
-    text[ len ] = 0;
-    trap_FS_FCloseFile(f);
 
     // parse the text
     text_p = text;
@@ -1062,11 +1058,10 @@ bool idCGameTrails::ParseTrailFile(pointer fileName) {
         if(!Q_stricmp(token, "{")) {
             if(tsNameSet) {
                 //check for name space clashes
-                for(i = 0; i < numBaseTrailSystems; i++) {
-                    if(!Q_stricmp(baseTrailSystems[ i ].name, tsName)) {
-                        Printf(S_COLOR_RED "ERROR: a trail system is already named %s\n", tsName);
-                        return false;
-                    }
+                if(Com_NameIndexFind(&baseTrailSystemIndex, numBaseTrailSystems,
+                                     BaseTrailSystemName, tsName) >= 0) {
+                    Printf(S_COLOR_RED "ERROR: a trail system is already named %s\n", tsName);
+                    return false;
                 }
 
                 Q_strncpyz(baseTrailSystems[ numBaseTrailSystems ].name, tsName,
@@ -1111,20 +1106,142 @@ bool idCGameTrails::ParseTrailFile(pointer fileName) {
 
 /*
 ===============
-idCGameTrails::LoadTrailSystems
+idCGameTrails::TrailCacheLayout
+
+Changes whenever one of the cached structures does
+===============
+*/
+sint idCGameTrails::TrailCacheLayout(void) {
+    sint sizes[ 3 ];
+
+    sizes[ 0 ] = sizeof(baseTrailSystem_t);
+    sizes[ 1 ] = sizeof(baseTrailBeam_t);
+    sizes[ 2 ] = sizeof(void *);
+
+    return (sint)bggame->CacheHash(sizes, sizeof(sizes), 0);
+}
+
+/*
+===============
+idCGameTrails::ReadTrailCache
+
+Restore the parsed templates from the cache, beam pointers are stored
+as index + 1
+===============
+*/
+bool idCGameTrails::ReadTrailCache(sint sourceSize, uint32 sourceHash) {
+    sint i, j, index, counts[ 2 ], dataSize;
+    fileHandle_t f;
+
+    f = bggame->CacheOpenRead("trails", TrailCacheLayout(), sourceSize,
+                              sourceHash, &dataSize);
+
+    if(!f) {
+        return false;
+    }
+
+    trap_FS_Read(counts, sizeof(counts), f);
+
+    if(counts[ 0 ] < 0 || counts[ 0 ] > MAX_BASETRAIL_SYSTEMS ||
+            counts[ 1 ] < 0 || counts[ 1 ] > MAX_BASETRAIL_BEAMS ||
+            dataSize != (sint)(sizeof(counts) +
+                               counts[ 0 ] * sizeof(baseTrailSystem_t) +
+                               counts[ 1 ] * sizeof(baseTrailBeam_t))) {
+        trap_FS_FCloseFile(f);
+        return false;
+    }
+
+    numBaseTrailSystems = counts[ 0 ];
+    numBaseTrailBeams = counts[ 1 ];
+    Com_NameIndexClear(&baseTrailSystemIndex);
+
+    trap_FS_Read(baseTrailSystems,
+                 numBaseTrailSystems * sizeof(baseTrailSystem_t), f);
+    trap_FS_Read(baseTrailBeams, numBaseTrailBeams * sizeof(baseTrailBeam_t),
+                 f);
+    trap_FS_FCloseFile(f);
+
+    for(i = 0; i < numBaseTrailSystems; i++) {
+        baseTrailSystem_t *bts = &baseTrailSystems[ i ];
+
+        for(j = 0; j < MAX_BEAMS_PER_SYSTEM; j++) {
+            index = (sint)(intptr_t)bts->beams[ j ];
+
+            if(index > 0 && index <= numBaseTrailBeams) {
+                bts->beams[ j ] = &baseTrailBeams[ index - 1 ];
+            } else {
+                bts->beams[ j ] = nullptr;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+===============
+idCGameTrails::WriteTrailCache
+===============
+*/
+void idCGameTrails::WriteTrailCache(sint sourceSize, uint32 sourceHash) {
+    sint i, j, counts[ 2 ], dataSize;
+    fileHandle_t f;
+
+    counts[ 0 ] = numBaseTrailSystems;
+    counts[ 1 ] = numBaseTrailBeams;
+
+    dataSize = sizeof(counts) +
+               numBaseTrailSystems * sizeof(baseTrailSystem_t) +
+               numBaseTrailBeams * sizeof(baseTrailBeam_t);
+
+    f = bggame->CacheOpenWrite("trails", TrailCacheLayout(), sourceSize,
+                               sourceHash, dataSize);
+
+    if(!f) {
+        return;
+    }
+
+    trap_FS_Write(counts, sizeof(counts), f);
+
+    for(i = 0; i < numBaseTrailSystems; i++) {
+        baseTrailSystem_t bts = baseTrailSystems[ i ];
+
+        for(j = 0; j < MAX_BEAMS_PER_SYSTEM; j++) {
+            if(bts.beams[ j ]) {
+                bts.beams[ j ] = (baseTrailBeam_t *)(intptr_t)
+                                 (bts.beams[ j ] - baseTrailBeams + 1);
+            }
+        }
+
+        bts.registered = false;
+        trap_FS_Write(&bts, sizeof(bts), f);
+    }
+
+    trap_FS_Write(baseTrailBeams, numBaseTrailBeams * sizeof(baseTrailBeam_t),
+                  f);
+    trap_FS_FCloseFile(f);
+}
+
+/*
+===============
+idCGameTrails::BeginLoadTrailSystems
 
-Load trail system templates
+Read the .trail files and queue them for parsing unless the cache is
+still valid for them
 ===============
 */
-void idCGameTrails::LoadTrailSystems(void) {
-    sint i, numFiles, fileLen;
+void idCGameTrails::BeginLoadTrailSystems(void) {
+    sint i, numFiles, fileLen, len;
     valueType fileList[ MAX_TRAIL_FILES * MAX_QPATH ];
-    valueType fileName[ MAX_QPATH ];
-    valueType *filePtr;
+    valueType *filePtr, *text;
+    scriptText_t *script;
+
+    trailLoadStart = trap_Milliseconds();
 
     //clear out the old
     numBaseTrailSystems = 0;
     numBaseTrailBeams = 0;
+    Com_NameIndexClear(&baseTrailSystemIndex);
 
     for(i = 0; i < MAX_BASETRAIL_SYSTEMS; i++) {
         baseTrailSystem_t  *bts = &baseTrailSystems[ i ];
@@ -1141,15 +1258,78 @@ void idCGameTrails::LoadTrailSystems(void) {
                                    MAX_TRAIL_FILES * MAX_QPATH);
     filePtr = fileList;
 
+    numTrailScripts = 0;
+    trailSourceSize = 0;
+    trailSourceHash = 0;
+
     for(i = 0; i < numFiles; i++, filePtr += fileLen + 1) {
         fileLen = strlen(filePtr);
-        strcpy(fileName, "scripts/");
-        strcat(fileName, filePtr);
-        //Printf( "...loading '%s'\n", fileName );
-        ParseTrailFile(fileName);
+        script = &trailScripts[ numTrailScripts ];
+
+        Q_vsprintf_s(script->name, sizeof(script->name), sizeof(script->name),
+                     "scripts/%s", filePtr);
+
+        text = idCGameLoader::ReadScript(script->name, TRAIL_SCRIPT_TEXT);
+
+        if(!text) {
+            continue;
+        }
+
+        script->text = text;
+        numTrailScripts++;
+
+        //key the cache on the name, size and contents of every file
+        len = strlen(text);
+        trailSourceSize += len;
+        trailSourceHash = bggame->CacheHash(filePtr, fileLen, trailSourceHash);
+        trailSourceHash = bggame->CacheHash(text, len, trailSourceHash);
+    }
+
+    trailsCached = ReadTrailCache(trailSourceSize, trailSourceHash);
+
+    if(!trailsCached) {
+        idCGameLoader::AddWork(numTrailScripts);
+        idCGameLoader::Submit(ParseTrailFiles, nullptr);
     }
 }
 
+/*
+===============
+idCGameTrails::ParseTrailFiles
+
+Loader job, files are parsed in order so handles don't depend on timing
+===============
+*/
+void idCGameTrails::ParseTrailFiles(void *data) {
+    sint i;
+
+    for(i = 0; i < numTrailScripts; i++) {
+        //Printf( "...loading '%s'\n", trailScripts[ i ].name );
+        ParseTrailFile(trailScripts[ i ].name, trailScripts[ i ].text);
+        idCGameLoader::WorkerProgress(1);
+    }
+}
+
+/*
+===============
+idCGameTrails::FinishLoadTrailSystems
+
+Called once the loader job is done
+===============
+*/
+void idCGameTrails::FinishLoadTrailSystems(void) {
+    if(trailsCached) {
+        Printf("Loaded %d trail systems from cache in %d msec\n",
+               numBaseTrailSystems, trap_Milliseconds() - trailLoadStart);
+        return;
+    }
+
+    WriteTrailCache(trailSourceSize, trailSourceHash);
+
+    Printf("Parsed %d trail systems in %d msec\n", numBaseTrailSystems,
+           trap_Milliseconds() - trailLoadStart);
+}
+
 /*
 ===============
 idCGameTrails::RegisterTrailSystem
@@ -1162,30 +1342,31 @@ qhandle_t idCGameTrails::RegisterTrailSystem(valueType *name) {
     baseTrailSystem_t *bts;
     baseTrailBeam_t *btb;
 
-    for(i = 0; i < MAX_BASETRAIL_SYSTEMS; i++) {
+    i = Com_NameIndexFind(&baseTrailSystemIndex, numBaseTrailSystems,
+                          BaseTrailSystemName, name);
+
+    if(i >= 0) {
         bts = &baseTrailSystems[ i ];
 
-        if(!Q_stricmp(bts->name, name)) {
-            //already registered
-            if(bts->registered) {
-                return i + 1;
-            }
+        //already registered
+        if(bts->registered) {
+            return i + 1;
+        }
 
-            for(j = 0; j < bts->numBeams; j++) {
-                btb = bts->beams[ j ];
+        for(j = 0; j < bts->numBeams; j++) {
+            btb = bts->beams[ j ];
 
-                btb->shader = trap_R_RegisterShader(btb->shaderName);
-            }
+            btb->shader = trap_R_RegisterShader(btb->shaderName);
+        }
 
-            if(cg_debugTrails.integer >= 1) {
-                Printf("Registered trail system %s\n", name);
-            }
+        if(cg_debugTrails.integer >= 1) {
+            Printf("Registered trail system %s\n", name);
+        }
 
-            bts->registered = true;
+        bts->registered = true;
 
-            //avoid returning 0
-            return i + 1;
-        }
+        //avoid returning 0
+        return i + 1;
     }
 
     Printf(S_COLOR_RED "ERROR: failed to register trail system %s\n", name);
@@ -1206,6 +1387,8 @@ trailBeam_t *idCGameTrails::SpawnNewTrailBeam(baseTrailBeam_t *btb,
     trailBeam_t *tb = nullptr;
     trailSystem_t *ts = parent;
 
+    cg_profileCounters[ PROF_COUNT_ALLOCS ]++;
+
     for(i = 0; i < MAX_TRAIL_BEAMS; i++) {
         tb = &trailBeams[ i ];
 
@@ -1242,6 +1425,8 @@ trailSystem_t *idCGameTrails::SpawnNewTrailSystem(qhandle_t psHandle) {
     trailSystem_t *ts = nullptr;
     baseTrailSystem_t *bts = &baseTrailSystems[ psHandle - 1 ];
 
+    cg_profileCounters[ PROF_COUNT_ALLOCS ]++;
+
     if(!bts->registered) {
         Printf(S_COLOR_RED "ERROR: a trail system has not been registered yet\n");
         return nullptr;
@@ -52,8 +52,13 @@ public:
     static void InitialiseBaseTrailBeam(baseTrailBeam_t *btb);
     static bool ParseTrailSystem(baseTrailSystem_t *bts, valueType **text_p,
                                  pointer name);
-    static bool ParseTrailFile(pointer fileName);
-    static void LoadTrailSystems(void);
+    static bool ParseTrailFile(pointer fileName, valueType *text);
+    static sint TrailCacheLayout(void);
+    static bool ReadTrailCache(sint sourceSize, uint32 sourceHash);
+    static void WriteTrailCache(sint sourceSize, uint32 sourceHash);
+    static void BeginLoadTrailSystems(void);
+    static void ParseTrailFiles(void *data);
+    static void FinishLoadTrailSystems(void);
     static qhandle_t RegisterTrailSystem(valueType *name);
     static trailBeam_t *SpawnNewTrailBeam(baseTrailBeam_t *btb,
                                           trailSystem_t *parent);
@@ -1440,11 +1440,22 @@ Generates and draws a game scene and status information at the given time.
 */
 void idCGameLocal::DrawActiveFrame(sint serverTime,
                                    stereoFrame_t stereoView, bool demoPlayback) {
-    sint inwater;
+    sint inwater, realTime;
 
     cg.time = serverTime;
     cg.demoPlayback = demoPlayback;
 
+    // the shared menu code times blinking, scrolling and its per frame
+    // caches off the display context
+    realTime = trap_Milliseconds();
+    cgDC.frameTime = realTime - cgDC.realTime;
+    cgDC.realTime = realTime;
+
+    // last frame's scratch strings are done with
+    Com_ScratchReset();
+
+    idCGameProfile::BeginFrame();
+
     // update cvars
     idCGameMain::UpdateCvars();
 
@@ -1462,8 +1473,12 @@ void idCGameLocal::DrawActiveFrame(sint serverTime,
     // clear all the render lists
     trap_R_ClearScene();
 
+    cg.entityTraces = cg.entityTracesAvoided = 0;
+
     // set up cg.snap and possibly cg.nextSnap
+    idCGameProfile::BeginStage(PROF_SNAPSHOTS);
     idCGameSnapshot::ProcessSnapshots();
+    idCGameProfile::EndStage(PROF_SNAPSHOTS);
 
     // if we haven't received any snapshots yet, all
     // we can draw is the information screen
@@ -1480,7 +1495,9 @@ void idCGameLocal::DrawActiveFrame(sint serverTime,
     cg.clientFrame++;
 
     // update cg.predictedPlayerState
+    idCGameProfile::BeginStage(PROF_PREDICT);
     idCGamePredict::PredictPlayerState();
+    idCGameProfile::EndStage(PROF_PREDICT);
 
     // cg.refdef is 100% inisialized here -> set stereo flag
     //cg.refdef.stereoFrame = stereoView;
@@ -1495,16 +1512,26 @@ void idCGameLocal::DrawActiveFrame(sint serverTime,
 
     // build the render lists
     if(!cg.hyperspace) {
+        idCGameProfile::BeginStage(PROF_ENTITIES);
         idCGameEnts::AddPacketEntities();  // after calcViewValues, so predicted player state is correct
+        idCGameProfile::EndStage(PROF_ENTITIES);
+
+        idCGameProfile::BeginStage(PROF_MARKS);
         idCGameMarks::AddMarks();
+        idCGameProfile::EndStage(PROF_MARKS);
     }
 
     idCGameWeapons::AddViewWeapon(&cg.predictedPlayerState);
 
     //after CG_AddViewWeapon
     if(!cg.hyperspace) {
+        idCGameProfile::BeginStage(PROF_PARTICLES);
         idCGameParticles::AddParticles();
+        idCGameProfile::EndStage(PROF_PARTICLES);
+
+        idCGameProfile::BeginStage(PROF_TRAILS);
         idCGameTrails::AddTrails();
+        idCGameProfile::EndStage(PROF_TRAILS);
     }
 
     // add buffered sounds
@@ -1564,10 +1591,15 @@ void idCGameLocal::DrawActiveFrame(sint serverTime,
     }
 
     // actually issue the rendering calls
+    idCGameProfile::BeginStage(PROF_DRAW);
     idCGameDraw::DrawActive(stereoView);
+    idCGameProfile::EndStage(PROF_DRAW);
+
+    idCGameProfile::EndFrame();
 
     if(cg_stats.integer) {
-        Printf("cg.clientFrame:%i\n", cg.clientFrame);
+        Printf("cg.clientFrame:%i entity traces:%i avoided:%i\n",
+               cg.clientFrame, cg.entityTraces, cg.entityTracesAvoided);
     }
 }
 
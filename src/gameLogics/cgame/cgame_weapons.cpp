@@ -98,6 +98,7 @@ void idCGameWeapons::InitUpgrades(void) {
 
     for(i = UP_NONE + 1; i < UP_NUM_UPGRADES; i++) {
         RegisterUpgrade(i);
+        idCGameLoader::CompleteWork(1);
     }
 }
 
@@ -832,6 +833,7 @@ void idCGameWeapons::InitWeapons(void) {
 
     for(i = WP_NONE + 1; i < WP_NUM_WEAPONS; i++) {
         RegisterWeapon(i);
+        idCGameLoader::CompleteWork(1);
     }
 
     cgs.media.level2ZapTS =
@@ -337,6 +337,298 @@ void idSGameActive::ClientImpacts(gentity_t *ent, pmove_t *pm) {
     }
 }
 
+#define TRIGGER_CELL_SIZE 256
+#define TRIGGER_GRID_DIM 32
+#define TRIGGER_MAX_CELLS 16
+
+// static triggers are bucketed into a 2D grid when the map is loaded, with
+// each cell listing the triggers overlapping it. Triggers that belong to
+// movers, cover too many cells or are spawned later live in a short list
+// that is scanned on every lookup
+static sint triggerCellStart[ TRIGGER_GRID_DIM * TRIGGER_GRID_DIM + 1 ];
+static sint triggerCells[ TRIGGER_MAX_CELLS * MAX_GENTITIES ];
+static sint dynamicTriggers[ MAX_GENTITIES ];
+static sint numDynamicTriggers;
+static vec2_t triggerGridOrigin;
+static float32 triggerCellSize;
+static sint triggerGridDim[ 2 ];
+static uint32 triggerStamp[ MAX_GENTITIES ];
+static uint32 triggerQuery;
+
+/*
+============
+idSGameActive::TriggerCellRange
+
+Cells of the trigger grid overlapped by a box, clamped to the grid. Returns
+false if the box lies outside the grid
+============
+*/
+bool idSGameActive::TriggerCellRange(const vec3_t mins, const vec3_t maxs,
+                                     sint *cellMins, sint *cellMaxs) {
+    sint i;
+
+    for(i = 0; i < 2; i++) {
+        cellMins[ i ] = static_cast<sint>(floorf((mins[ i ] -
+                                          triggerGridOrigin[ i ]) / triggerCellSize));
+        cellMaxs[ i ] = static_cast<sint>(floorf((maxs[ i ] -
+                                          triggerGridOrigin[ i ]) / triggerCellSize));
+
+        if(cellMaxs[ i ] < 0 || cellMins[ i ] >= triggerGridDim[ i ]) {
+            return false;
+        }
+
+        cellMins[ i ] = Q_max(cellMins[ i ], 0);
+        cellMaxs[ i ] = Q_min(cellMaxs[ i ], triggerGridDim[ i ] - 1);
+    }
+
+    return true;
+}
+
+/*
+============
+idSGameActive::TriggerBounds
+
+Bounds of a trigger, whether it is linked yet or not
+============
+*/
+void idSGameActive::TriggerBounds(gentity_t *ent, vec3_t mins,
+                                  vec3_t maxs) {
+    if(ent->r.linked) {
+        VectorCopy(ent->r.absmin, mins);
+        VectorCopy(ent->r.absmax, maxs);
+    } else {
+        // same one unit pad as trap_LinkEntity
+        VectorAdd(ent->r.currentOrigin, ent->r.mins, mins);
+        VectorAdd(ent->r.currentOrigin, ent->r.maxs, maxs);
+        mins[ 0 ] -= 1;
+        mins[ 1 ] -= 1;
+        mins[ 2 ] -= 1;
+        maxs[ 0 ] += 1;
+        maxs[ 1 ] += 1;
+        maxs[ 2 ] += 1;
+    }
+}
+
+/*
+============
+idSGameActive::BuildTriggerGrid
+
+Buckets the triggers spawned with the map, which never move. Called once
+the map entities are spawned
+============
+*/
+void idSGameActive::BuildTriggerGrid(void) {
+    sint i, x, y, cell, numStatic, cellMins[ 2 ], cellMaxs[ 2 ];
+    sint staticTriggers[ MAX_GENTITIES ];
+    vec3_t mins, maxs, gridMins, gridMaxs;
+    float32 extent;
+    gentity_t *ent;
+
+    numStatic = 0;
+    numDynamicTriggers = 0;
+    ClearBounds(gridMins, gridMaxs);
+
+    for(i = MAX_CLIENTS, ent = g_entities + i; i < level.num_entities;
+            i++, ent++) {
+        if(!ent->inuse || !(ent->r.contents & CONTENTS_TRIGGER)) {
+            continue;
+        }
+
+        // door and plat triggers belong to their movers
+        if(ent->parent) {
+            dynamicTriggers[ numDynamicTriggers++ ] = i;
+            continue;
+        }
+
+        TriggerBounds(ent, mins, maxs);
+        AddPointToBounds(mins, gridMins, gridMaxs);
+        AddPointToBounds(maxs, gridMins, gridMaxs);
+        staticTriggers[ numStatic++ ] = i;
+    }
+
+    triggerCellSize = TRIGGER_CELL_SIZE;
+
+    for(i = 0; i < 2; i++) {
+        extent = numStatic ? gridMaxs[ i ] - gridMins[ i ] : 0.0f;
+
+        if(extent > triggerCellSize * TRIGGER_GRID_DIM) {
+            triggerCellSize = ceilf(extent / TRIGGER_GRID_DIM);
+        }
+    }
+
+    for(i = 0; i < 2; i++) {
+        triggerGridOrigin[ i ] = numStatic ? gridMins[ i ] : 0.0f;
+        extent = numStatic ? gridMaxs[ i ] - gridMins[ i ] : 0.0f;
+        triggerGridDim[ i ] = Q_min(static_cast<sint>(extent / triggerCellSize) + 1,
+                                    TRIGGER_GRID_DIM);
+    }
+
+    // count the triggers in each cell, moving the large ones to the list
+    ::memset(triggerCellStart, 0, sizeof(triggerCellStart));
+
+    for(i = 0; i < numStatic; i++) {
+        ent = &g_entities[ staticTriggers[ i ] ];
+        TriggerBounds(ent, mins, maxs);
+        TriggerCellRange(mins, maxs, cellMins, cellMaxs);
+
+        if((cellMaxs[ 0 ] - cellMins[ 0 ] + 1) * (cellMaxs[ 1 ] - cellMins[ 1 ] + 1) >
+                TRIGGER_MAX_CELLS) {
+            dynamicTriggers[ numDynamicTriggers++ ] = staticTriggers[ i ];
+            staticTriggers[ i ] = -1;
+            continue;
+        }
+
+        for(y = cellMins[ 1 ]; y <= cellMaxs[ 1 ]; y++) {
+            for(x = cellMins[ 0 ]; x <= cellMaxs[ 0 ]; x++) {
+                triggerCellStart[ y * triggerGridDim[ 0 ] + x + 1 ]++;
+            }
+        }
+    }
+
+    for(i = 1; i <= triggerGridDim[ 0 ] * triggerGridDim[ 1 ]; i++) {
+        triggerCellStart[ i ] += triggerCellStart[ i - 1 ];
+    }
+
+    // then fill them, advancing each cell's start as its write position and
+    // shifting the starts back afterwards
+    for(i = 0; i < numStatic; i++) {
+        if(staticTriggers[ i ] < 0) {
+            continue;
+        }
+
+        ent = &g_entities[ staticTriggers[ i ] ];
+        TriggerBounds(ent, mins, maxs);
+        TriggerCellRange(mins, maxs, cellMins, cellMaxs);
+
+        for(y = cellMins[ 1 ]; y <= cellMaxs[ 1 ]; y++) {
+            for(x = cellMins[ 0 ]; x <= cellMaxs[ 0 ]; x++) {
+                cell = y * triggerGridDim[ 0 ] + x;
+                triggerCells[ triggerCellStart[ cell ]++ ] = staticTriggers[ i ];
+            }
+        }
+    }
+
+    for(i = triggerGridDim[ 0 ] * triggerGridDim[ 1 ]; i > 0; i--) {
+        triggerCellStart[ i ] = triggerCellStart[ i - 1 ];
+    }
+
+    triggerCellStart[ 0 ] = 0;
+
+    level.triggerGridBuilt = true;
+}
+
+/*
+============
+idSGameActive::AddTrigger
+
+Puts a trigger created after the map was loaded, such as a mover's, in the
+dynamic list
+============
+*/
+void idSGameActive::AddTrigger(gentity_t *ent) {
+    sint i, num = ent - g_entities;
+
+    if(!level.triggerGridBuilt) {
+        return;
+    }
+
+    for(i = 0; i < numDynamicTriggers; i++) {
+        if(dynamicTriggers[ i ] == num) {
+            return;
+        }
+    }
+
+    if(numDynamicTriggers < MAX_GENTITIES) {
+        dynamicTriggers[ numDynamicTriggers++ ] = num;
+    }
+}
+
+/*
+============
+idSGameActive::TriggerInBox
+
+Checks a trigger found by TriggersInBox, once per lookup
+============
+*/
+bool idSGameActive::TriggerInBox(sint num, const vec3_t mins,
+                                 const vec3_t maxs) {
+    gentity_t *hit = &g_entities[ num ];
+
+    if(triggerStamp[ num ] == triggerQuery) {
+        return false;
+    }
+
+    triggerStamp[ num ] = triggerQuery;
+
+    if(!hit->inuse || !hit->r.linked || !(hit->r.contents & CONTENTS_TRIGGER)) {
+        return false;
+    }
+
+    if(hit->r.absmin[ 0 ] > maxs[ 0 ] || hit->r.absmax[ 0 ] < mins[ 0 ] ||
+            hit->r.absmin[ 1 ] > maxs[ 1 ] || hit->r.absmax[ 1 ] < mins[ 1 ] ||
+            hit->r.absmin[ 2 ] > maxs[ 2 ] || hit->r.absmax[ 2 ] < mins[ 2 ]) {
+        return false;
+    }
+
+    return true;
+}
+
+/*
+============
+idSGameActive::TriggersInBox
+
+trap_EntitiesInBox limited to linked triggers
+============
+*/
+sint idSGameActive::TriggersInBox(const vec3_t mins, const vec3_t maxs,
+                                  sint *list, sint maxcount) {
+    sint i, x, y, cell, num, cellMins[ 2 ], cellMaxs[ 2 ];
+    gentity_t *hit;
+
+    if(!level.triggerGridBuilt) {
+        BuildTriggerGrid();
+    }
+
+    // a fresh stamp for each lookup, clearing them when it wraps
+    if(++triggerQuery == 0) {
+        ::memset(triggerStamp, 0, sizeof(triggerStamp));
+        triggerQuery = 1;
+    }
+
+    num = 0;
+
+    if(TriggerCellRange(mins, maxs, cellMins, cellMaxs)) {
+        for(y = cellMins[ 1 ]; y <= cellMaxs[ 1 ]; y++) {
+            for(x = cellMins[ 0 ]; x <= cellMaxs[ 0 ]; x++) {
+                cell = y * triggerGridDim[ 0 ] + x;
+
+                for(i = triggerCellStart[ cell ];
+                        i < triggerCellStart[ cell + 1 ] && num < maxcount; i++) {
+                    if(TriggerInBox(triggerCells[ i ], mins, maxs)) {
+                        list[ num++ ] = triggerCells[ i ];
+                    }
+                }
+            }
+        }
+    }
+
+    for(i = 0; i < numDynamicTriggers && num < maxcount; i++) {
+        hit = &g_entities[ dynamicTriggers[ i ] ];
+
+        // drop triggers that have been freed
+        if(!hit->inuse || !(hit->r.contents & CONTENTS_TRIGGER)) {
+            dynamicTriggers[ i-- ] = dynamicTriggers[ --numDynamicTriggers ];
+            continue;
+        }
+
+        if(TriggerInBox(dynamicTriggers[ i ], mins, maxs)) {
+            list[ num++ ] = dynamicTriggers[ i ];
+        }
+    }
+
+    return num;
+}
+
 /*
 ============
 idSGameActive::OtherTouchTriggers
@@ -356,7 +648,7 @@ void idSGameActive::OtherTouchTriggers(gentity_t *ent) {
     VectorSubtract(ent->r.currentOrigin, range, mins);
     VectorAdd(ent->r.currentOrigin, range, maxs);
 
-    num = trap_EntitiesInBox(mins, maxs, touch, MAX_GENTITIES);
+    num = TriggersInBox(mins, maxs, touch, MAX_GENTITIES);
 
     // can't use ent->absmin, because that has a one unit pad
     VectorAdd(ent->r.currentOrigin, ent->r.mins, mins);
@@ -423,7 +715,7 @@ void idSGameActive::TouchTriggers(gentity_t *ent) {
     VectorSubtract(mins, range, mins);
     VectorAdd(maxs, range, maxs);
 
-    num = trap_EntitiesInBox(mins, maxs, touch, MAX_GENTITIES);
+    num = TriggersInBox(mins, maxs, touch, MAX_GENTITIES);
 
     // can't use ent->absmin, because that has a one unit pad
     VectorAdd(ent->client->ps.origin, ent->r.mins, mins);
@@ -716,24 +1008,15 @@ void idSGameActive::ClientTimerActions(gentity_t *ent, sint msec) {
                 if((client->ps.stats[STAT_BUILDABLE] & ~SB_VALID_TOGGLEBIT) > BA_NONE) {
                     sint dist = bggame->Class((class_t)
                                               ent->client->ps.stats[STAT_CLASS])->buildDist;
-                    vec3_t dummy;
 
-                    if(idSGameBuildable::CanBuild(ent,
-                                                  (buildable_t)(client->ps.stats[STAT_BUILDABLE] & ~SB_VALID_TOGGLEBIT),
-                                                  dist, dummy) == IBE_NONE) {
+                    // ps.misc lists the buildables that building would remove
+                    if(idSGameBuildable::CanBuildPreview(ent,
+                                                         (buildable_t)(client->ps.stats[STAT_BUILDABLE] & ~SB_VALID_TOGGLEBIT),
+                                                         dist, client->ps.misc) == IBE_NONE) {
                         client->ps.stats[STAT_BUILDABLE] |= SB_VALID_TOGGLEBIT;
                     } else {
                         client->ps.stats[STAT_BUILDABLE] &= ~SB_VALID_TOGGLEBIT;
                     }
-
-                    // Let the client know which buildables will be removed by building
-                    for(i = 0; i < MAX_MISC; i++) {
-                        if(i < level.numBuildablesForRemoval) {
-                            client->ps.misc[i] = level.markedBuildables[i]->s.number;
-                        } else {
-                            client->ps.misc[i] = 0;
-                        }
-                    }
                 } else {
                     for(i = 0; i < MAX_MISC; i++) {
                         client->ps.misc[i] = 0;
@@ -1594,6 +1877,13 @@ void idSGameActive::ClientThink_real(gentity_t *ent) {
                            client->ps.stats[STAT_CLASS])->speed;
     }
 
+    if(client->ps.stats[ STAT_TEAM ] == TEAM_HUMANS &&
+            client->ps.groundEntityNum != ENTITYNUM_NONE &&
+            idSGameBuildable::CreepSlowsPlayer(ent)) {
+        client->ps.stats[ STAT_STATE ] |= SS_CREEPSLOWED;
+        client->lastCreepSlowTime = level.time;
+    }
+
     if(client->lastCreepSlowTime + CREEP_TIMEOUT < level.time) {
         client->ps.stats[STAT_STATE] &= ~SS_CREEPSLOWED;
     }
@@ -46,6 +46,14 @@ public:
     static void WorldEffects(gentity_t *ent);
     static void SendPendingPredictableEvents(playerState_t *ps);
     static void SpectatorClientEndFrame(gentity_t *ent);
+    static bool TriggerCellRange(const vec3_t mins, const vec3_t maxs,
+                                 sint *cellMins, sint *cellMaxs);
+    static void TriggerBounds(gentity_t *ent, vec3_t mins, vec3_t maxs);
+    static void BuildTriggerGrid(void);
+    static void AddTrigger(gentity_t *ent);
+    static bool TriggerInBox(sint num, const vec3_t mins, const vec3_t maxs);
+    static sint TriggersInBox(const vec3_t mins, const vec3_t maxs, sint *list,
+                              sint maxcount);
     static void TouchTriggers(gentity_t *ent);
     static void RunClient(gentity_t *ent);
     static void SetClientSound(gentity_t *ent);
@@ -43,6 +43,15 @@ idAdminLocal adminLocal;
 // big ugly global buffer for use with buffered printing of long outputs
 static valueType g_bfb[ 32000 ];
 
+// the admin config is saved through this, see AdminWriteConfig
+static valueType g_admin_writeBuffer[ 65536 ];
+static sint g_admin_writeLength;
+
+// changes are appended to the journal, see AdminFlushConfig
+static valueType g_admin_journalBuffer[ 16384 ];
+static sint g_admin_journalLength;
+static bool g_admin_journalUsed;    // the journal has records g_admin lacks
+
 // note: list ordered alphabetically
 g_admin_cmd_t g_admin_cmds[ ] = {
     {
@@ -435,17 +444,11 @@ idAdminLocal::SetClientSound
 ===============
 */
 void idAdminLocal::AdminWriteConfigString(valueType *s, fileHandle_t f) {
-    valueType buf[ MAX_STRING_CHARS ];
-
-    buf[ 0 ] = '\0';
-
     if(s[ 0 ]) {
-        //Q_strcat(buf, sizeof(buf), s);
-        Q_strncpyz(buf, s, sizeof(buf));
-        trap_FS_Write(buf, strlen(buf), f);
+        AdminWriteConfigRaw(s, strlen(s), f);
     }
 
-    trap_FS_Write("\n", 1, f);
+    AdminWriteConfigRaw("\n", 1, f);
 }
 
 /*
@@ -456,15 +459,142 @@ idAdminLocal::AdminWriteConfigInt
 void idAdminLocal::AdminWriteConfigInt(sint v, fileHandle_t f) {
     valueType buf[ 32 ];
 
-    Q_vsprintf_s(buf, sizeof(buf), sizeof(buf), "%d", v);
+    Q_vsprintf_s(buf, sizeof(buf), sizeof(buf), "%d\n", v);
 
-    trap_FS_Write(buf, strlen(buf), f);
-    trap_FS_Write("\n", 1, f);
+    AdminWriteConfigRaw(buf, strlen(buf), f);
 }
 
 /*
 ===============
-idAdminLocal::SetClientSound
+idAdminLocal::AdminWriteConfigRaw
+
+Collects the config in g_admin_writeBuffer so the file gets a few large
+writes instead of several small ones per record
+===============
+*/
+void idAdminLocal::AdminWriteConfigRaw(pointer s, sint len, fileHandle_t f) {
+    sint n;
+
+    while(len > 0) {
+        if(g_admin_writeLength == sizeof(g_admin_writeBuffer)) {
+            trap_FS_Write(g_admin_writeBuffer, g_admin_writeLength, f);
+            g_admin_writeLength = 0;
+        }
+
+        n = MIN(len, (sint)sizeof(g_admin_writeBuffer) - g_admin_writeLength);
+        ::memcpy(g_admin_writeBuffer + g_admin_writeLength, s, n);
+        g_admin_writeLength += n;
+        s += n;
+        len -= n;
+    }
+}
+
+/*
+===============
+AdminJournalName
+===============
+*/
+static pointer AdminJournalName(void) {
+    static valueType name[ MAX_QPATH ];
+
+    Q_vsprintf_s(name, sizeof(name), sizeof(name), "%s.journal", g_admin.string);
+    return name;
+}
+
+/*
+===============
+idAdminLocal::AdminJournal
+
+Queues a change record for AdminFlushConfig
+===============
+*/
+void idAdminLocal::AdminJournal(pointer record) {
+    sint len = strlen(record);
+
+    if(!g_admin.string[ 0 ]) {
+        return;
+    }
+
+    if(g_admin_journalLength + len > sizeof(g_admin_journalBuffer)) {
+        AdminFlushConfig();
+    }
+
+    len = MIN(len, (sint)sizeof(g_admin_journalBuffer) - g_admin_journalLength);
+    ::memcpy(g_admin_journalBuffer + g_admin_journalLength, record, len);
+    g_admin_journalLength += len;
+}
+
+/*
+===============
+idAdminLocal::AdminJournalAdmin
+
+Records an admin's new state, replayed by guid
+===============
+*/
+void idAdminLocal::AdminJournalAdmin(g_admin_admin_t *a) {
+    valueType record[ MAX_STRING_CHARS ];
+
+    Q_vsprintf_s(record, sizeof(record), sizeof(record),
+                 "[admin]\nname    = %s\nguid    = %s\nlevel   = %d\n"
+                 "flags   = %s\ncounter = %d\n\n", a->name, a->guid, a->level,
+                 a->flags, a->counter);
+
+    AdminJournal(record);
+}
+
+/*
+===============
+idAdminLocal::AdminJournalBan
+
+Records a ban's new state, replayed by its number
+===============
+*/
+void idAdminLocal::AdminJournalBan(sint i) {
+    g_admin_ban_t *b = g_admin_bans[ i ];
+    valueType record[ MAX_STRING_CHARS ];
+
+    Q_vsprintf_s(record, sizeof(record), sizeof(record),
+                 "[ban]\nnumber  = %d\nname    = %s\nguid    = %s\nip      = %s\n"
+                 "reason  = %s\nmade    = %s\nexpires = %d\nbanner  = %s\n\n", i + 1,
+                 b->name, b->guid, b->ip, b->reason, b->made, b->expires, b->banner);
+
+    AdminJournal(record);
+}
+
+/*
+===============
+idAdminLocal::AdminFlushConfig
+
+Appends the changes queued this frame to the journal in one write
+===============
+*/
+void idAdminLocal::AdminFlushConfig(void) {
+    fileHandle_t f;
+
+    if(!g_admin_journalLength) {
+        return;
+    }
+
+    if(trap_FS_FOpenFile(AdminJournalName(), &f, FS_APPEND) < 0) {
+        idSGameMain::Printf("admin_flushconfig: could not open %s\n",
+                            AdminJournalName());
+        g_admin_journalLength = 0;
+        return;
+    }
+
+    trap_FS_Write(g_admin_journalBuffer, g_admin_journalLength, f);
+    trap_FS_FCloseFile(f);
+
+    g_admin_journalLength = 0;
+    g_admin_journalUsed = true;
+}
+
+/*
+===============
+idAdminLocal::AdminWriteConfig
+
+Compacts the journal: rewrites g_admin from memory, then empties the
+journal. Nothing is written if the journal is already empty
 ===============
 */
 void idAdminLocal::AdminWriteConfig(void) {
@@ -472,6 +602,14 @@ void idAdminLocal::AdminWriteConfig(void) {
     sint len, i, j, t;
     valueType levels[ MAX_STRING_CHARS ] = {""};
 
+    AdminFlushConfig();
+
+    if(!g_admin_journalUsed) {
+        return;
+    }
+
+    g_admin_journalUsed = false;
+
     if(!g_admin.string[ 0 ]) {
         idSGameMain::Printf(S_COLOR_YELLOW
                             "WARNING: g_admin is not set. configuration will not be saved to a file.\n");
@@ -489,14 +627,14 @@ void idAdminLocal::AdminWriteConfig(void) {
     }
 
     for(i = 0; i < MAX_ADMIN_LEVELS && g_admin_levels[ i ]; i++) {
-        trap_FS_Write("[level]\n", 8, f);
-        trap_FS_Write("level   = ", 10, f);
+        AdminWriteConfigRaw("[level]\n", 8, f);
+        AdminWriteConfigRaw("level   = ", 10, f);
         AdminWriteConfigInt(g_admin_levels[ i ]->level, f);
-        trap_FS_Write("name    = ", 10, f);
+        AdminWriteConfigRaw("name    = ", 10, f);
         AdminWriteConfigString(g_admin_levels[ i ]->name, f);
-        trap_FS_Write("flags   = ", 10, f);
+        AdminWriteConfigRaw("flags   = ", 10, f);
         AdminWriteConfigString(g_admin_levels[ i ]->flags, f);
-        trap_FS_Write("\n", 1, f);
+        AdminWriteConfigRaw("\n", 1, f);
     }
 
     for(i = 0; i < MAX_ADMIN_ADMINS && g_admin_admins[ i ]; i++) {
@@ -505,18 +643,18 @@ void idAdminLocal::AdminWriteConfig(void) {
             continue;
         }
 
-        trap_FS_Write("[admin]\n", 8, f);
-        trap_FS_Write("name    = ", 10, f);
+        AdminWriteConfigRaw("[admin]\n", 8, f);
+        AdminWriteConfigRaw("name    = ", 10, f);
         AdminWriteConfigString(g_admin_admins[ i ]->name, f);
-        trap_FS_Write("guid    = ", 10, f);
+        AdminWriteConfigRaw("guid    = ", 10, f);
         AdminWriteConfigString(g_admin_admins[ i ]->guid, f);
-        trap_FS_Write("level   = ", 10, f);
+        AdminWriteConfigRaw("level   = ", 10, f);
         AdminWriteConfigInt(g_admin_admins[ i ]->level, f);
-        trap_FS_Write("flags   = ", 10, f);
+        AdminWriteConfigRaw("flags   = ", 10, f);
         AdminWriteConfigString(g_admin_admins[ i ]->flags, f);
-        trap_FS_Write("counter = ", 10, f);
+        AdminWriteConfigRaw("counter = ", 10, f);
         AdminWriteConfigInt(g_admin_admins[i]->counter, f);
-        trap_FS_Write("\n", 1, f);
+        AdminWriteConfigRaw("\n", 1, f);
     }
 
     for(i = 0; i < MAX_ADMIN_BANS && g_admin_bans[ i ]; i++) {
@@ -526,34 +664,34 @@ void idAdminLocal::AdminWriteConfig(void) {
             continue;
         }
 
-        trap_FS_Write("[ban]\n", 6, f);
-        trap_FS_Write("name    = ", 10, f);
+        AdminWriteConfigRaw("[ban]\n", 6, f);
+        AdminWriteConfigRaw("name    = ", 10, f);
         AdminWriteConfigString(g_admin_bans[ i ]->name, f);
-        trap_FS_Write("guid    = ", 10, f);
+        AdminWriteConfigRaw("guid    = ", 10, f);
         AdminWriteConfigString(g_admin_bans[ i ]->guid, f);
-        trap_FS_Write("ip      = ", 10, f);
+        AdminWriteConfigRaw("ip      = ", 10, f);
         AdminWriteConfigString(g_admin_bans[ i ]->ip, f);
-        trap_FS_Write("reason  = ", 10, f);
+        AdminWriteConfigRaw("reason  = ", 10, f);
         AdminWriteConfigString(g_admin_bans[ i ]->reason, f);
-        trap_FS_Write("made    = ", 10, f);
+        AdminWriteConfigRaw("made    = ", 10, f);
         AdminWriteConfigString(g_admin_bans[ i ]->made, f);
-        trap_FS_Write("expires = ", 10, f);
+        AdminWriteConfigRaw("expires = ", 10, f);
         AdminWriteConfigInt(g_admin_bans[ i ]->expires, f);
-        trap_FS_Write("banner  = ", 10, f);
+        AdminWriteConfigRaw("banner  = ", 10, f);
         AdminWriteConfigString(g_admin_bans[ i ]->banner, f);
-        trap_FS_Write("\n", 1, f);
+        AdminWriteConfigRaw("\n", 1, f);
     }
 
     for(i = 0; i < MAX_ADMIN_COMMANDS && g_admin_commands[ i ]; i++) {
         levels[ 0 ] = '\0';
-        trap_FS_Write("[command]\n", 10, f);
-        trap_FS_Write("command = ", 10, f);
+        AdminWriteConfigRaw("[command]\n", 10, f);
+        AdminWriteConfigRaw("command = ", 10, f);
         AdminWriteConfigString(g_admin_commands[ i ]->command, f);
-        trap_FS_Write("exec    = ", 10, f);
+        AdminWriteConfigRaw("exec    = ", 10, f);
         AdminWriteConfigString(g_admin_commands[ i ]->exec, f);
-        trap_FS_Write("desc    = ", 10, f);
+        AdminWriteConfigRaw("desc    = ", 10, f);
         AdminWriteConfigString(g_admin_commands[ i ]->desc, f);
-        trap_FS_Write("levels  = ", 10, f);
+        AdminWriteConfigRaw("levels  = ", 10, f);
 
         for(j = 0; g_admin_commands[ i ]->levels[ j ] != -1; j++) {
             Q_strcat(levels, sizeof(levels), va("%i ",
@@ -562,10 +700,20 @@ void idAdminLocal::AdminWriteConfig(void) {
 
         AdminWriteConfigString(levels, f);
 
-        trap_FS_Write("\n", 1, f);
+        AdminWriteConfigRaw("\n", 1, f);
+    }
+
+    if(g_admin_writeLength) {
+        trap_FS_Write(g_admin_writeBuffer, g_admin_writeLength, f);
+        g_admin_writeLength = 0;
     }
 
     trap_FS_FCloseFile(f);
+
+    // only now that g_admin holds them can the records go
+    if(trap_FS_FOpenFile(AdminJournalName(), &f, FS_WRITE) >= 0) {
+        trap_FS_FCloseFile(f);
+    }
 }
 
 /*
@@ -986,220 +1134,997 @@ void idAdminLocal::AdminDuration(sint secs, valueType *duration,
 idAdminLocal::AdminBanCheck
 ===============
 */
-bool idAdminLocal::AdminBanCheck(valueType *userinfo, valueType *reason,
-                                 sint rlen) {
-    valueType *guid, *ip;
+bool idAdminLocal::AdminBanCheck(const infoView_t *userinfo,
+                                 valueType *reason, sint rlen) {
+    valueType guid[ MAX_INFO_VALUE ], ip[ MAX_INFO_VALUE ];
     sint i, t;
 
     *reason = '\0';
     t = trap_RealTime(nullptr);
 
-    if(!*userinfo) {
-        return false;
+    if(!userinfo->numPairs) {
+        return false;
+    }
+
+    Info_ViewString(userinfo, "ip", ip, sizeof(ip));
+
+    if(!*ip) {
+        return false;
+    }
+
+    Info_ViewString(userinfo, "cl_guid", guid, sizeof(guid));
+
+    for(i = 0; i < MAX_ADMIN_BANS && g_admin_bans[ i ]; i++) {
+        // 0 is for perm ban
+        if(g_admin_bans[i]->expires != 0 && (g_admin_bans[i]->expires - t) < 1) {
+            continue;
+        }
+
+        if(strstr(ip, g_admin_bans[ i ]->ip)) {
+            valueType duration[ 32 ];
+            AdminDuration((g_admin_bans[ i ]->expires - t), duration,
+                          sizeof(duration));
+            Q_vsprintf_s(reason, rlen, rlen,
+                         "You have been banned by %s^7 reason: %s^7 expires: %s",
+                         g_admin_bans[ i ]->banner, g_admin_bans[ i ]->reason, duration);
+
+            idSGameMain::Printf("Banned player tried to connect from IP %s\n", ip);
+
+            return true;
+        }
+
+        if(*guid && !Q_stricmp(g_admin_bans[ i ]->guid, guid)) {
+            valueType duration[ 32 ];
+            AdminDuration((g_admin_bans[ i ]->expires - t), duration,
+                          sizeof(duration));
+            Q_vsprintf_s(reason, rlen, rlen,
+                         "You have been banned by %s^7 reason: %s^7 expires: %s",
+                         g_admin_bans[ i ]->banner, g_admin_bans[ i ]->reason, duration);
+            idSGameMain::Printf("Banned player tried to connect with GUID %s\n", guid);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+===============
+idAdminLocal::AdminCmdCheck
+===============
+*/
+bool idAdminLocal::AdminCmdCheck(gentity_t *ent, bool say) {
+    sint i, skip = 0;
+    valueType command[ MAX_ADMIN_CMD_LEN ];
+    valueType *cmd;
+
+    command[ 0 ] = '\0';
+    idSGameCmds::SayArgv(0, command, sizeof(command));
+
+    if(!command[0]) {
+        return false;
+    }
+
+    if(!Q_stricmp(command, "say") || (!Q_stricmp(command, "say_team") &&
+                                      AdminPermission(ent, ADMF_TEAMCHAT_CMD))) {
+        skip = 1;
+        idSGameCmds::SayArgv(1, command, sizeof(command));
+    }
+
+    if(command[ 0 ] == '!') {
+        cmd = &command[ 1 ];
+    } else {
+        return false;
+    }
+
+    for(i = 0; i < MAX_ADMIN_COMMANDS && g_admin_commands[ i ]; i++) {
+        if(Q_stricmp(cmd, g_admin_commands[ i ]->command)) {
+            continue;
+        }
+
+        if(AdminCommandPermission(ent, cmd)) {
+            // flooding say will have already been accounted for in ClientCommand
+            if(!say && idSGameCmds::FloodLimited(ent)) {
+                return true;
+            }
+
+            trap_SendConsoleCommand(EXEC_APPEND, g_admin_commands[ i ]->exec);
+            AdminLog(ent, cmd, skip);
+        } else {
+            ADMP(va("^3!%s: ^7permission denied\n", g_admin_commands[ i ]->command));
+            AdminLog(ent, "attempted", skip - 1);
+        }
+
+        return true;
+    }
+
+    for(i = 0; i < adminNumCmds; i++) {
+        if(Q_stricmp(cmd, g_admin_cmds[i].keyword)) {
+            continue;
+        }
+
+        if(AdminPermission(ent, g_admin_cmds[ i ].flag[ 0 ])) {
+            // flooding say will have already been accounted for in ClientCommand
+            if(!say && idSGameCmds::FloodLimited(ent)) {
+                return true;
+            }
+
+            g_admin_cmds[ i ].handler(ent, skip);
+            AdminLog(ent, cmd, skip);
+        } else {
+            ADMP(va("^3!%s: ^7permission denied\n", g_admin_cmds[ i ].keyword));
+            AdminLog(ent, "attempted", skip - 1);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+#define NAMELOG_HASH_SIZE 1024
+#define NAMELOG_GRAM_HASH 4096
+#define MAX_NAMELOG_GRAMS ( MAX_ADMIN_NAMELOGS * 64 )
+#define MAX_NAMELOG_FILE 524288
+
+// namelog entries live here; g_admin_namelog[] points at the ones in use
+static g_admin_namelog_t g_admin_namelogStore[ MAX_ADMIN_NAMELOGS ];
+static sint g_admin_namelogCount;
+static sint g_admin_namelogHash[ NAMELOG_HASH_SIZE ];
+static sint g_admin_namelogIPHash[ NAMELOG_HASH_SIZE ];
+static sint g_admin_namelogOldest, g_admin_namelogNewest;
+static bool g_admin_namelogIndexed;
+
+// trigram index of the sanitised names, each trigram hash chaining the
+// entries with a name containing it
+typedef struct {
+    sint entry;
+    sint next;
+} namelogGram_t;
+
+static namelogGram_t g_admin_namelogGrams[ MAX_NAMELOG_GRAMS ];
+static sint g_admin_namelogGramHash[ NAMELOG_GRAM_HASH ];
+static sint g_admin_namelogGramLength[ NAMELOG_GRAM_HASH ];
+static sint g_admin_namelogGramFree, g_admin_namelogGramUsed;
+static sint g_admin_namelogUnindexed;   // entries the pool had no room for
+
+// the namelog is kept across maps in g_adminNamelog
+static valueType g_admin_namelogFile[ MAX_NAMELOG_FILE + 1 ];
+
+/*
+===============
+NamelogIndexInit
+===============
+*/
+static void NamelogIndexInit(void) {
+    sint i;
+
+    if(g_admin_namelogIndexed) {
+        return;
+    }
+
+    for(i = 0; i < NAMELOG_HASH_SIZE; i++) {
+        g_admin_namelogHash[ i ] = g_admin_namelogIPHash[ i ] = -1;
+    }
+
+    for(i = 0; i < NAMELOG_GRAM_HASH; i++) {
+        g_admin_namelogGramHash[ i ] = -1;
+        g_admin_namelogGramLength[ i ] = 0;
+    }
+
+    g_admin_namelogOldest = g_admin_namelogNewest = -1;
+    g_admin_namelogCount = 0;
+    g_admin_namelogGramFree = -1;
+    g_admin_namelogGramUsed = 0;
+    g_admin_namelogUnindexed = 0;
+    g_admin_namelogIndexed = true;
+}
+
+/*
+===============
+NamelogKey
+===============
+*/
+static sint NamelogKey(pointer guid, pointer ip) {
+    return (Com_NameHash(guid) * 31 + Com_NameHash(ip)) &
+           (NAMELOG_HASH_SIZE - 1);
+}
+
+/*
+===============
+NamelogIPKey
+===============
+*/
+static sint NamelogIPKey(pointer ip) {
+    return Com_NameHash(ip) & (NAMELOG_HASH_SIZE - 1);
+}
+
+/*
+===============
+NamelogUnlinkAge
+
+Removes an entry from the last seen order
+===============
+*/
+static void NamelogUnlinkAge(sint i) {
+    g_admin_namelog_t *namelog = g_admin_namelog[ i ];
+
+    if(namelog->older >= 0) {
+        g_admin_namelog[ namelog->older ]->newer = namelog->newer;
+    } else {
+        g_admin_namelogOldest = namelog->newer;
+    }
+
+    if(namelog->newer >= 0) {
+        g_admin_namelog[ namelog->newer ]->older = namelog->older;
+    } else {
+        g_admin_namelogNewest = namelog->older;
+    }
+}
+
+/*
+===============
+NamelogTouch
+
+Makes an entry the most recently seen
+===============
+*/
+static void NamelogTouch(sint i) {
+    g_admin_namelog_t *namelog = g_admin_namelog[ i ];
+
+    if(g_admin_namelogNewest == i) {
+        return;
+    }
+
+    if(namelog->older >= 0 || g_admin_namelogOldest == i) {
+        NamelogUnlinkAge(i);
+    }
+
+    namelog->older = g_admin_namelogNewest;
+    namelog->newer = -1;
+
+    if(g_admin_namelogNewest >= 0) {
+        g_admin_namelog[ g_admin_namelogNewest ]->newer = i;
+    } else {
+        g_admin_namelogOldest = i;
+    }
+
+    g_admin_namelogNewest = i;
+}
+
+/*
+===============
+NamelogUnlink
+
+Removes an entry from the hash chains and the last seen order
+===============
+*/
+static void NamelogUnlink(sint i) {
+    g_admin_namelog_t *namelog = g_admin_namelog[ i ];
+    sint *link;
+
+    for(link = &g_admin_namelogHash[ NamelogKey(namelog->guid, namelog->ip) ];
+            *link >= 0; link = &g_admin_namelog[ *link ]->hashNext) {
+        if(*link == i) {
+            *link = namelog->hashNext;
+            break;
+        }
+    }
+
+    for(link = &g_admin_namelogIPHash[ NamelogIPKey(namelog->ip) ];
+            *link >= 0; link = &g_admin_namelog[ *link ]->ipNext) {
+        if(*link == i) {
+            *link = namelog->ipNext;
+            break;
+        }
+    }
+
+    NamelogUnlinkAge(i);
+}
+
+/*
+===============
+NamelogGramKey
+===============
+*/
+static sint NamelogGramKey(pointer s) {
+    return ((static_cast<uchar8>(s[ 0 ]) * 31 + static_cast<uchar8>(s[ 1 ])) * 31 +
+            static_cast<uchar8>(s[ 2 ])) & (NAMELOG_GRAM_HASH - 1);
+}
+
+/*
+===============
+NamelogGrams
+
+The distinct trigram keys of an entry's names
+===============
+*/
+static sint NamelogGrams(g_admin_namelog_t *namelog, sint *keys) {
+    sint i, k, key, num = 0;
+    pointer s;
+
+    for(i = 0; i < MAX_ADMIN_NAMELOG_NAMES && namelog->name[ i ][ 0 ]; i++) {
+        for(s = namelog->sanitised[ i ]; s[ 0 ] && s[ 1 ] && s[ 2 ]; s++) {
+            key = NamelogGramKey(s);
+
+            for(k = 0; k < num && keys[ k ] != key; k++);
+
+            if(k == num) {
+                keys[ num++ ] = key;
+            }
+        }
+    }
+
+    return num;
+}
+
+/*
+===============
+NamelogRemoveGrams
+===============
+*/
+static void NamelogRemoveGrams(sint i, const sint *keys, sint num) {
+    sint k, node, *link;
+
+    for(k = 0; k < num; k++) {
+        for(link = &g_admin_namelogGramHash[ keys[ k ] ]; *link >= 0;
+                link = &g_admin_namelogGrams[ *link ].next) {
+            if(g_admin_namelogGrams[ *link ].entry == i) {
+                node = *link;
+                *link = g_admin_namelogGrams[ node ].next;
+                g_admin_namelogGrams[ node ].next = g_admin_namelogGramFree;
+                g_admin_namelogGramFree = node;
+                g_admin_namelogGramLength[ keys[ k ] ]--;
+                break;
+            }
+        }
+    }
+}
+
+/*
+===============
+NamelogUnindexNames
+
+Takes an entry's names out of the trigram index, before they change
+===============
+*/
+static void NamelogUnindexNames(sint i) {
+    g_admin_namelog_t *namelog = g_admin_namelog[ i ];
+    sint keys[ MAX_ADMIN_NAMELOG_NAMES * MAX_NAME_LENGTH ];
+
+    if(!namelog->indexed) {
+        g_admin_namelogUnindexed--;
+        return;
+    }
+
+    NamelogRemoveGrams(i, keys, NamelogGrams(namelog, keys));
+}
+
+/*
+===============
+NamelogIndexNames
+
+Adds an entry's names to the trigram index. If the pool is full the entry
+is left out, and searches fall back to looking at every entry
+===============
+*/
+static void NamelogIndexNames(sint i) {
+    g_admin_namelog_t *namelog = g_admin_namelog[ i ];
+    sint keys[ MAX_ADMIN_NAMELOG_NAMES * MAX_NAME_LENGTH ];
+    sint k, num, node;
+
+    num = NamelogGrams(namelog, keys);
+
+    for(k = 0; k < num; k++) {
+        if(g_admin_namelogGramFree >= 0) {
+            node = g_admin_namelogGramFree;
+            g_admin_namelogGramFree = g_admin_namelogGrams[ node ].next;
+        } else if(g_admin_namelogGramUsed < MAX_NAMELOG_GRAMS) {
+            node = g_admin_namelogGramUsed++;
+        } else {
+            break;
+        }
+
+        g_admin_namelogGrams[ node ].entry = i;
+        g_admin_namelogGrams[ node ].next = g_admin_namelogGramHash[ keys[ k ] ];
+        g_admin_namelogGramHash[ keys[ k ] ] = node;
+        g_admin_namelogGramLength[ keys[ k ] ]++;
+    }
+
+    namelog->indexed = (k == num);
+
+    if(!namelog->indexed) {
+        NamelogRemoveGrams(i, keys, k);
+        g_admin_namelogUnindexed++;
+    }
+}
+
+/*
+===============
+NamelogNew
+
+Makes an entry for a guid and ip, recycling the least recently seen one
+that isn't connected once the log is full. Returns -1 if they all are
+===============
+*/
+static sint NamelogNew(pointer guid, pointer ip) {
+    g_admin_namelog_t *namelog;
+    sint i, key;
+
+    if(g_admin_namelogCount < MAX_ADMIN_NAMELOGS) {
+        i = g_admin_namelogCount++;
+        g_admin_namelog[ i ] = &g_admin_namelogStore[ i ];
+    } else {
+        for(i = g_admin_namelogOldest; i >= 0 && g_admin_namelog[ i ]->slot != -1;
+                i = g_admin_namelog[ i ]->newer);
+
+        if(i < 0) {
+            return -1;
+        }
+
+        NamelogUnlink(i);
+        NamelogUnindexNames(i);
+    }
+
+    namelog = g_admin_namelog[ i ];
+    ::memset(namelog, 0, sizeof(*namelog));
+
+    Q_strncpyz(namelog->ip, ip, sizeof(namelog->ip));
+    Q_strncpyz(namelog->guid, guid, sizeof(namelog->guid));
+    namelog->slot = -1;
+
+    key = NamelogKey(namelog->guid, namelog->ip);
+    namelog->hashNext = g_admin_namelogHash[ key ];
+    g_admin_namelogHash[ key ] = i;
+    key = NamelogIPKey(namelog->ip);
+    namelog->ipNext = g_admin_namelogIPHash[ key ];
+    g_admin_namelogIPHash[ key ] = i;
+
+    namelog->older = namelog->newer = -1;
+    NamelogTouch(i);
+
+    return i;
+}
+
+/*
+===============
+NamelogMatches
+===============
+*/
+static bool NamelogMatches(sint i, pointer name) {
+    g_admin_namelog_t *namelog = g_admin_namelog[ i ];
+    sint j;
+
+    for(j = 0; j < MAX_ADMIN_NAMELOG_NAMES && namelog->name[ j ][ 0 ]; j++) {
+        if(strstr(namelog->sanitised[ j ], name)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+===============
+NamelogCompare
+===============
+*/
+static sint NamelogCompare(const void *a, const void *b) {
+    return *(const sint *)a - *(const sint *)b;
+}
+
+/*
+===============
+idAdminLocal::AdminNamelogCleanup
+===============
+*/
+void idAdminLocal::AdminNamelogCleanup(void) {
+    sint i;
+
+    for(i = 0; i < MAX_ADMIN_NAMELOGS && g_admin_namelog[ i ]; i++) {
+        g_admin_namelog[ i ] = nullptr;
+    }
+
+    g_admin_namelogIndexed = false;
+}
+
+/*
+===============
+idAdminLocal::AdminNamelogFindIP
+
+The first entry that is not banned with the given ip, or -1
+===============
+*/
+sint idAdminLocal::AdminNamelogFindIP(valueType *ip) {
+    sint i, found = -1;
+
+    NamelogIndexInit();
+
+    for(i = g_admin_namelogIPHash[ NamelogIPKey(ip) ]; i >= 0;
+            i = g_admin_namelog[ i ]->ipNext) {
+        if(g_admin_namelog[ i ]->banned || Q_stricmp(g_admin_namelog[ i ]->ip, ip)) {
+            continue;
+        }
+
+        if(found < 0 || i < found) {
+            found = i;
+        }
+    }
+
+    return found;
+}
+
+/*
+===============
+idAdminLocal::AdminNamelogUpdate
+
+Entries are found through a hash of guid and ip; once the log is full the
+least recently seen disconnected client makes way for a new one
+===============
+*/
+void idAdminLocal::AdminNamelogUpdate(gclient_t *client, bool disconnect) {
+    sint i, j, key;
+    bool reindex;
+    g_admin_namelog_t *namelog;
+    valueType n1[ MAX_NAME_LENGTH ];
+    sint clientNum = (client - level.clients);
+
+    NamelogIndexInit();
+
+    idSGameCmds::SanitiseString(client->pers.netname, n1, sizeof(n1));
+
+    key = NamelogKey(client->pers.guid, client->pers.ip);
+
+    for(i = g_admin_namelogHash[ key ]; i >= 0;
+            i = g_admin_namelog[ i ]->hashNext) {
+        namelog = g_admin_namelog[ i ];
+
+        if(disconnect && namelog->slot != clientNum) {
+            continue;
+        }
+
+        if(!disconnect && !(namelog->slot == clientNum || namelog->slot == -1)) {
+            continue;
+        }
+
+        if(!Q_stricmp(client->pers.ip, namelog->ip) &&
+                !Q_stricmp(client->pers.guid, namelog->guid)) {
+            for(j = 0; j < MAX_ADMIN_NAMELOG_NAMES && namelog->name[ j ][ 0 ]; j++) {
+                if(!Q_stricmp(n1, namelog->sanitised[ j ])) {
+                    break;
+                }
+            }
+
+            if(j == MAX_ADMIN_NAMELOG_NAMES) {
+                j = MAX_ADMIN_NAMELOG_NAMES - 1;
+            }
+
+            // only a new sanitised name changes the trigram index
+            reindex = Q_stricmp(n1, namelog->sanitised[ j ]) != 0;
+
+            if(reindex) {
+                NamelogUnindexNames(i);
+            }
+
+            Q_strncpyz(namelog->name[ j ], client->pers.netname,
+                       sizeof(namelog->name[ j ]));
+            Q_strncpyz(namelog->sanitised[ j ], n1, sizeof(namelog->sanitised[ j ]));
+            namelog->slot = (disconnect) ? -1 : clientNum;
+
+            if(reindex) {
+                NamelogIndexNames(i);
+            }
+
+            // if this player is connecting, they are no longer banned
+            if(!disconnect) {
+                namelog->banned = false;
+            }
+
+            NamelogTouch(i);
+            return;
+        }
+    }
+
+    i = NamelogNew(client->pers.guid, client->pers.ip);
+
+    if(i < 0) {
+        idSGameMain::Printf("idAdminLocal::AdminNamelogUpdate: warning, g_admin_namelogs overflow\n");
+        return;
+    }
+
+    namelog = g_admin_namelog[ i ];
+
+    Q_strncpyz(namelog->name[ 0 ], client->pers.netname,
+               sizeof(namelog->name[ 0 ]));
+    Q_strncpyz(namelog->sanitised[ 0 ], n1, sizeof(namelog->sanitised[ 0 ]));
+    namelog->slot = (disconnect) ? -1 : clientNum;
+
+    NamelogIndexNames(i);
+}
+
+/*
+===============
+idAdminLocal::AdminNamelogSearch
+
+Fills list with the entries, in order, that have a sanitised name
+containing the given one. Names of three or more characters are looked up
+through the trigram with the fewest entries; shorter ones, or any while
+some entry did not fit in the index, look at every entry
+===============
+*/
+sint idAdminLocal::AdminNamelogSearch(pointer name, sint *list) {
+    sint i, key, best, num = 0;
+    pointer s;
+
+    NamelogIndexInit();
+
+    if(strlen(name) < 3 || g_admin_namelogUnindexed) {
+        for(i = 0; i < MAX_ADMIN_NAMELOGS && g_admin_namelog[ i ]; i++) {
+            if(NamelogMatches(i, name)) {
+                list[ num++ ] = i;
+            }
+        }
+
+        return num;
+    }
+
+    best = NamelogGramKey(name);
+
+    for(s = name + 1; s[ 2 ]; s++) {
+        key = NamelogGramKey(s);
+
+        if(g_admin_namelogGramLength[ key ] < g_admin_namelogGramLength[ best ]) {
+            best = key;
+        }
+    }
+
+    for(i = g_admin_namelogGramHash[ best ]; i >= 0;
+            i = g_admin_namelogGrams[ i ].next) {
+        if(NamelogMatches(g_admin_namelogGrams[ i ].entry, name)) {
+            list[ num++ ] = g_admin_namelogGrams[ i ].entry;
+        }
+    }
+
+    qsort(list, num, sizeof(list[ 0 ]), NamelogCompare);
+
+    return num;
+}
+
+/*
+===============
+idAdminLocal::AdminNamelogWrite
+
+Saves the most recently seen entries to g_adminNamelog, as many as fit in
+g_adminNamelogSize kilobytes
+===============
+*/
+void idAdminLocal::AdminNamelogWrite(void) {
+    g_admin_namelog_t *namelog;
+    fileHandle_t f;
+    sint i, j, size, budget;
+
+    if(!g_adminNamelog.string[ 0 ] || !g_admin_namelogIndexed) {
+        return;
     }
 
-    ip = Info_ValueForKey(userinfo, "ip");
+    budget = Q_min(g_adminNamelogSize.integer * 1024, MAX_NAMELOG_FILE);
 
-    if(!*ip) {
-        return false;
-    }
+    // walk back from the newest entry until the budget is spent
+    for(i = g_admin_namelogNewest, size = 0; i >= 0;
+            i = g_admin_namelog[ i ]->older) {
+        namelog = g_admin_namelog[ i ];
 
-    guid = Info_ValueForKey(userinfo, "cl_guid");
+        size += 45 + strlen(namelog->guid) + strlen(namelog->ip);
 
-    for(i = 0; i < MAX_ADMIN_BANS && g_admin_bans[ i ]; i++) {
-        // 0 is for perm ban
-        if(g_admin_bans[i]->expires != 0 && (g_admin_bans[i]->expires - t) < 1) {
-            continue;
+        for(j = 0; j < MAX_ADMIN_NAMELOG_NAMES && namelog->name[ j ][ 0 ]; j++) {
+            size += 11 + strlen(namelog->name[ j ]);
         }
 
-        if(strstr(ip, g_admin_bans[ i ]->ip)) {
-            valueType duration[ 32 ];
-            AdminDuration((g_admin_bans[ i ]->expires - t), duration,
-                          sizeof(duration));
-            Q_vsprintf_s(reason, rlen, rlen,
-                         "You have been banned by %s^7 reason: %s^7 expires: %s",
-                         g_admin_bans[ i ]->banner, g_admin_bans[ i ]->reason, duration);
+        if(size > budget) {
+            break;
+        }
+    }
 
-            idSGameMain::Printf("Banned player tried to connect from IP %s\n", ip);
+    i = (i >= 0) ? g_admin_namelog[ i ]->newer : g_admin_namelogOldest;
 
-            return true;
-        }
+    if(trap_FS_FOpenFile(g_adminNamelog.string, &f, FS_WRITE) < 0) {
+        idSGameMain::Printf("AdminNamelogWrite: could not open %s\n",
+                            g_adminNamelog.string);
+        return;
+    }
 
-        if(*guid && !Q_stricmp(g_admin_bans[ i ]->guid, guid)) {
-            valueType duration[ 32 ];
-            AdminDuration((g_admin_bans[ i ]->expires - t), duration,
-                          sizeof(duration));
-            Q_vsprintf_s(reason, rlen, rlen,
-                         "You have been banned by %s^7 reason: %s^7 expires: %s",
-                         g_admin_bans[ i ]->banner, g_admin_bans[ i ]->reason, duration);
-            idSGameMain::Printf("Banned player tried to connect with GUID %s\n", guid);
-            return true;
+    // oldest first, so reading them back in restores the order
+    for(; i >= 0; i = g_admin_namelog[ i ]->newer) {
+        namelog = g_admin_namelog[ i ];
+
+        AdminWriteConfigRaw("[namelog]\n", 10, f);
+        AdminWriteConfigRaw("guid    = ", 10, f);
+        AdminWriteConfigString(namelog->guid, f);
+        AdminWriteConfigRaw("ip      = ", 10, f);
+        AdminWriteConfigString(namelog->ip, f);
+        AdminWriteConfigRaw("banned  = ", 10, f);
+        AdminWriteConfigInt(namelog->banned, f);
+
+        for(j = 0; j < MAX_ADMIN_NAMELOG_NAMES && namelog->name[ j ][ 0 ]; j++) {
+            AdminWriteConfigRaw("name    = ", 10, f);
+            AdminWriteConfigString(namelog->name[ j ], f);
         }
+
+        AdminWriteConfigRaw("\n", 1, f);
     }
 
-    return false;
+    if(g_admin_writeLength) {
+        trap_FS_Write(g_admin_writeBuffer, g_admin_writeLength, f);
+        g_admin_writeLength = 0;
+    }
+
+    trap_FS_FCloseFile(f);
 }
 
 /*
 ===============
-idAdminLocal::AdminCmdCheck
+idAdminLocal::AdminNamelogRead
+
+Loads the entries saved by AdminNamelogWrite when the last map ended
 ===============
 */
-bool idAdminLocal::AdminCmdCheck(gentity_t *ent, bool say) {
-    sint i, skip = 0;
-    valueType command[ MAX_ADMIN_CMD_LEN ];
-    valueType *cmd;
+void idAdminLocal::AdminNamelogRead(void) {
+    g_admin_namelog_t entry, *namelog;
+    fileHandle_t f;
+    sint i, j, len;
+    valueType *cnf, *t;
+    bool open = false;
 
-    command[ 0 ] = '\0';
-    idSGameCmds::SayArgv(0, command, sizeof(command));
+    NamelogIndexInit();
 
-    if(!command[0]) {
-        return false;
+    if(!g_adminNamelog.string[ 0 ]) {
+        return;
     }
 
-    if(!Q_stricmp(command, "say") || (!Q_stricmp(command, "say_team") &&
-                                      AdminPermission(ent, ADMF_TEAMCHAT_CMD))) {
-        skip = 1;
-        idSGameCmds::SayArgv(1, command, sizeof(command));
+    len = trap_FS_FOpenFile(g_adminNamelog.string, &f, FS_READ);
+
+    if(len < 0) {
+        return;
     }
 
-    if(command[ 0 ] == '!') {
-        cmd = &command[ 1 ];
-    } else {
-        return false;
+    if(len > MAX_NAMELOG_FILE) {
+        idSGameMain::Printf("AdminNamelogRead: %s is too large\n",
+                            g_adminNamelog.string);
+        trap_FS_FCloseFile(f);
+        return;
     }
 
-    for(i = 0; i < MAX_ADMIN_COMMANDS && g_admin_commands[ i ]; i++) {
-        if(Q_stricmp(cmd, g_admin_commands[ i ]->command)) {
-            continue;
-        }
+    trap_FS_Read(g_admin_namelogFile, len, f);
+    g_admin_namelogFile[ len ] = '\0';
+    trap_FS_FCloseFile(f);
 
-        if(AdminCommandPermission(ent, cmd)) {
-            // flooding say will have already been accounted for in ClientCommand
-            if(!say && idSGameCmds::FloodLimited(ent)) {
-                return true;
+    cnf = g_admin_namelogFile;
+    COM_BeginParseSession(g_adminNamelog.string);
+
+    while(1) {
+        t = COM_Parse(&cnf);
+
+        // each entry is added once the next one starts
+        if((!*t || !Q_stricmp(t, "[namelog]")) && open && entry.name[ 0 ][ 0 ] &&
+                (i = NamelogNew(entry.guid, entry.ip)) >= 0) {
+            namelog = g_admin_namelog[ i ];
+            namelog->banned = entry.banned;
+
+            for(j = 0; j < MAX_ADMIN_NAMELOG_NAMES && entry.name[ j ][ 0 ]; j++) {
+                Q_strncpyz(namelog->name[ j ], entry.name[ j ],
+                           sizeof(namelog->name[ j ]));
+                idSGameCmds::SanitiseString(namelog->name[ j ], namelog->sanitised[ j ],
+                                            sizeof(namelog->sanitised[ j ]));
             }
 
-            trap_SendConsoleCommand(EXEC_APPEND, g_admin_commands[ i ]->exec);
-            AdminLog(ent, cmd, skip);
-        } else {
-            ADMP(va("^3!%s: ^7permission denied\n", g_admin_commands[ i ]->command));
-            AdminLog(ent, "attempted", skip - 1);
+            NamelogIndexNames(i);
         }
 
-        return true;
-    }
-
-    for(i = 0; i < adminNumCmds; i++) {
-        if(Q_stricmp(cmd, g_admin_cmds[i].keyword)) {
-            continue;
+        if(!*t) {
+            break;
         }
 
-        if(AdminPermission(ent, g_admin_cmds[ i ].flag[ 0 ])) {
-            // flooding say will have already been accounted for in ClientCommand
-            if(!say && idSGameCmds::FloodLimited(ent)) {
-                return true;
+        if(!Q_stricmp(t, "[namelog]")) {
+            ::memset(&entry, 0, sizeof(entry));
+            open = true;
+            j = 0;
+        } else if(!open) {
+            COM_ParseError("[namelog] expected");
+        } else if(!Q_stricmp(t, "guid")) {
+            AdminReadConfigString(&cnf, entry.guid, sizeof(entry.guid));
+        } else if(!Q_stricmp(t, "ip")) {
+            AdminReadConfigString(&cnf, entry.ip, sizeof(entry.ip));
+        } else if(!Q_stricmp(t, "banned")) {
+            AdminReadConfigInt(&cnf, &len);
+            entry.banned = (len != 0);
+        } else if(!Q_stricmp(t, "name")) {
+            if(j < MAX_ADMIN_NAMELOG_NAMES) {
+                AdminReadConfigString(&cnf, entry.name[ j ], sizeof(entry.name[ j ]));
+                j += (entry.name[ j ][ 0 ] != '\0');
+            } else {
+                COM_ParseWarning("too many names");
+                SkipRestOfLine(&cnf);
             }
-
-            g_admin_cmds[ i ].handler(ent, skip);
-            AdminLog(ent, cmd, skip);
         } else {
-            ADMP(va("^3!%s: ^7permission denied\n", g_admin_cmds[ i ].keyword));
-            AdminLog(ent, "attempted", skip - 1);
+            COM_ParseError("[namelog] unrecognized token \"%s\"", t);
         }
+    }
+}
 
-        return true;
+/*
+===============
+idAdminLocal::AdminReadAdminField
+===============
+*/
+bool idAdminLocal::AdminReadAdminField(valueType **cnf, pointer t,
+                                       g_admin_admin_t *a) {
+    if(!Q_stricmp(t, "name")) {
+        AdminReadConfigString(cnf, a->name, sizeof(a->name));
+    } else if(!Q_stricmp(t, "guid")) {
+        AdminReadConfigString(cnf, a->guid, sizeof(a->guid));
+    } else if(!Q_stricmp(t, "level")) {
+        AdminReadConfigInt(cnf, &a->level);
+    } else if(!Q_stricmp(t, "flags")) {
+        AdminReadConfigString(cnf, a->flags, sizeof(a->flags));
+    } else if(!Q_stricmp(t, "counter")) {
+        AdminReadConfigInt(cnf, &a->counter);
+    } else {
+        return false;
     }
 
-    return false;
+    return true;
 }
 
 /*
 ===============
-idAdminLocal::AdminNamelogCleanup
+idAdminLocal::AdminReadBanField
 ===============
 */
-void idAdminLocal::AdminNamelogCleanup(void) {
-    sint i;
-
-    for(i = 0; i < MAX_ADMIN_NAMELOGS && g_admin_namelog[ i ]; i++) {
-        bggame->Free(g_admin_namelog[ i ]);
-        g_admin_namelog[ i ] = nullptr;
+bool idAdminLocal::AdminReadBanField(valueType **cnf, pointer t,
+                                     g_admin_ban_t *b) {
+    if(!Q_stricmp(t, "name")) {
+        AdminReadConfigString(cnf, b->name, sizeof(b->name));
+    } else if(!Q_stricmp(t, "guid")) {
+        AdminReadConfigString(cnf, b->guid, sizeof(b->guid));
+    } else if(!Q_stricmp(t, "ip")) {
+        AdminReadConfigString(cnf, b->ip, sizeof(b->ip));
+    } else if(!Q_stricmp(t, "reason")) {
+        AdminReadConfigString(cnf, b->reason, sizeof(b->reason));
+    } else if(!Q_stricmp(t, "made")) {
+        AdminReadConfigString(cnf, b->made, sizeof(b->made));
+    } else if(!Q_stricmp(t, "expires")) {
+        AdminReadConfigInt(cnf, &b->expires);
+    } else if(!Q_stricmp(t, "banner")) {
+        AdminReadConfigString(cnf, b->banner, sizeof(b->banner));
+    } else {
+        return false;
     }
+
+    return true;
 }
 
 /*
 ===============
-idAdminLocal::AdminNamelogUpdate
+idAdminLocal::AdminReplayRecord
+
+Applies a journal record read into a or b: admins replace the ones with
+the same guid, bans the one with their number
 ===============
 */
-void idAdminLocal::AdminNamelogUpdate(gclient_t *client, bool disconnect) {
-    sint i, j;
-    g_admin_namelog_t *namelog;
-    valueType n1[ MAX_NAME_LENGTH ];
-    valueType n2[ MAX_NAME_LENGTH ];
-    sint clientNum = (client - level.clients);
-
-    idSGameCmds::SanitiseString(client->pers.netname, n1, sizeof(n1));
+void idAdminLocal::AdminReplayRecord(g_admin_admin_t *a, g_admin_ban_t *b,
+                                     sint number) {
+    sint i;
+    bool found = false;
 
-    for(i = 0; i < MAX_ADMIN_NAMELOGS && g_admin_namelog[ i ]; i++) {
-        if(disconnect && g_admin_namelog[i]->slot != clientNum) {
-            continue;
+    if(a) {
+        for(i = 0; i < MAX_ADMIN_ADMINS && g_admin_admins[ i ]; i++) {
+            if(!Q_stricmp(g_admin_admins[ i ]->guid, a->guid)) {
+                *g_admin_admins[ i ] = *a;
+                found = true;
+            }
         }
 
-        if(!disconnect && !(g_admin_namelog[ i ]->slot == clientNum ||
-                            g_admin_namelog[ i ]->slot == -1)) {
-            continue;
+        if(found) {
+            bggame->Free(a);
+        } else if(i < MAX_ADMIN_ADMINS) {
+            g_admin_admins[ i ] = a;
+        } else {
+            bggame->Free(a);
         }
 
-        if(!Q_stricmp(client->pers.ip, g_admin_namelog[ i ]->ip) &&
-                !Q_stricmp(client->pers.guid, g_admin_namelog[ i ]->guid)) {
-            for(j = 0; j < MAX_ADMIN_NAMELOG_NAMES &&
-                    g_admin_namelog[ i ]->name[ j ][ 0 ]; j++) {
-                idSGameCmds::SanitiseString(g_admin_namelog[ i ]->name[ j ], n2,
-                                            sizeof(n2));
+        return;
+    }
 
-                if(!Q_stricmp(n1, n2)) {
-                    break;
-                }
-            }
+    for(i = 0; i < MAX_ADMIN_BANS && g_admin_bans[ i ]; i++);
 
-            if(j == MAX_ADMIN_NAMELOG_NAMES) {
-                j = MAX_ADMIN_NAMELOG_NAMES - 1;
-            }
+    if(number >= 1 && number <= i) {
+        *g_admin_bans[ number - 1 ] = *b;
+        bggame->Free(b);
+    } else if(number == i + 1 && i < MAX_ADMIN_BANS) {
+        g_admin_bans[ i ] = b;
+    } else {
+        COM_ParseWarning("ban #%d does not follow the %d loaded", number, i);
+        bggame->Free(b);
+    }
+}
 
-            Q_strncpyz(g_admin_namelog[ i ]->name[ j ], client->pers.netname,
-                       sizeof(g_admin_namelog[ i ]->name[ j ]));
-            g_admin_namelog[ i ]->slot = (disconnect) ? -1 : clientNum;
+/*
+===============
+idAdminLocal::AdminReplayJournal
 
-            // if this player is connecting, they are no longer banned
-            if(!disconnect) {
-                g_admin_namelog[i]->banned = false;
-            }
+Applies the changes made since g_admin was last written, returning how
+many there were
+===============
+*/
+sint idAdminLocal::AdminReplayJournal(void) {
+    g_admin_admin_t *a = nullptr;
+    g_admin_ban_t *b = nullptr;
+    fileHandle_t f;
+    sint len, number = 0, records = 0;
+    valueType *cnf, *cnf2, *t;
 
-            return;
+    len = trap_FS_FOpenFile(AdminJournalName(), &f, FS_READ);
+
+    if(len <= 0) {
+        if(len == 0) {
+            trap_FS_FCloseFile(f);
         }
-    }
 
-    if(i >= MAX_ADMIN_NAMELOGS) {
-        idSGameMain::Printf("idAdminLocal::AdminNamelogUpdate: warning, g_admin_namelogs overflow\n");
-        return;
+        return 0;
     }
 
-    namelog = (g_admin_namelog_t *)bggame->Alloc(sizeof(g_admin_namelog_t));
-    ::memset(namelog, 0, sizeof(namelog));
+    cnf = (valueType *)bggame->Alloc(len + 1);
+    cnf2 = cnf;
+    trap_FS_Read(cnf, len, f);
+    *(cnf + len) = '\0';
+    trap_FS_FCloseFile(f);
+
+    COM_BeginParseSession(AdminJournalName());
+
+    while(1) {
+        t = COM_Parse(&cnf);
+
+        // a record is complete once the next one starts
+        if(!*t || !Q_stricmp(t, "[admin]") || !Q_stricmp(t, "[ban]")) {
+            if(a || b) {
+                AdminReplayRecord(a, b, number);
+                records++;
+            }
+
+            a = nullptr;
+            b = nullptr;
+        }
+
+        if(!*t) {
+            break;
+        }
 
-    for(j = 0; j < MAX_ADMIN_NAMELOG_NAMES; j++) {
-        namelog->name[j][0] = '\0';
+        if(!Q_stricmp(t, "[admin]")) {
+            a = (g_admin_admin_t *)bggame->Alloc(sizeof(g_admin_admin_t));
+        } else if(!Q_stricmp(t, "[ban]")) {
+            b = (g_admin_ban_t *)bggame->Alloc(sizeof(g_admin_ban_t));
+            number = 0;
+        } else if(a) {
+            if(!AdminReadAdminField(&cnf, t, a)) {
+                COM_ParseError("[admin] unrecognized token \"%s\"", t);
+            }
+        } else if(b) {
+            if(!Q_stricmp(t, "number")) {
+                AdminReadConfigInt(&cnf, &number);
+            } else if(!AdminReadBanField(&cnf, t, b)) {
+                COM_ParseError("[ban] unrecognized token \"%s\"", t);
+            }
+        } else {
+            COM_ParseError("unexpected token \"%s\"", t);
+        }
     }
 
-    Q_strncpyz(namelog->ip, client->pers.ip, sizeof(namelog->ip));
-    Q_strncpyz(namelog->guid, client->pers.guid, sizeof(namelog->guid));
-    Q_strncpyz(namelog->name[ 0 ], client->pers.netname,
-               sizeof(namelog->name[ 0 ]));
+    bggame->Free(cnf2);
 
-    namelog->slot = (disconnect) ? -1 : clientNum;
-    g_admin_namelog[ i ] = namelog;
+    // compact them into g_admin when the game ends
+    g_admin_journalUsed = (records > 0);
+
+    return records;
 }
 
 /*
@@ -1220,6 +2145,8 @@ bool idAdminLocal::AdminReadconfig(gentity_t *ent, sint skiparg) {
     bool level_open, admin_open, ban_open, command_open;
     sint i;
 
+    // don't lose changes that haven't been saved yet
+    adminLocal.AdminFlushConfig();
     adminLocal.AdminCleanup();
 
     if(!g_admin.string[ 0 ]) {
@@ -1234,6 +2161,12 @@ bool idAdminLocal::AdminReadconfig(gentity_t *ent, sint skiparg) {
         idSGameMain::Printf("^3!readconfig: ^7could not open admin config file %s\n",
                             g_admin.string);
         adminLocal.AdminDefaultLevels();
+        i = adminLocal.AdminReplayJournal();
+
+        if(i) {
+            adminLocal.ADMP(va("^3!readconfig: ^7replayed %d journal records\n", i));
+        }
+
         return false;
     }
 
@@ -1303,35 +2236,11 @@ bool idAdminLocal::AdminReadconfig(gentity_t *ent, sint skiparg) {
                 COM_ParseError("[level] unrecognized token \"%s\"", t);
             }
         } else if(admin_open) {
-            if(!Q_stricmp(t, "name")) {
-                adminLocal.AdminReadConfigString(&cnf, a->name, sizeof(a->name));
-            } else if(!Q_stricmp(t, "guid")) {
-                adminLocal.AdminReadConfigString(&cnf, a->guid, sizeof(a->guid));
-            } else if(!Q_stricmp(t, "level")) {
-                adminLocal.AdminReadConfigInt(&cnf, &a->level);
-            } else if(!Q_stricmp(t, "flags")) {
-                adminLocal.AdminReadConfigString(&cnf, a->flags, sizeof(a->flags));
-            } else if(!Q_stricmp(t, "counter")) {
-                adminLocal.AdminReadConfigInt(&cnf, &a->counter);
-            } else {
+            if(!adminLocal.AdminReadAdminField(&cnf, t, a)) {
                 COM_ParseError("[admin] unrecognized token \"%s\"", t);
             }
         } else if(ban_open) {
-            if(!Q_stricmp(t, "name")) {
-                adminLocal.AdminReadConfigString(&cnf, b->name, sizeof(b->name));
-            } else if(!Q_stricmp(t, "guid")) {
-                adminLocal.AdminReadConfigString(&cnf, b->guid, sizeof(b->guid));
-            } else if(!Q_stricmp(t, "ip")) {
-                adminLocal.AdminReadConfigString(&cnf, b->ip, sizeof(b->ip));
-            } else if(!Q_stricmp(t, "reason")) {
-                adminLocal.AdminReadConfigString(&cnf, b->reason, sizeof(b->reason));
-            } else if(!Q_stricmp(t, "made")) {
-                adminLocal.AdminReadConfigString(&cnf, b->made, sizeof(b->made));
-            } else if(!Q_stricmp(t, "expires")) {
-                adminLocal.AdminReadConfigInt(&cnf, &b->expires);
-            } else if(!Q_stricmp(t, "banner")) {
-                adminLocal.AdminReadConfigString(&cnf, b->banner, sizeof(b->banner));
-            } else {
+            if(!adminLocal.AdminReadBanField(&cnf, t, b)) {
                 COM_ParseError("[ban] unrecognized token \"%s\"", t);
             }
         } else if(command_open) {
@@ -1386,6 +2295,12 @@ bool idAdminLocal::AdminReadconfig(gentity_t *ent, sint skiparg) {
         }
     }
 
+    i = adminLocal.AdminReplayJournal();
+
+    if(i) {
+        adminLocal.ADMP(va("^3!readconfig: ^7replayed %d journal records\n", i));
+    }
+
     // reset adminLevel
     for(i = 0; i < level.maxclients; i++) {
         if(level.clients[i].pers.connected != CON_DISCONNECTED) {
@@ -1583,7 +2498,7 @@ bool idAdminLocal::AdminSetlevel(gentity_t *ent, sint skiparg) {
     if(!g_admin.string[0]) {
         adminLocal.ADMP("^3!setlevel: ^7WARNING g_admin not set, not saving admin record to a file\n");
     } else {
-        adminLocal.AdminWriteConfig();
+        adminLocal.AdminJournalAdmin(a);
     }
 
     return true;
@@ -1644,6 +2559,7 @@ bool idAdminLocal::AdminCreateBan(gentity_t *ent, valueType *netname,
     }
 
     g_admin_bans[ i ] = b;
+    AdminJournalBan(i);
     return true;
 }
 
@@ -1747,10 +2663,6 @@ bool idAdminLocal::AdminKick(gentity_t *ent, sint skiparg) {
                               adminLocal.AdminParseTime(va("1s%s", g_adminTempBan.string)),
                               (*reason) ? reason : "kicked by admin");
 
-    if(g_admin.string[0]) {
-        adminLocal.AdminWriteConfig();
-    }
-
     trap_SendServerCommand(pids[ 0 ],
                            va("disconnect \"You have been kicked.\n%s^7\nreason:\n%s\"",
                               (ent) ? va("admin:\n%s", ent->client->pers.netname) : "",
@@ -1776,9 +2688,9 @@ bool idAdminLocal::AdminBan(gentity_t *ent, sint skiparg) {
     sint minargc;
     valueType duration[ 32 ];
     sint logmatch = -1, logmatches = 0;
-    sint i, j;
+    sint matches[ MAX_ADMIN_NAMELOGS ], nummatches = 0;
+    sint i, j, k;
     bool exactmatch = false;
-    valueType n2[ MAX_NAME_LENGTH ];
     valueType s2[ MAX_NAME_LENGTH ];
     valueType guid_stub[ 9 ];
 
@@ -1835,33 +2747,24 @@ bool idAdminLocal::AdminBan(gentity_t *ent, sint skiparg) {
         }
     }
 
-    for(i = 0; !exactmatch && i < MAX_ADMIN_NAMELOGS &&
-            g_admin_namelog[ i ]; i++) {
+    if(!exactmatch && (i = adminLocal.AdminNamelogFindIP(search)) >= 0) {
+        logmatches = 1;
+        logmatch = i;
+        exactmatch = true;
+    }
+
+    if(!exactmatch) {
+        nummatches = adminLocal.AdminNamelogSearch(s2, matches);
+    }
+
+    for(k = 0; k < nummatches; k++) {
         // skip players in the namelog who have already been banned
-        if(g_admin_namelog[i]->banned) {
+        if(g_admin_namelog[ matches[ k ] ]->banned) {
             continue;
         }
 
-        if(!Q_stricmp(g_admin_namelog[ i ]->ip, search)) {
-            logmatches = 1;
-            logmatch = i;
-            exactmatch = true;
-            break;
-        }
-
-        for(j = 0; j < MAX_ADMIN_NAMELOG_NAMES &&
-                g_admin_namelog[ i ]->name[ j ][ 0 ]; j++) {
-            idSGameCmds::SanitiseString(g_admin_namelog[ i ]->name[ j ], n2,
-                                        sizeof(n2));
-
-            if(strstr(n2, s2)) {
-                if(logmatch != i) {
-                    logmatches++;
-                }
-
-                logmatch = i;
-            }
-        }
+        logmatches++;
+        logmatch = matches[ k ];
     }
 
     if(!logmatches) {
@@ -1873,7 +2776,9 @@ bool idAdminLocal::AdminBan(gentity_t *ent, sint skiparg) {
         adminLocal.ADMBP_begin();
         adminLocal.ADMBP("^3!ban: ^7multiple recent clients match name, use IP or slot#:\n");
 
-        for(i = 0; i < MAX_ADMIN_NAMELOGS && g_admin_namelog[ i ]; i++) {
+        for(k = 0; k < nummatches; k++) {
+            i = matches[ k ];
+
             for(j = 0; j < 8; j++) {
                 guid_stub[ j ] = g_admin_namelog[ i ]->guid[ j + 24 ];
             }
@@ -1882,10 +2787,7 @@ bool idAdminLocal::AdminBan(gentity_t *ent, sint skiparg) {
 
             for(j = 0; j < MAX_ADMIN_NAMELOG_NAMES &&
                     g_admin_namelog[ i ]->name[ j ][ 0 ]; j++) {
-                idSGameCmds::SanitiseString(g_admin_namelog[ i ]->name[ j ], n2,
-                                            sizeof(n2));
-
-                if(strstr(n2, s2)) {
+                if(strstr(g_admin_namelog[ i ]->sanitised[ j ], s2)) {
                     if(g_admin_namelog[i]->slot > -1) {
                         adminLocal.ADMBP("^3");
                     }
@@ -1923,8 +2825,6 @@ bool idAdminLocal::AdminBan(gentity_t *ent, sint skiparg) {
 
     if(!g_admin.string[0]) {
         adminLocal.ADMP("^3!ban: ^7WARNING g_admin not set, not saving ban to a file\n");
-    } else {
-        adminLocal.AdminWriteConfig();
     }
 
     if(g_admin_namelog[ logmatch ]->slot == -1) {
@@ -1984,7 +2884,7 @@ bool idAdminLocal::AdminUnBan(gentity_t *ent, sint skiparg) {
           (ent) ? ent->client->pers.netname : "console"));
 
     if(g_admin.string[0]) {
-        adminLocal.AdminWriteConfig();
+        adminLocal.AdminJournalBan(bnum - 1);
     }
 
     return true;
@@ -2085,7 +2985,7 @@ bool idAdminLocal::AdminAdjustBan(gentity_t *ent, sint skiparg) {
     }
 
     if(g_admin.string[0]) {
-        adminLocal.AdminWriteConfig();
+        adminLocal.AdminJournalBan(bnum - 1);
     }
 
     return true;
@@ -3178,12 +4078,11 @@ idAdminLocal::AdminNameLog
 ===============
 */
 bool idAdminLocal::AdminNameLog(gentity_t *ent, sint skiparg) {
-    sint i, j;
+    sint i, j, k;
     valueType search[ MAX_NAME_LENGTH ] = {""};
     valueType s2[ MAX_NAME_LENGTH ] = {""};
-    valueType n2[ MAX_NAME_LENGTH ] = {""};
     valueType guid_stub[ 9 ];
-    bool found = false;
+    sint matches[ MAX_ADMIN_NAMELOGS ], nummatches;
     sint printed = 0;
 
     if(idSGameCmds::SayArgc() > 1 + skiparg) {
@@ -3191,28 +4090,13 @@ bool idAdminLocal::AdminNameLog(gentity_t *ent, sint skiparg) {
         idSGameCmds::SanitiseString(search, s2, sizeof(s2));
     }
 
-    adminLocal.ADMBP_begin();
-
-    for(i = 0; i < MAX_ADMIN_NAMELOGS && g_admin_namelog[ i ]; i++) {
-        if(search[ 0 ]) {
-            found = false;
-
-            for(j = 0; j < MAX_ADMIN_NAMELOG_NAMES &&
-                    g_admin_namelog[ i ]->name[ j ][ 0 ]; j++) {
-                idSGameCmds::SanitiseString(g_admin_namelog[ i ]->name[ j ], n2,
-                                            sizeof(n2));
-
-                if(strstr(n2, s2)) {
-                    found = true;
-                    break;
-                }
-            }
+    // with no name given, every entry matches
+    nummatches = adminLocal.AdminNamelogSearch(s2, matches);
 
-            if(!found) {
-                continue;
-            }
-        }
+    adminLocal.ADMBP_begin();
 
+    for(k = 0; k < nummatches; k++) {
+        i = matches[ k ];
         printed++;
 
         for(j = 0; j < 8; j++) {
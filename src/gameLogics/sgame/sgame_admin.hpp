@@ -42,7 +42,7 @@
 #define MAX_ADMIN_LEVELS 32
 #define MAX_ADMIN_ADMINS 1024
 #define MAX_ADMIN_BANS 1024
-#define MAX_ADMIN_NAMELOGS 128
+#define MAX_ADMIN_NAMELOGS 1024
 #define MAX_ADMIN_NAMELOG_NAMES 5
 #define MAX_ADMIN_FLAGS 64
 #define MAX_ADMIN_COMMANDS 64
@@ -129,10 +129,15 @@ typedef struct g_admin_command {
 
 typedef struct g_admin_namelog {
     valueType name[ MAX_ADMIN_NAMELOG_NAMES ][MAX_NAME_LENGTH ];
+    valueType sanitised[ MAX_ADMIN_NAMELOG_NAMES ][MAX_NAME_LENGTH ];
     valueType ip[ 40 ];
     valueType guid[ 33 ];
     sint slot;
     bool banned;
+    sint hashNext;      // next entry with the same guid and ip hash
+    sint ipNext;        // next entry with the same ip hash
+    sint older, newer;  // order in which the entries were last seen
+    bool indexed;       // its names are in the trigram index
 } g_admin_namelog_t;
 
 typedef struct g_admin_adminlog {
@@ -150,14 +155,24 @@ typedef struct g_admin_adminlog {
 //
 class idAdminLocal {
 public:
-    bool AdminBanCheck(valueType *userinfo, valueType *reason, sint rlen);
+    bool AdminBanCheck(const infoView_t *userinfo, valueType *reason, sint rlen);
     bool AdminCmdCheck(gentity_t *ent, bool say);
     static bool AdminReadconfig(gentity_t *ent, sint skiparg);
     void AdminWriteConfig(void);
+    void AdminFlushConfig(void);
+    void AdminJournal(pointer record);
+    void AdminJournalAdmin(g_admin_admin_t *a);
+    void AdminJournalBan(sint i);
+    void AdminReplayRecord(g_admin_admin_t *a, g_admin_ban_t *b, sint number);
+    sint AdminReplayJournal(void);
     bool AdminPermission(gentity_t *ent, valueType flag);
     bool AdminNameCheck(gentity_t *ent, valueType *name, valueType *err,
                         sint len);
     void AdminNamelogUpdate(gclient_t *ent, bool disconnect);
+    sint AdminNamelogFindIP(valueType *ip);
+    sint AdminNamelogSearch(pointer name, sint *list);
+    void AdminNamelogRead(void);
+    void AdminNamelogWrite(void);
     g_admin_admin_t *Admin(gentity_t *ent);
     sint AdminParseTime(pointer time);
 
@@ -200,8 +215,11 @@ public:
     bool AdminHigher(gentity_t *admin, gentity_t *victim);
     void AdminWriteConfigString(valueType *s, fileHandle_t f);
     void AdminWriteConfigInt(sint v, fileHandle_t f);
+    void AdminWriteConfigRaw(pointer s, sint len, fileHandle_t f);
     void AdminReadConfigString(valueType **cnf, valueType *s, sint size);
     void AdminReadConfigInt(valueType **cnf, sint *v);
+    bool AdminReadAdminField(valueType **cnf, pointer t, g_admin_admin_t *a);
+    bool AdminReadBanField(valueType **cnf, pointer t, g_admin_ban_t *b);
     void AdminDefaultLevels(void);
     bool AdminCommandPermission(gentity_t *ent, valueType *command);
     void AdminLog(gentity_t *admin, valueType *cmd, sint skiparg);
@@ -100,6 +100,10 @@ void trap_Cvar_Update(vmConvar_t *cvar) {
     imports->cvarSystem->Update(cvar);
 }
 
+convar_t *trap_Cvar_Find(pointer var_name) {
+    return imports->cvarSystem->FindVar(var_name);
+}
+
 void trap_Cvar_Set(pointer var_name, pointer value) {
     imports->cvarSystem->Set(var_name, value);
 }
@@ -440,6 +440,401 @@ bool idSGameBuildable::FindOvermind(gentity_t *self) {
     return false;
 }
 
+/*
+================
+Creep field
+
+Alien buildables are indexed by the columns of the map they can affect,
+so finding the creep under a point or the buildables slowing a human only
+looks at the sources of one or a few cells. The field is rebuilt after a
+buildable is built or its creep has receded; in between, sources are
+checked against their entity when looked up, so dead ones are skipped and
+ones that have moved more than the slack force a rebuild.
+================
+*/
+
+#define CREEP_CELL_SIZE     256
+#define CREEP_CELL_SLACK    32
+#define CREEP_FIELD_HASH    1024
+#define MAX_CREEP_SOURCES   MAX_GENTITIES
+#define MAX_CREEP_CELLS     4096
+#define MAX_CREEP_LINKS     8192
+
+typedef struct {
+    sint       entityNum;
+    sint       buildable;
+    vec3_t     origin;
+    bool       creep;           // an egg or the overmind
+    sint       creepSize;       // half size of the box it slows humans in
+} creepSource_t;
+
+typedef struct {
+    sint       x, y;
+    sint       next;            // next cell in the hash bucket
+    sint       creep;           // first link of each list, -1 if none
+    sint       slow;
+} creepCell_t;
+
+typedef struct {
+    sint       source;
+    sint       next;
+} creepLink_t;
+
+static creepSource_t creepSources[ MAX_CREEP_SOURCES ];
+static sint          numCreepSources;
+static creepCell_t   creepCells[ MAX_CREEP_CELLS ];
+static sint          numCreepCells;
+static sint          creepCellHash[ CREEP_FIELD_HASH ];
+static creepLink_t   creepLinks[ MAX_CREEP_LINKS ];
+static sint          numCreepLinks;
+static bool          creepFieldOverflow;
+
+/*
+================
+idSGameBuildable::CreepCellCoord
+================
+*/
+sint idSGameBuildable::CreepCellCoord(float32 v) {
+    return (sint)floor(v / CREEP_CELL_SIZE);
+}
+
+/*
+================
+idSGameBuildable::CreepCell
+
+Returns the cell at x, y, adding it if add is set, or -1
+================
+*/
+sint idSGameBuildable::CreepCell(sint x, sint y, bool add) {
+    sint hash = ((x * 73856093) ^ (y * 19349663)) & (CREEP_FIELD_HASH - 1);
+    sint i;
+
+    for(i = creepCellHash[ hash ]; i >= 0; i = creepCells[ i ].next) {
+        if(creepCells[ i ].x == x && creepCells[ i ].y == y) {
+            return i;
+        }
+    }
+
+    if(!add || numCreepCells >= MAX_CREEP_CELLS) {
+        return -1;
+    }
+
+    i = numCreepCells++;
+    creepCells[ i ].x = x;
+    creepCells[ i ].y = y;
+    creepCells[ i ].creep = creepCells[ i ].slow = -1;
+    creepCells[ i ].next = creepCellHash[ hash ];
+    creepCellHash[ hash ] = i;
+
+    return i;
+}
+
+/*
+================
+idSGameBuildable::LinkCreepSource
+
+Adds a source to the creep or slow list of every cell within range of it
+================
+*/
+void idSGameBuildable::LinkCreepSource(sint source, float32 range,
+                                       bool creep) {
+    creepSource_t *src = &creepSources[ source ];
+    sint          x, y, cell, *head;
+    sint          x0 = CreepCellCoord(src->origin[ 0 ] - range - CREEP_CELL_SLACK);
+    sint          x1 = CreepCellCoord(src->origin[ 0 ] + range + CREEP_CELL_SLACK);
+    sint          y0 = CreepCellCoord(src->origin[ 1 ] - range - CREEP_CELL_SLACK);
+    sint          y1 = CreepCellCoord(src->origin[ 1 ] + range + CREEP_CELL_SLACK);
+
+    for(x = x0; x <= x1; x++) {
+        for(y = y0; y <= y1; y++) {
+            cell = CreepCell(x, y, true);
+
+            if(cell < 0 || numCreepLinks >= MAX_CREEP_LINKS) {
+                creepFieldOverflow = true;
+                return;
+            }
+
+            head = creep ? &creepCells[ cell ].creep : &creepCells[ cell ].slow;
+            creepLinks[ numCreepLinks ].source = source;
+            creepLinks[ numCreepLinks ].next = *head;
+            *head = numCreepLinks++;
+        }
+    }
+}
+
+/*
+================
+idSGameBuildable::BuildCreepField
+================
+*/
+void idSGameBuildable::BuildCreepField(void) {
+    sint      i;
+    gentity_t *ent;
+    creepSource_t *src;
+
+    numCreepSources = numCreepCells = numCreepLinks = 0;
+    creepFieldOverflow = false;
+    ::memset(creepCellHash, -1, sizeof(creepCellHash));
+
+    for(i = MAX_CLIENTS, ent = g_entities + i; i < level.num_entities;
+            i++, ent++) {
+        if(!ent->inuse || ent->s.eType != ET_BUILDABLE ||
+                ent->buildableTeam != TEAM_ALIENS || ent->health <= 0) {
+            continue;
+        }
+
+        src = &creepSources[ numCreepSources ];
+        src->entityNum = i;
+        src->buildable = ent->s.modelindex;
+        VectorCopy(ent->s.origin, src->origin);
+        src->creep = (ent->s.modelindex == BA_A_SPAWN ||
+                      ent->s.modelindex == BA_A_OVERMIND);
+        src->creepSize = bggame->Buildable((buildable_t)ent->s.modelindex)->creepSize;
+
+        if(src->creep || src->creepSize > 0) {
+            numCreepSources++;
+        }
+    }
+
+    // link in reverse so each cell lists its sources in entity order
+    for(i = numCreepSources - 1; i >= 0; i--) {
+        if(creepSources[ i ].creep) {
+            LinkCreepSource(i, CREEP_BASESIZE, true);
+        }
+
+        if(creepSources[ i ].creepSize > 0) {
+            LinkCreepSource(i, creepSources[ i ].creepSize, false);
+        }
+    }
+
+    level.creepFieldValid = true;
+}
+
+/*
+================
+idSGameBuildable::CreepSourceEntity
+
+Returns the entity of a source if it is still alive where it was indexed,
+invalidating the field if it has moved too far
+================
+*/
+gentity_t *idSGameBuildable::CreepSourceEntity(sint source) {
+    creepSource_t *src = &creepSources[ source ];
+    gentity_t     *ent = &g_entities[ src->entityNum ];
+
+    if(!ent->inuse || ent->s.eType != ET_BUILDABLE ||
+            ent->s.modelindex != src->buildable || ent->health <= 0) {
+        return nullptr;
+    }
+
+    if(fabs(ent->s.origin[ 0 ] - src->origin[ 0 ]) > CREEP_CELL_SLACK ||
+            fabs(ent->s.origin[ 1 ] - src->origin[ 1 ]) > CREEP_CELL_SLACK) {
+        level.creepFieldValid = false;
+    }
+
+    return ent;
+}
+
+/*
+================
+idSGameBuildable::CreepSourceForPoint
+
+Returns the closest egg or overmind within creep range of origin
+================
+*/
+gentity_t *idSGameBuildable::CreepSourceForPoint(vec3_t origin) {
+    sint      i, link, cell, attempt, distance, minDistance;
+    gentity_t *ent, *closestSpawn;
+    vec3_t    temp_v;
+
+    for(attempt = 0; attempt < 2; attempt++) {
+        if(!level.creepFieldValid) {
+            BuildCreepField();
+        }
+
+        closestSpawn = nullptr;
+        minDistance = 10000;
+
+        if(creepFieldOverflow) {
+            link = -1;
+            cell = -1;
+        } else {
+            cell = CreepCell(CreepCellCoord(origin[ 0 ]),
+                             CreepCellCoord(origin[ 1 ]), false);
+            link = cell >= 0 ? creepCells[ cell ].creep : -1;
+        }
+
+        for(i = 0; ; i++) {
+            sint source;
+
+            if(creepFieldOverflow) {
+                if(i >= numCreepSources) {
+                    break;
+                }
+
+                if(!creepSources[ i ].creep) {
+                    continue;
+                }
+
+                source = i;
+            } else {
+                if(link < 0) {
+                    break;
+                }
+
+                source = creepLinks[ link ].source;
+                link = creepLinks[ link ].next;
+            }
+
+            if((ent = CreepSourceEntity(source)) == nullptr || !ent->spawned) {
+                continue;
+            }
+
+            VectorSubtract(origin, ent->s.origin, temp_v);
+            distance = VectorLength(temp_v);
+
+            if(distance < minDistance) {
+                closestSpawn = ent;
+                minDistance = distance;
+            }
+        }
+
+        if(level.creepFieldValid) {
+            break;
+        }
+    }
+
+    if(minDistance <= CREEP_BASESIZE) {
+        return closestSpawn;
+    }
+
+    return nullptr;
+}
+
+/*
+================
+idSGameBuildable::CreepSlowsPlayer
+
+Is a player standing in the creep of an alien buildable
+================
+*/
+bool idSGameBuildable::CreepSlowsPlayer(gentity_t *player) {
+    sint      i, x, y, link, cell, source, attempt;
+    gentity_t *ent;
+    bool      slowed;
+
+    for(attempt = 0; attempt < 2; attempt++) {
+        if(!level.creepFieldValid) {
+            BuildCreepField();
+        }
+
+        slowed = false;
+
+        if(creepFieldOverflow) {
+            for(i = 0; i < numCreepSources && !slowed; i++) {
+                if(creepSources[ i ].creepSize > 0 &&
+                        (ent = CreepSourceEntity(i)) != nullptr) {
+                    slowed = CreepBoxTouches(ent, player);
+                }
+            }
+        } else {
+            for(x = CreepCellCoord(player->r.absmin[ 0 ]);
+                    x <= CreepCellCoord(player->r.absmax[ 0 ]) && !slowed; x++) {
+                for(y = CreepCellCoord(player->r.absmin[ 1 ]);
+                        y <= CreepCellCoord(player->r.absmax[ 1 ]) && !slowed; y++) {
+                    if((cell = CreepCell(x, y, false)) < 0) {
+                        continue;
+                    }
+
+                    for(link = creepCells[ cell ].slow; link >= 0 && !slowed;
+                            link = creepLinks[ link ].next) {
+                        source = creepLinks[ link ].source;
+
+                        if((ent = CreepSourceEntity(source)) != nullptr) {
+                            slowed = CreepBoxTouches(ent, player);
+                        }
+                    }
+                }
+            }
+        }
+
+        if(slowed || level.creepFieldValid) {
+            break;
+        }
+    }
+
+    return slowed;
+}
+
+/*
+================
+idSGameBuildable::CreepBoxTouches
+
+Does the player touch the box a buildable slows humans in
+================
+*/
+bool idSGameBuildable::CreepBoxTouches(gentity_t *self, gentity_t *player) {
+    float32 creepSize = (float32)bggame->Buildable((buildable_t)
+                        self->s.modelindex)->creepSize;
+    sint    i;
+
+    for(i = 0; i < 3; i++) {
+        if(player->r.absmin[ i ] > self->s.origin[ i ] + creepSize ||
+                player->r.absmax[ i ] < self->s.origin[ i ] - creepSize) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+================
+idSGameBuildable::CreepFieldPrint
+
+Dumps the creep field for debugging
+================
+*/
+void idSGameBuildable::CreepFieldPrint(void) {
+    sint      i, link;
+    gentity_t *ent;
+
+    if(!level.creepFieldValid) {
+        BuildCreepField();
+    }
+
+    idSGameMain::Printf("%d sources, %d cells, %d links%s\n", numCreepSources,
+                        numCreepCells, numCreepLinks,
+                        creepFieldOverflow ? " (overflowed, scanning sources)" : "");
+
+    for(i = 0; i < numCreepSources; i++) {
+        ent = CreepSourceEntity(i);
+
+        idSGameMain::Printf("%3d: %-20s %s%s%s\n", creepSources[ i ].entityNum,
+                            bggame->Buildable((buildable_t)creepSources[ i ].buildable)->name,
+                            idSGameUtils::vtos(creepSources[ i ].origin),
+                            creepSources[ i ].creep ? " creep" : "",
+                            !ent ? " dead" : (creepSources[ i ].creep && !ent->spawned) ?
+                            " unspawned" : "");
+    }
+
+    for(i = 0; i < numCreepCells; i++) {
+        idSGameMain::Printf("(%d %d) creep:", creepCells[ i ].x, creepCells[ i ].y);
+
+        for(link = creepCells[ i ].creep; link >= 0; link = creepLinks[ link ].next) {
+            idSGameMain::Printf(" %d", creepSources[ creepLinks[ link ].source ].entityNum);
+        }
+
+        idSGameMain::Printf(" slow:");
+
+        for(link = creepCells[ i ].slow; link >= 0; link = creepLinks[ link ].next) {
+            idSGameMain::Printf(" %d", creepSources[ creepLinks[ link ].source ].entityNum);
+        }
+
+        idSGameMain::Printf("\n");
+    }
+}
+
 /*
 ================
 idSGameBuildable::FindCreep
@@ -448,12 +843,7 @@ attempt to find creep for self, return true if successful
 ================
 */
 bool idSGameBuildable::FindCreep(gentity_t *self) {
-    sint       i;
-    gentity_t *ent;
-    gentity_t *closestSpawn = nullptr;
-    sint       distance = 0;
-    sint       minDistance = 10000;
-    vec3_t    temp_v;
+    gentity_t *closestSpawn;
 
     //don't check for creep if flying through the air
     if(self->s.groundEntityNum == -1) {
@@ -464,26 +854,9 @@ bool idSGameBuildable::FindCreep(gentity_t *self) {
     if(self->client || self->parentNode == nullptr ||
             !self->parentNode->inuse ||
             self->parentNode->health <= 0) {
-        for(i = MAX_CLIENTS, ent = g_entities + i;
-                i < level.num_entities; i++, ent++) {
-            if(ent->s.eType != ET_BUILDABLE) {
-                continue;
-            }
-
-            if((ent->s.modelindex == BA_A_SPAWN ||
-                    ent->s.modelindex == BA_A_OVERMIND) &&
-                    ent->spawned && ent->health > 0) {
-                VectorSubtract(self->s.origin, ent->s.origin, temp_v);
-                distance = VectorLength(temp_v);
+        closestSpawn = CreepSourceForPoint(self->s.origin);
 
-                if(distance < minDistance) {
-                    closestSpawn = ent;
-                    minDistance = distance;
-                }
-            }
-        }
-
-        if(minDistance <= CREEP_BASESIZE) {
+        if(closestSpawn) {
             if(!self->client) {
                 self->parentNode = closestSpawn;
             }
@@ -521,41 +894,6 @@ bool idSGameBuildable::IsCreepHere(vec3_t origin) {
     return FindCreep(&dummy);
 }
 
-/*
-================
-G_CreepSlow
-
-Set any nearby humans' SS_CREEPSLOWED flag
-================
-*/
-void idSGameBuildable::CreepSlow(gentity_t *self) {
-    sint         entityList[ MAX_GENTITIES ];
-    vec3_t      range;
-    vec3_t      mins, maxs;
-    sint         i, num;
-    gentity_t   *enemy;
-    buildable_t buildable = (buildable_t)self->s.modelindex;
-    float32       creepSize = (float32)bggame->Buildable(buildable)->creepSize;
-
-    VectorSet(range, creepSize, creepSize, creepSize);
-
-    VectorAdd(self->s.origin, range, maxs);
-    VectorSubtract(self->s.origin, range, mins);
-
-    //find humans
-    num = trap_EntitiesInBox(mins, maxs, entityList, MAX_GENTITIES);
-
-    for(i = 0; i < num; i++) {
-        enemy = &g_entities[ entityList[ i ] ];
-
-        if(enemy->client && enemy->client->ps.stats[ STAT_TEAM ] == TEAM_HUMANS &&
-                enemy->client->ps.groundEntityNum != ENTITYNUM_NONE) {
-            enemy->client->ps.stats[ STAT_STATE ] |= SS_CREEPSLOWED;
-            enemy->client->lastCreepSlowTime = level.time;
-        }
-    }
-}
-
 /*
 ================
 nullDieFunction
@@ -595,6 +933,7 @@ void idSGameBuildable::AGeneric_CreepRecede(gentity_t *self) {
         self->nextthink = level.time + 500;
     } else { //creep has died
         idSGameUtils::FreeEntity(self);
+        level.creepFieldValid = false;
     }
 }
 
@@ -675,11 +1014,7 @@ void idSGameBuildable::AGeneric_CreepCheck(gentity_t *self) {
             idSGameCombat::Damage(self, nullptr, nullptr, nullptr, nullptr,
                                   self->health, 0, MOD_NOCREEP);
         }
-
-        return;
     }
-
-    CreepSlow(self);
 }
 
 /*
@@ -775,8 +1110,6 @@ void idSGameBuildable::ASpawn_Think(gentity_t *self) {
         }
     }
 
-    CreepSlow(self);
-
     self->nextthink = level.time + bggame->Buildable((buildable_t)
                       self->s.modelindex)->nextthink;
 }
@@ -864,8 +1197,6 @@ void idSGameBuildable::AOvermind_Think(gentity_t *self) {
         self->overmindSpawnsTimer = level.time + OVERMIND_SPAWNS_PERIOD;
     }
 
-    CreepSlow(self);
-
     self->nextthink = level.time + bggame->Buildable((buildable_t)
                       self->s.modelindex)->nextthink;
 }
@@ -2502,7 +2833,7 @@ void idSGameBuildable::BuildableTouchTriggers(gentity_t *ent) {
     VectorSubtract(mins, range, mins);
     VectorAdd(maxs, range, maxs);
 
-    num = trap_EntitiesInBox(mins, maxs, touch, MAX_GENTITIES);
+    num = idSGameActive::TriggersInBox(mins, maxs, touch, MAX_GENTITIES);
 
     VectorAdd(ent->s.origin, bmins, mins);
     VectorAdd(ent->s.origin, bmaxs, maxs);
@@ -3272,6 +3603,64 @@ itemBuildError_t idSGameBuildable::CanBuild(gentity_t *ent,
     return reason;
 }
 
+#define BUILD_PREVIEW_TIME        1000  // recheck for players wandering past
+#define BUILD_PREVIEW_ANGLE_SHIFT 5     // ANGLE2SHORT units per angle step
+
+/*
+================
+idSGameBuildable::CanBuildPreview
+
+CanBuild for the ghost shown to a builder. The result and the buildables
+that would be replaced (MAX_MISC entity numbers, zero padded) are cached
+per client until the builder moves, looks elsewhere, selects something
+else or the base changes.
+================
+*/
+itemBuildError_t idSGameBuildable::CanBuildPreview(gentity_t *ent,
+        buildable_t buildable, sint distance, sint *removal) {
+    buildPreview_t *preview = &ent->client->buildPreview;
+    playerState_t  *ps = &ent->client->ps;
+    sint            key[ BUILD_PREVIEW_KEY ];
+    sint            i;
+    vec3_t          normal, origin;
+
+    bggame->GetClientNormal(ps, normal);
+
+    for(i = 0; i < 3; i++) {
+        key[ i ] = (sint)floor(ps->origin[ i ]);
+        key[ 3 + i ] = (sint)(normal[ i ] * 256.0f);
+    }
+
+    key[ 6 ] = ANGLE2SHORT(ps->viewangles[ PITCH ]) >> BUILD_PREVIEW_ANGLE_SHIFT;
+    key[ 7 ] = ANGLE2SHORT(ps->viewangles[ YAW ]) >> BUILD_PREVIEW_ANGLE_SHIFT;
+    key[ 8 ] = buildable;
+    key[ 9 ] = ps->stats[ STAT_CLASS ];
+
+    if(!preview->valid ||
+            preview->generation != level.buildableGeneration ||
+            level.time - preview->time >= BUILD_PREVIEW_TIME ||
+            ::memcmp(preview->key, key, sizeof(key))) {
+        preview->reason = CanBuild(ent, buildable, distance, origin);
+
+        for(i = 0; i < MAX_MISC; i++) {
+            if(i < level.numBuildablesForRemoval) {
+                preview->removal[ i ] = level.markedBuildables[ i ]->s.number;
+            } else {
+                preview->removal[ i ] = 0;
+            }
+        }
+
+        ::memcpy(preview->key, key, sizeof(key));
+        preview->generation = level.buildableGeneration;
+        preview->time = level.time;
+        preview->valid = true;
+    }
+
+    ::memcpy(removal, preview->removal, sizeof(preview->removal));
+
+    return (itemBuildError_t)preview->reason;
+}
+
 
 /*
 ================
@@ -3494,6 +3883,10 @@ gentity_t *idSGameBuildable::Build(gentity_t *builder,
 
     trap_LinkEntity(built);
 
+    if(built->buildableTeam == TEAM_ALIENS) {
+        level.creepFieldValid = false;
+    }
+
     return built;
 }
 
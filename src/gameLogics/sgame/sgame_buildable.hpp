@@ -53,6 +53,8 @@ public:
                                buildable_t buildable);
     static itemBuildError_t CanBuild(gentity_t *ent, buildable_t buildable,
                                      sint distance, vec3_t origin);
+    static itemBuildError_t CanBuildPreview(gentity_t *ent,
+            buildable_t buildable, sint distance, sint *removal);
     static bool BuildIfValid(gentity_t *ent, buildable_t buildable);
     static void SetBuildableAnim(gentity_t *ent, buildableAnimNumber_t anim,
                                  bool force);
@@ -67,7 +69,15 @@ public:
     static bool FindRepeater(gentity_t *self);
     static gentity_t *RepeaterEntityForPoint(vec3_t origin);
     static bool IsCreepHere(vec3_t origin);
-    static void CreepSlow(gentity_t *self);
+    static sint CreepCellCoord(float32 v);
+    static sint CreepCell(sint x, sint y, bool add);
+    static void LinkCreepSource(sint source, float32 range, bool creep);
+    static void BuildCreepField(void);
+    static gentity_t *CreepSourceEntity(sint source);
+    static gentity_t *CreepSourceForPoint(vec3_t origin);
+    static bool CreepBoxTouches(gentity_t *self, gentity_t *player);
+    static bool CreepSlowsPlayer(gentity_t *player);
+    static void CreepFieldPrint(void);
     static void nullDieFunction(gentity_t *self, gentity_t *inflictor,
                                 gentity_t *attacker, sint damage, sint mod);
     static void AGeneric_CreepRecede(gentity_t *self);
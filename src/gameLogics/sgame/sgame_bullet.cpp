@@ -0,0 +1,625 @@
+////////////////////////////////////////////////////////////////////////////////////////
+// Copyright(C) 2018 - 2021 Dusan Jocic <dusanjocic@msn.com>
+//
+// This file is part of OpenWolf.
+//
+// OpenWolf is free software; you can redistribute it
+// and / or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 3 of the License,
+// or (at your option) any later version.
+//
+// OpenWolf is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenWolf; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110 - 1301  USA
+//
+// -------------------------------------------------------------------------------------
+// File name:   sgame_bullet.cpp
+// Created:
+// Compilers:   Microsoft (R) C/C++ Optimizing Compiler Version 19.26.28806 for x64,
+//              gcc (Ubuntu 9.3.0-10ubuntu2) 9.3.0
+// Description: Bullet rigid body backend for corpses and physics objects
+// -------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include <sgame/sgame_precompiled.hpp>
+
+#include <btBulletDynamicsCommon.h>
+#include <BulletCollision/CollisionDispatch/btSimulationIslandManager.h>
+#include <LinearMath/btGeometryUtil.h>
+#include <BulletMultiThreaded/btParallelConstraintSolver.h>
+#if defined(_WIN32)
+#include <BulletMultiThreaded/Win32ThreadSupport.h>
+#else
+#include <BulletMultiThreaded/PosixThreadSupport.h>
+#endif
+
+// the world is simulated in game units at a fixed rate; a corpse falling at
+// a few thousand units per second must not pass through a 16 unit brush
+// between two steps, so the step is kept well below a server frame
+#define BULLET_STEP         ( 1.0f / 100.0f )
+#define BULLET_MAX_STEPS    8
+#define BULLET_MAX_THREADS  8
+#define BULLET_MASS         1.0f
+#define BULLET_FRICTION     0.5f
+
+// the speed the trace path stops bouncing at, so bodies come to rest at
+// about the same time with either backend
+#define BULLET_SLEEP_SPEED  10.0f
+
+// brushes the trace path clips corpses against
+#define BULLET_MASK         ( CONTENTS_SOLID | CONTENTS_PLAYERCLIP )
+
+static btDefaultCollisionConfiguration *bulletConfig;
+static btCollisionDispatcher *bulletDispatcher;
+static btBroadphaseInterface *bulletBroadphase;
+static btConstraintSolver *bulletSolver;
+static btThreadSupportInterface *bulletThreads;
+static btDiscreteDynamicsWorld *bulletWorld;
+static btRigidBody *bulletWorldBody;
+
+// one compound of convex hulls per bsp model, [0] is the world; the
+// bundled bullet frees a compound's children along with it
+static btAlignedObjectArray<btCompoundShape *> bulletModels;
+static sint bulletNumHulls;
+
+// where each body was last written back to its entity, so that anything
+// moving the entity outside the simulation (movers, SetOrigin) is noticed
+static vec3_t bulletOrigin[ MAX_GENTITIES ];
+static vec3_t bulletAngles[ MAX_GENTITIES ];
+
+// from the entity origin to the centre of its box
+static vec3_t bulletOffset[ MAX_GENTITIES ];
+
+/*
+===============
+idSGameBullet::idSGameBullet
+===============
+*/
+idSGameBullet::idSGameBullet(void) {
+}
+
+/*
+===============
+idSGameBullet::~idSGameBullet
+===============
+*/
+idSGameBullet::~idSGameBullet(void) {
+}
+
+/*
+===============
+idSGameBullet::LoadModels
+
+Builds a compound of convex hulls from the solid brushes of every model in
+the map's bsp
+===============
+*/
+bool idSGameBullet::LoadModels(pointer mapName) {
+    fileHandle_t f;
+    sint i, j, k, len, numModels, numBrushes, numSides, numPlanes, numShaders;
+    valueType *buffer;
+    dheader_t *header;
+    dmodel_t *models;
+    dbrush_t *brushes, *brush;
+    dbrushside_t *sides;
+    dplane_t *planes, *plane;
+    dshader_t *shaders;
+    btAlignedObjectArray<btVector3> planeEquations, vertices;
+    btCompoundShape *compound;
+    btConvexHullShape *hull;
+    btTransform identity;
+
+    len = trap_FS_FOpenFile(va("maps/%s.bsp", mapName), &f, FS_READ);
+
+    if(len <= 0) {
+        if(len == 0) {
+            trap_FS_FCloseFile(f);
+        }
+
+        idSGameMain::Printf(S_COLOR_YELLOW "WARNING: Bullet physics can't read maps/%s.bsp\n",
+                            mapName);
+        return false;
+    }
+
+    buffer = (valueType *)btAlignedAlloc(len, 16);
+    trap_FS_Read(buffer, len, f);
+    trap_FS_FCloseFile(f);
+
+    header = (dheader_t *)buffer;
+
+    if(len < sizeof(dheader_t) || header->ident != BSP_IDENT ||
+            (header->version != Q3_BSP_VERSION &&
+             header->version != WOLF_BSP_VERSION)) {
+        idSGameMain::Printf(S_COLOR_YELLOW "WARNING: maps/%s.bsp is not a bsp\n",
+                            mapName);
+        btAlignedFree(buffer);
+        return false;
+    }
+
+    for(i = 0; i < HEADER_LUMPS; i++) {
+        if(header->lumps[ i ].fileofs < 0 || header->lumps[ i ].filelen < 0 ||
+                header->lumps[ i ].fileofs + header->lumps[ i ].filelen > len) {
+            idSGameMain::Printf(S_COLOR_YELLOW "WARNING: maps/%s.bsp is truncated\n",
+                                mapName);
+            btAlignedFree(buffer);
+            return false;
+        }
+    }
+
+    models = (dmodel_t *)(buffer + header->lumps[ LUMP_MODELS ].fileofs);
+    numModels = header->lumps[ LUMP_MODELS ].filelen / sizeof(dmodel_t);
+    brushes = (dbrush_t *)(buffer + header->lumps[ LUMP_BRUSHES ].fileofs);
+    numBrushes = header->lumps[ LUMP_BRUSHES ].filelen / sizeof(dbrush_t);
+    sides = (dbrushside_t *)(buffer + header->lumps[ LUMP_BRUSHSIDES ].fileofs);
+    numSides = header->lumps[ LUMP_BRUSHSIDES ].filelen / sizeof(dbrushside_t);
+    planes = (dplane_t *)(buffer + header->lumps[ LUMP_PLANES ].fileofs);
+    numPlanes = header->lumps[ LUMP_PLANES ].filelen / sizeof(dplane_t);
+    shaders = (dshader_t *)(buffer + header->lumps[ LUMP_SHADERS ].fileofs);
+    numShaders = header->lumps[ LUMP_SHADERS ].filelen / sizeof(dshader_t);
+
+    identity.setIdentity();
+    bulletNumHulls = 0;
+
+    for(i = 0; i < numModels; i++) {
+        compound = new btCompoundShape();
+        bulletModels.push_back(compound);
+
+        for(j = 0; j < models[ i ].numBrushes; j++) {
+            k = models[ i ].firstBrush + j;
+
+            if(k < 0 || k >= numBrushes) {
+                break;
+            }
+
+            brush = &brushes[ k ];
+
+            if(brush->shaderNum < 0 || brush->shaderNum >= numShaders ||
+                    !(shaders[ brush->shaderNum ].contentFlags & BULLET_MASK) ||
+                    brush->firstSide < 0 || brush->numSides < 4 ||
+                    brush->firstSide + brush->numSides > numSides) {
+                continue;
+            }
+
+            // a brush is the space behind all of its planes; bullet keeps
+            // the points where n.p + d <= 0, so d is the negated distance
+            planeEquations.resize(0);
+
+            for(k = 0; k < brush->numSides; k++) {
+                if(sides[ brush->firstSide + k ].planeNum < 0 ||
+                        sides[ brush->firstSide + k ].planeNum >= numPlanes) {
+                    break;
+                }
+
+                plane = &planes[ sides[ brush->firstSide + k ].planeNum ];
+                planeEquations.push_back(btVector3(plane->normal[ 0 ],
+                                                   plane->normal[ 1 ], plane->normal[ 2 ]));
+                planeEquations[ k ][ 3 ] = -plane->dist;
+            }
+
+            if(k < brush->numSides) {
+                continue;
+            }
+
+            vertices.resize(0);
+            btGeometryUtil::getVerticesFromPlaneEquations(planeEquations, vertices);
+
+            if(vertices.size() < 4) {
+                continue;
+            }
+
+            hull = new btConvexHullShape(&vertices[ 0 ].getX(), vertices.size());
+            compound->addChildShape(identity, hull);
+            bulletNumHulls++;
+        }
+    }
+
+    btAlignedFree(buffer);
+
+    return numModels > 0;
+}
+
+/*
+===============
+idSGameBullet::Init
+===============
+*/
+void idSGameBullet::Init(pointer mapName) {
+    sint threads;
+    btTransform transform;
+
+    if(!g_physics.integer) {
+        return;
+    }
+
+    if(!LoadModels(mapName)) {
+        Shutdown();
+        idSGameMain::Printf("Bullet physics unavailable, using traces\n");
+        return;
+    }
+
+    bulletConfig = new btDefaultCollisionConfiguration();
+    bulletDispatcher = new btCollisionDispatcher(bulletConfig);
+    bulletBroadphase = new btDbvtBroadphase();
+
+    threads = Com_Clampi(0, BULLET_MAX_THREADS, g_physicsThreads.integer);
+
+    if(threads > 1) {
+#if defined(_WIN32)
+        Win32ThreadSupport::Win32ThreadConstructionInfo info("solver",
+                SolverThreadFunc, SolverlsMemoryFunc, threads);
+        bulletThreads = new Win32ThreadSupport(info);
+#else
+        PosixThreadSupport::ThreadConstructionInfo info((valueType *)"solver",
+                SolverThreadFunc, SolverlsMemoryFunc, threads);
+        bulletThreads = new PosixThreadSupport(info);
+#endif
+        bulletSolver = new btParallelConstraintSolver(bulletThreads);
+
+        // the parallel solver keeps its own contact pool and solves the
+        // whole world as one island
+        bulletDispatcher->setDispatcherFlags(
+            btCollisionDispatcher::CD_DISABLE_CONTACTPOOL_DYNAMIC_ALLOCATION);
+    } else {
+        bulletSolver = new btSequentialImpulseConstraintSolver();
+    }
+
+    bulletWorld = new btDiscreteDynamicsWorld(bulletDispatcher, bulletBroadphase,
+            bulletSolver, bulletConfig);
+    bulletWorld->setGravity(btVector3(0.0f, 0.0f, -g_gravity.value));
+
+    if(bulletThreads) {
+        bulletWorld->getSimulationIslandManager()->setSplitIslands(false);
+        bulletWorld->getSolverInfo().m_solverMode = SOLVER_SIMD |
+                SOLVER_USE_WARMSTARTING;
+    }
+
+    // restitution and friction multiply, so the world passes each
+    // entity's own bounce through
+    transform.setIdentity();
+    bulletWorldBody = new btRigidBody(0.0f, new btDefaultMotionState(transform),
+                                      bulletModels[ 0 ]);
+    bulletWorldBody->setRestitution(1.0f);
+    bulletWorldBody->setFriction(1.0f);
+    bulletWorld->addRigidBody(bulletWorldBody);
+
+    UpdateEntities();
+
+    idSGameMain::Printf("Bullet physics: %i models, %i brushes, %s solver\n",
+                        bulletModels.size(), bulletNumHulls,
+                        bulletThreads ? va("%i thread", threads) : "sequential");
+}
+
+/*
+===============
+idSGameBullet::Shutdown
+===============
+*/
+void idSGameBullet::Shutdown(void) {
+    sint i;
+
+    if(bulletWorld) {
+        for(i = 0; i < MAX_GENTITIES; i++) {
+            RemoveEntity(&g_entities[ i ]);
+        }
+
+        bulletWorld->removeRigidBody(bulletWorldBody);
+        delete bulletWorldBody->getMotionState();
+        delete bulletWorldBody;
+        bulletWorldBody = nullptr;
+
+        delete bulletWorld;
+        bulletWorld = nullptr;
+    }
+
+    delete bulletSolver;
+    bulletSolver = nullptr;
+    delete bulletThreads;
+    bulletThreads = nullptr;
+    delete bulletBroadphase;
+    bulletBroadphase = nullptr;
+    delete bulletDispatcher;
+    bulletDispatcher = nullptr;
+    delete bulletConfig;
+    bulletConfig = nullptr;
+
+    for(i = 0; i < bulletModels.size(); i++) {
+        delete bulletModels[ i ];
+    }
+
+    bulletModels.clear();
+}
+
+/*
+===============
+idSGameBullet::Active
+===============
+*/
+bool idSGameBullet::Active(void) {
+    return bulletWorld != nullptr;
+}
+
+/*
+===============
+idSGameBullet::EntityTransform
+===============
+*/
+void idSGameBullet::EntityTransform(gentity_t *ent, btTransform &transform) {
+    vec3_t axis[ 3 ];
+
+    AnglesToAxis(ent->r.currentAngles, axis);
+
+    transform.setBasis(btMatrix3x3(axis[ 0 ][ 0 ], axis[ 1 ][ 0 ], axis[ 2 ][ 0 ],
+                                   axis[ 0 ][ 1 ], axis[ 1 ][ 1 ], axis[ 2 ][ 1 ],
+                                   axis[ 0 ][ 2 ], axis[ 1 ][ 2 ], axis[ 2 ][ 2 ]));
+    transform.setOrigin(btVector3(ent->r.currentOrigin[ 0 ],
+                                  ent->r.currentOrigin[ 1 ], ent->r.currentOrigin[ 2 ]));
+}
+
+/*
+===============
+idSGameBullet::AddEntity
+
+Corpses and physics objects are boxes that never turn, so that their
+bounds keep matching what they were linked with
+===============
+*/
+void idSGameBullet::AddEntity(gentity_t *ent) {
+    sint i, num = ent - g_entities;
+    btVector3 halfExtents, inertia;
+    btTransform transform;
+    btBoxShape *shape;
+    btRigidBody *body;
+
+    for(i = 0; i < 3; i++) {
+        halfExtents[ i ] = MAX(0.5f * (ent->r.maxs[ i ] - ent->r.mins[ i ]), 1.0f);
+        bulletOffset[ num ][ i ] = 0.5f * (ent->r.maxs[ i ] + ent->r.mins[ i ]);
+    }
+
+    shape = new btBoxShape(halfExtents);
+    shape->calculateLocalInertia(BULLET_MASS, inertia);
+
+    transform.setIdentity();
+    transform.setOrigin(btVector3(ent->r.currentOrigin[ 0 ] + bulletOffset[ num ][ 0 ],
+                                  ent->r.currentOrigin[ 1 ] + bulletOffset[ num ][ 1 ],
+                                  ent->r.currentOrigin[ 2 ] + bulletOffset[ num ][ 2 ]));
+
+    btRigidBody::btRigidBodyConstructionInfo info(BULLET_MASS,
+            new btDefaultMotionState(transform), shape, inertia);
+    info.m_restitution = ent->physicsBounce;
+    info.m_friction = BULLET_FRICTION;
+    info.m_linearSleepingThreshold = BULLET_SLEEP_SPEED;
+
+    body = new btRigidBody(info);
+    body->setAngularFactor(0.0f);
+    body->setUserPointer(ent);
+
+    if(ent->s.pos.trType != TR_STATIONARY) {
+        body->setLinearVelocity(btVector3(ent->s.pos.trDelta[ 0 ],
+                                          ent->s.pos.trDelta[ 1 ], ent->s.pos.trDelta[ 2 ]));
+    }
+
+    // sweep anything moving more than its smallest extent in a step
+    body->setCcdMotionThreshold(halfExtents[ halfExtents.minAxis() ]);
+    body->setCcdSweptSphereRadius(0.5f * halfExtents[ halfExtents.minAxis() ]);
+
+    bulletWorld->addRigidBody(body);
+
+    ent->body = body;
+    VectorCopy(ent->r.currentOrigin, bulletOrigin[ num ]);
+}
+
+/*
+===============
+idSGameBullet::AddMover
+
+Brush models are kinematic, the mover code keeps moving them and
+bullet only sees where they went
+===============
+*/
+void idSGameBullet::AddMover(gentity_t *ent) {
+    sint num = ent - g_entities;
+    btTransform transform;
+    btRigidBody *body;
+
+    if(ent->s.modelindex <= 0 || ent->s.modelindex >= bulletModels.size() ||
+            !bulletModels[ ent->s.modelindex ]->getNumChildShapes()) {
+        return;
+    }
+
+    EntityTransform(ent, transform);
+
+    body = new btRigidBody(0.0f, new btDefaultMotionState(transform),
+                           bulletModels[ ent->s.modelindex ]);
+    body->setCollisionFlags(body->getCollisionFlags() |
+                            btCollisionObject::CF_KINEMATIC_OBJECT);
+    body->setRestitution(1.0f);
+    body->setFriction(1.0f);
+    body->setUserPointer(ent);
+
+    bulletWorld->addRigidBody(body);
+
+    ent->body = body;
+    VectorCopy(ent->r.currentOrigin, bulletOrigin[ num ]);
+    VectorCopy(ent->r.currentAngles, bulletAngles[ num ]);
+}
+
+/*
+===============
+idSGameBullet::RemoveEntity
+===============
+*/
+void idSGameBullet::RemoveEntity(gentity_t *ent) {
+    btRigidBody *body = ent->body;
+
+    if(!body) {
+        return;
+    }
+
+    bulletWorld->removeRigidBody(body);
+    delete body->getMotionState();
+
+    // movers share their model's shape
+    if(!body->isKinematicObject()) {
+        delete body->getCollisionShape();
+    }
+
+    delete body;
+    ent->body = nullptr;
+}
+
+/*
+===============
+idSGameBullet::UpdateEntities
+
+Follows brush models and anything that was moved outside the simulation
+===============
+*/
+void idSGameBullet::UpdateEntities(void) {
+    sint i;
+    gentity_t *ent;
+    btRigidBody *body;
+    btTransform transform;
+
+    for(i = 0, ent = g_entities; i < level.num_entities; i++, ent++) {
+        if(!ent->inuse) {
+            continue;
+        }
+
+        body = ent->body;
+
+        if(ent->r.bmodel) {
+            if(!ent->r.linked || !(ent->r.contents & BULLET_MASK)) {
+                RemoveEntity(ent);
+                continue;
+            }
+
+            if(!body) {
+                AddMover(ent);
+                continue;
+            }
+
+            if(VectorCompare(ent->r.currentOrigin, bulletOrigin[ i ]) &&
+                    VectorCompare(ent->r.currentAngles, bulletAngles[ i ])) {
+                continue;
+            }
+
+            // kinematic bodies take their velocity from the motion state,
+            // and wake up whatever is resting on them
+            EntityTransform(ent, transform);
+            body->getMotionState()->setWorldTransform(transform);
+            body->activate(true);
+
+            VectorCopy(ent->r.currentOrigin, bulletOrigin[ i ]);
+            VectorCopy(ent->r.currentAngles, bulletAngles[ i ]);
+        } else if(body && !VectorCompare(ent->r.currentOrigin, bulletOrigin[ i ])) {
+            transform.setIdentity();
+            transform.setOrigin(btVector3(ent->r.currentOrigin[ 0 ] + bulletOffset[ i ][ 0 ],
+                                          ent->r.currentOrigin[ 1 ] + bulletOffset[ i ][ 1 ],
+                                          ent->r.currentOrigin[ 2 ] + bulletOffset[ i ][ 2 ]));
+            body->setWorldTransform(transform);
+            body->getMotionState()->setWorldTransform(transform);
+
+            if(ent->s.pos.trType == TR_STATIONARY) {
+                body->setLinearVelocity(btVector3(0.0f, 0.0f, 0.0f));
+            } else {
+                body->setLinearVelocity(btVector3(ent->s.pos.trDelta[ 0 ],
+                                                  ent->s.pos.trDelta[ 1 ], ent->s.pos.trDelta[ 2 ]));
+            }
+
+            body->activate(true);
+            VectorCopy(ent->r.currentOrigin, bulletOrigin[ i ]);
+        }
+    }
+}
+
+/*
+===============
+idSGameBullet::Step
+===============
+*/
+void idSGameBullet::Step(sint msec) {
+    if(!bulletWorld || msec <= 0) {
+        return;
+    }
+
+    UpdateEntities();
+
+    bulletWorld->setGravity(btVector3(0.0f, 0.0f, -g_gravity.value));
+    bulletWorld->stepSimulation(msec * 0.001f, BULLET_MAX_STEPS, BULLET_STEP);
+}
+
+/*
+===============
+idSGameBullet::Physics
+
+Copies a body's state back to its entity, returns false if the entity is
+left to the trace path
+===============
+*/
+bool idSGameBullet::Physics(gentity_t *ent, sint msec) {
+    sint num = ent - g_entities;
+    btRigidBody *body;
+    btVector3 origin, velocity;
+
+    if(!bulletWorld || ent->s.eType == ET_BUILDABLE) {
+        return false;
+    }
+
+    // a sinking corpse is moved by its think function
+    if(ent->s.eType == ET_CORPSE && ent->active) {
+        RemoveEntity(ent);
+        return false;
+    }
+
+    if(!ent->body) {
+        AddEntity(ent);
+    }
+
+    body = ent->body;
+
+    if(!body->isActive()) {
+        if(ent->s.pos.trType != TR_STATIONARY) {
+            VectorCopy(ent->r.currentOrigin, ent->s.pos.trBase);
+            VectorClear(ent->s.pos.trDelta);
+            ent->s.pos.trType = TR_STATIONARY;
+            ent->s.pos.trTime = level.time;
+            ent->s.groundEntityNum = ENTITYNUM_WORLD;
+            VectorSet(ent->s.origin2, 0.0f, 0.0f, 1.0f);
+        }
+
+        idSGameMain::RunThink(ent);
+        return true;
+    }
+
+    origin = body->getWorldTransform().getOrigin();
+    velocity = body->getLinearVelocity();
+
+    VectorSet(ent->r.currentOrigin, origin.getX() - bulletOffset[ num ][ 0 ],
+              origin.getY() - bulletOffset[ num ][ 1 ],
+              origin.getZ() - bulletOffset[ num ][ 2 ]);
+    VectorCopy(ent->r.currentOrigin, bulletOrigin[ num ]);
+
+    VectorCopy(ent->r.currentOrigin, ent->s.pos.trBase);
+    VectorSet(ent->s.pos.trDelta, velocity.getX(), velocity.getY(),
+              velocity.getZ());
+    ent->s.pos.trType = TR_GRAVITY;
+    ent->s.pos.trTime = level.time;
+    ent->s.groundEntityNum = -1;
+
+    trap_LinkEntity(ent);
+
+    idSGameMain::RunThink(ent);
+
+    // if it is in a nodrop volume, remove it
+    if(ent->inuse &&
+            (trap_PointContents(ent->r.currentOrigin, -1) & CONTENTS_NODROP)) {
+        idSGameUtils::FreeEntity(ent);
+    }
+
+    return true;
+}
@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////////////////////
+// Copyright(C) 2018 - 2021 Dusan Jocic <dusanjocic@msn.com>
+//
+// This file is part of OpenWolf.
+//
+// OpenWolf is free software; you can redistribute it
+// and / or modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 3 of the License,
+// or (at your option) any later version.
+//
+// OpenWolf is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenWolf; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110 - 1301  USA
+//
+// -------------------------------------------------------------------------------------
+// File name:   sgame_bullet.hpp
+// Created:
+// Compilers:   Microsoft (R) C/C++ Optimizing Compiler Version 19.26.28806 for x64,
+//              gcc (Ubuntu 9.3.0-10ubuntu2) 9.3.0
+// Description: Bullet rigid body backend for corpses and physics objects
+// -------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __SGAME_BULLET_H__
+#define __SGAME_BULLET_H__
+
+class idSGameLocal;
+class btTransform;
+
+class idSGameBullet : public idSGameLocal {
+public:
+    idSGameBullet();
+    ~idSGameBullet();
+
+    static void Init(pointer mapName);
+    static void Shutdown(void);
+    static bool Active(void);
+    static bool LoadModels(pointer mapName);
+    static void AddEntity(gentity_t *ent);
+    static void AddMover(gentity_t *ent);
+    static void RemoveEntity(gentity_t *ent);
+    static void EntityTransform(gentity_t *ent, btTransform &transform);
+    static void UpdateEntities(void);
+    static void Step(sint msec);
+    static bool Physics(gentity_t *ent, sint msec);
+};
+
+#endif // !__SGAME_BULLET_H__
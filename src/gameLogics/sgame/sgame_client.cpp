@@ -1025,8 +1025,8 @@ void idSGameLocal::ClientUserinfoChanged(sint clientNum) {
     gentity_t *ent;
     sint       health;
     sint       botskill;
-    valueType      *s;
-    valueType      *s2;
+    pointer    value;
+    sint       length;
     valueType      model[ MAX_QPATH ];
     valueType      buffer[ MAX_QPATH ];
     valueType      filename[ MAX_QPATH ];
@@ -1039,6 +1039,7 @@ void idSGameLocal::ClientUserinfoChanged(sint clientNum) {
     valueType      c2[ MAX_INFO_STRING ];
     valueType      userinfo[ MAX_INFO_STRING ];
     valueType buf[MAX_INFO_STRING];
+    infoView_t info;
 
     ent = g_entities + clientNum;
     client = ent->client;
@@ -1050,14 +1051,16 @@ void idSGameLocal::ClientUserinfoChanged(sint clientNum) {
         strcpy(userinfo, "\\name\\badinfo");
     }
 
+    // index the userinfo once for all of the lookups below
+    Info_ParseView(&info, userinfo);
+
     // stickyspec toggle
-    s = Info_ValueForKey(userinfo, "cg_stickySpec");
-    client->pers.stickySpec = atoi(s) != 0;
+    client->pers.stickySpec = Info_ViewInt(&info, "cg_stickySpec") != 0;
 
     // set name
     Q_strncpyz(oldname, client->pers.netname, sizeof(oldname));
-    s = Info_ValueForKey(userinfo, "name");
-    idSGameClient::ClientCleanName(s, newname, sizeof(newname));
+    Info_ViewString(&info, "name", buf, sizeof(buf));
+    idSGameClient::ClientCleanName(buf, newname, sizeof(newname));
 
     if(strcmp(oldname, newname)) {
         if(client->pers.nameChangeTime &&
@@ -1085,8 +1088,12 @@ void idSGameLocal::ClientUserinfoChanged(sint clientNum) {
         if(revertName) {
             Q_strncpyz(client->pers.netname, *oldname ? oldname : "UnnamedPlayer",
                        sizeof(client->pers.netname));
-            Info_SetValueForKey(userinfo, "name", oldname);
-            trap_SetUserinfo(clientNum, userinfo);
+
+            if(!Info_ViewBuild(&info, buf, sizeof(buf), "name", oldname)) {
+                Q_strncpyz(buf, userinfo, sizeof(buf));
+            }
+
+            trap_SetUserinfo(clientNum, buf);
         } else {
             Q_strncpyz(client->pers.netname, newname,
                        sizeof(client->pers.netname));
@@ -1115,7 +1122,7 @@ void idSGameLocal::ClientUserinfoChanged(sint clientNum) {
     }
 
     // set max health
-    health = atoi(Info_ValueForKey(userinfo, "handicap"));
+    health = Info_ViewInt(&info, "handicap");
     client->pers.maxHealth = health;
 
     if(client->pers.classSelection == PCL_NONE) {
@@ -1146,75 +1153,57 @@ void idSGameLocal::ClientUserinfoChanged(sint clientNum) {
     Q_strncpyz(model, buffer, sizeof(model));
 
     // wallwalk follow
-    s = Info_ValueForKey(userinfo, "cg_wwFollow");
-
-    if(atoi(s)) {
+    if(Info_ViewInt(&info, "cg_wwFollow")) {
         client->ps.persistant[ PERS_STATE ] |= PS_WALLCLIMBINGFOLLOW;
     } else {
         client->ps.persistant[ PERS_STATE ] &= ~PS_WALLCLIMBINGFOLLOW;
     }
 
     // wallwalk toggle
-    s = Info_ValueForKey(userinfo, "cg_wwToggle");
-
-    if(atoi(s)) {
+    if(Info_ViewInt(&info, "cg_wwToggle")) {
         client->ps.persistant[ PERS_STATE ] |= PS_WALLCLIMBINGTOGGLE;
     } else {
         client->ps.persistant[ PERS_STATE ] &= ~PS_WALLCLIMBINGTOGGLE;
     }
 
     // always sprint
-    s = Info_ValueForKey(userinfo, "cg_alwaysSprint");
-
-    if(atoi(s)) {
+    if(Info_ViewInt(&info, "cg_alwaysSprint")) {
         client->ps.persistant[ PERS_STATE ] |= PS_ALWAYSSPRINT;
     } else {
         client->ps.persistant[ PERS_STATE ] &= ~PS_ALWAYSSPRINT;
     }
 
     // fly speed
-    s = Info_ValueForKey(userinfo, "cg_flySpeed");
-
-    if(*s) {
-        client->pers.flySpeed = atoi(s);
+    if(Info_ViewFind(&info, "cg_flySpeed", &value, &length) && length) {
+        client->pers.flySpeed = atoi(value);
     } else {
         client->pers.flySpeed = bggame->Class(PCL_NONE)->speed;
     }
 
     // teamInfo
-    s = Info_ValueForKey(userinfo, "teamoverlay");
-    s2 = Info_ValueForKey(userinfo, "cg_drawTeamStatus");
-
-    if(atoi(s) != 0 || atoi(s2) != 0) {
+    if(Info_ViewInt(&info, "teamoverlay") != 0 ||
+            Info_ViewInt(&info, "cg_drawTeamStatus") != 0) {
         client->pers.teamInfo = true;
     } else {
         client->pers.teamInfo = false;
     }
 
-    s = Info_ValueForKey(userinfo, "cg_unlagged");
-
-    if(!s[0] || atoi(s) != 0) {
+    if(!Info_ViewFind(&info, "cg_unlagged", &value, &length) || !length ||
+            atoi(value) != 0) {
         client->pers.useUnlagged = true;
     } else {
         client->pers.useUnlagged = false;
     }
 
     // colors
-    strcpy(c1, Info_ValueForKey(userinfo, "color1"));
-    strcpy(c2, Info_ValueForKey(userinfo, "color2"));
+    Info_ViewString(&info, "color1", c1, sizeof(c1));
+    Info_ViewString(&info, "color2", c2, sizeof(c2));
 
     // bot skill level
-    s = Info_ValueForKey(userinfo, "skill");
-
-    if(!s[0] || atoi(s) == 0) {
-        botskill = 0;
-    } else {
-        botskill = atoi(s);
-    }
-
+    botskill = Info_ViewInt(&info, "skill");
 
-    Q_strncpyz(client->pers.voice, Info_ValueForKey(userinfo, "voice"),
-               sizeof(client->pers.voice));
+    Info_ViewString(&info, "voice", client->pers.voice,
+                    sizeof(client->pers.voice));
 
     // send over a subset of the userinfo keys so other clients can
     // print scoreboards, display models, and play custom sounds
@@ -1253,13 +1242,14 @@ restarts.
 ============
 */
 valueType *idSGameLocal::ClientConnect(sint clientNum, bool firstTime) {
-    valueType      *value;
     gclient_t *client;
     valueType      userinfo[ MAX_INFO_STRING ];
     gentity_t *ent;
     valueType      guid[ 33 ];
     valueType      reason[ MAX_STRING_CHARS ] = {""};
+    valueType      password[ MAX_INFO_VALUE ];
     g_admin_admin_t *admin;
+    infoView_t info;
 
     ent = &g_entities[ clientNum ];
     client = &level.clients[ clientNum ];
@@ -1267,20 +1257,20 @@ valueType *idSGameLocal::ClientConnect(sint clientNum, bool firstTime) {
     ::memset(client, 0, sizeof(*client));
 
     trap_GetUserinfo(clientNum, userinfo, sizeof(userinfo));
+    Info_ParseView(&info, userinfo);
 
-    value = Info_ValueForKey(userinfo, "cl_guid");
-    Q_strncpyz(guid, value, sizeof(guid));
+    Info_ViewString(&info, "cl_guid", guid, sizeof(guid));
 
     // check for admin ban
-    if(adminLocal.AdminBanCheck(userinfo, reason, sizeof(reason))) {
+    if(adminLocal.AdminBanCheck(&info, reason, sizeof(reason))) {
         return va("%s", reason);
     }
 
     // check for a password
-    value = Info_ValueForKey(userinfo, "password");
+    Info_ViewString(&info, "password", password, sizeof(password));
 
     if(g_password.string[ 0 ] && Q_stricmp(g_password.string, "none") &&
-            strcmp(g_password.string, value) != 0) {
+            strcmp(g_password.string, password) != 0) {
         return "Invalid password";
     }
 
@@ -1293,8 +1283,7 @@ valueType *idSGameLocal::ClientConnect(sint clientNum, bool firstTime) {
     }
 
     // save ip
-    value = Info_ValueForKey(userinfo, "ip");
-    Q_strncpyz(client->pers.ip, value, sizeof(client->pers.ip));
+    Info_ViewString(&info, "ip", client->pers.ip, sizeof(client->pers.ip));
 
     // check for local client
     if(!strcmp(client->pers.ip, "localhost")) {
@@ -1308,7 +1297,7 @@ valueType *idSGameLocal::ClientConnect(sint clientNum, bool firstTime) {
 
     // read or initialize the session data
     if(firstTime || level.newSession) {
-        idSGameSession::InitSessionData(client, userinfo);
+        idSGameSession::InitSessionData(client, &info);
     }
 
     idSGameSession::ReadSessionData(client);
@@ -1325,7 +1314,7 @@ valueType *idSGameLocal::ClientConnect(sint clientNum, bool firstTime) {
     }
 
     // count current clients and rank for scoreboard
-    idSGameMain::CalculateRanks();
+    idSGameMain::UpdateRank(clientNum);
 
     // if this is after !restart keepteams or !restart switchteams, apply said selection
     if(client->sess.restartTeam != TEAM_NONE) {
@@ -1412,7 +1401,7 @@ void idSGameLocal::ClientBegin(sint clientNum) {
     idSGameMain::LogPrintf("idSGameLocal::ClientBegin: %i\n", clientNum);
 
     // count current clients and rank for scoreboard
-    idSGameMain::CalculateRanks();
+    idSGameMain::UpdateRank(clientNum);
 }
 
 /*
@@ -1475,7 +1464,7 @@ void idSGameClient::BotBegin(sint clientNum) {
     trap_GetConfigstring(CS_PLAYERS + clientNum, userinfo, sizeof(userinfo));
 
     // count current clients and rank for scoreboard
-    idSGameMain::CalculateRanks();
+    idSGameMain::UpdateRank(clientNum);
 }
 
 /*
@@ -1776,7 +1765,7 @@ void idSGameClient::ClientSpawn(gentity_t *ent, gentity_t *spawn,
     }
 
     // must do this here so the number of active clients is calculated
-    idSGameMain::CalculateRanks();
+    idSGameMain::UpdateRank(index);
 
     // run the presend to set anything else
     if(ent->client->sess.spectatorState != SPECTATOR_FOLLOW) {
@@ -1847,5 +1836,5 @@ void idSGameLocal::ClientDisconnect(sint clientNum) {
 
     trap_SetConfigstring(CS_PLAYERS + clientNum, "");
 
-    idSGameMain::CalculateRanks();
+    idSGameMain::UpdateRank(clientNum);
 }
@@ -2621,7 +2621,7 @@ void idSGameCmds::StopFollowing(gentity_t *ent) {
     //  ent->r.svFlags &= ~SVF_BOT;
     ent->client->ps.clientNum = ent - g_entities;
 
-    idSGameMain::CalculateRanks();
+    idSGameMain::UpdateRank(ent - g_entities);
 }
 
 /*
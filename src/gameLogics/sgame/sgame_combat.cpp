@@ -72,7 +72,7 @@ void idSGameCombat::AddScore(gentity_t *ent, sint score) {
     score = rint((float64) score / 10.0);
 
     ent->client->ps.persistant[ PERS_SCORE ] += score;
-    idSGameMain::CalculateRanks();
+    idSGameMain::UpdateRank(ent - g_entities);
 }
 
 /*
@@ -719,38 +719,76 @@ float32 idSGameCombat::GetNonLocDamageModifier(gentity_t *targ,
 
 /*
 ============
-GetPointDamageModifier
+idSGameCombat::RegionContainsAngle
+============
+*/
+bool idSGameCombat::RegionContainsAngle(damageRegion_t *region,
+                                        float32 angle) {
+    if(region->minAngle <= region->maxAngle) {
+        return angle >= region->minAngle && angle <= region->maxAngle;
+    }
 
-Returns the damage region given an angle and a height proportion
+    return angle <= region->maxAngle || angle >= region->minAngle;
+}
+
+/*
+============
+idSGameCombat::RegionContainsHeight
 ============
 */
-float32 idSGameCombat::GetPointDamageModifier(gentity_t *targ,
-        damageRegion_t *regions, sint len, float32 angle, float32 height) {
+bool idSGameCombat::RegionContainsHeight(damageRegion_t *region,
+        float32 height) {
+    return height >= region->minHeight && height <= region->maxHeight;
+}
+
+/*
+============
+idSGameCombat::PointDamageModifier
+
+Multiplies the modifiers of the regions containing an angle and a height
+proportion
+============
+*/
+float32 idSGameCombat::PointDamageModifier(damageRegion_t *regions, sint len,
+        bool crouch, float32 angle, float32 height) {
     float32 modifier = 1.f;
     sint i;
 
     for(i = 0; i < len; i++) {
-        if(regions[ i ].crouch != (targ->client->ps.pm_flags & PMF_DUCKED)) {
+        if(regions[ i ].crouch != crouch) {
             continue;
         }
 
         // Angle must be within range
-        if((regions[ i ].minAngle <= regions[ i ].maxAngle &&
-                (angle < regions[ i ].minAngle ||
-                 angle > regions[ i ].maxAngle)) ||
-                (regions[ i ].minAngle > regions[ i ].maxAngle &&
-                 angle > regions[ i ].maxAngle && angle < regions[ i ].minAngle)) {
+        if(!RegionContainsAngle(&regions[ i ], angle)) {
             continue;
         }
 
         // Height must be within range
-        if(height < regions[ i ].minHeight || height > regions[ i ].maxHeight) {
+        if(!RegionContainsHeight(&regions[ i ], height)) {
             continue;
         }
 
         modifier *= regions[ i ].modifier;
     }
 
+    return modifier;
+}
+
+/*
+============
+GetPointDamageModifier
+
+Returns the damage region given an angle and a height proportion
+============
+*/
+float32 idSGameCombat::GetPointDamageModifier(gentity_t *targ,
+        damageRegion_t *regions, sint len, float32 angle, float32 height) {
+    float32 modifier;
+
+    modifier = PointDamageModifier(regions, len,
+                                   targ->client->ps.pm_flags & PMF_DUCKED, angle, height);
+
     if(g_debugDamage.integer) {
         idSGameMain::Printf("GetDamageRegionModifier(angle = %f, height = %f): %f\n",
                             angle, height, modifier);
@@ -759,6 +797,277 @@ float32 idSGameCombat::GetPointDamageModifier(gentity_t *targ,
     return modifier;
 }
 
+#define MAX_DAMAGE_TABLE_MODIFIERS 65536
+
+static damageTable_t g_damageTables[ PCL_NUM_CLASSES ];
+static damageTable_t g_armourTables[ UP_NUM_UPGRADES ];
+static float32       damageTableModifiers[ MAX_DAMAGE_TABLE_MODIFIERS ];
+static sint          numDamageTableModifiers;
+
+/*
+============
+idSGameCombat::BakeDamageTable
+
+Resolves a region list for every height and whole angle. Heights are split
+at the region bounds into rows: one for each bound and one for each gap
+between bounds. Angles with the same set of regions share a column. Each
+cell is the product GetPointDamageModifier would return, multiplied in the
+same order.
+============
+*/
+void idSGameCombat::BakeDamageTable(damageTable_t *table,
+                                    damageRegion_t *regions, sint len) {
+    sint     i, j, k, row, column, crouch;
+    uint32   angleMasks[ MAX_DAMAGE_BOUNDS + 1 ], heightMask, mask;
+    float32  height, lo, hi, modifier, *modifiers;
+
+    ::memset(table, 0, sizeof(*table));
+
+    // sorted, unique region heights
+    for(i = 0; i < len; i++) {
+        float32 bound[ 2 ] = { regions[ i ].minHeight, regions[ i ].maxHeight };
+
+        for(j = 0; j < 2; j++) {
+            for(k = 0; k < table->numBounds && table->bounds[ k ] < bound[ j ]; k++);
+
+            if(k < table->numBounds && table->bounds[ k ] == bound[ j ]) {
+                continue;
+            }
+
+            ::memmove(&table->bounds[ k + 1 ], &table->bounds[ k ],
+                      (table->numBounds - k) * sizeof(table->bounds[ 0 ]));
+            table->bounds[ k ] = bound[ j ];
+            table->numBounds++;
+        }
+    }
+
+    table->numRows = table->numBounds * 2 + 1;
+
+    // angles with the same regions share a column
+    for(i = 0; i < DAMAGE_ANGLES; i++) {
+        mask = 0;
+
+        for(j = 0; j < len; j++) {
+            if(RegionContainsAngle(&regions[ j ], i)) {
+                mask |= 1 << j;
+            }
+        }
+
+        for(column = 0; column < table->numColumns; column++) {
+            if(angleMasks[ column ] == mask) {
+                break;
+            }
+        }
+
+        if(column == table->numColumns) {
+            if(column > MAX_DAMAGE_BOUNDS) {
+                return;
+            }
+
+            angleMasks[ table->numColumns++ ] = mask;
+        }
+
+        table->angleColumns[ i ] = column;
+    }
+
+    // height bins that contain no bound resolve to a single row
+    for(i = 0; i < DAMAGE_HEIGHT_BINS; i++) {
+        lo = (float32)i / DAMAGE_HEIGHT_BINS - 0.001f;
+        hi = (float32)(i + 1) / DAMAGE_HEIGHT_BINS + 0.001f;
+
+        for(j = 0; j < table->numBounds && table->bounds[ j ] < lo; j++);
+
+        if(j < table->numBounds && table->bounds[ j ] <= hi) {
+            table->heightRows[ i ] = DAMAGE_ROW_SEARCH;
+        } else {
+            table->heightRows[ i ] = j * 2;
+        }
+    }
+
+    if(numDamageTableModifiers + 2 * table->numRows * table->numColumns >
+            MAX_DAMAGE_TABLE_MODIFIERS) {
+        return;
+    }
+
+    modifiers = &damageTableModifiers[ numDamageTableModifiers ];
+    numDamageTableModifiers += 2 * table->numRows * table->numColumns;
+
+    for(row = 0; row < table->numRows; row++) {
+        // a height representative of the row
+        if(row & 1) {
+            height = table->bounds[ row / 2 ];
+        } else if(!table->numBounds) {
+            height = 0.f;
+        } else if(row == 0) {
+            height = table->bounds[ 0 ] - 1.f;
+        } else if(row == table->numRows - 1) {
+            height = table->bounds[ table->numBounds - 1 ] + 1.f;
+        } else {
+            height = (table->bounds[ row / 2 - 1 ] + table->bounds[ row / 2 ]) * 0.5f;
+        }
+
+        heightMask = 0;
+
+        for(j = 0; j < len; j++) {
+            if(RegionContainsHeight(&regions[ j ], height)) {
+                heightMask |= 1 << j;
+            }
+        }
+
+        for(crouch = 0; crouch < 2; crouch++) {
+            for(column = 0; column < table->numColumns; column++) {
+                modifier = 1.f;
+                mask = heightMask & angleMasks[ column ];
+
+                for(j = 0; j < len; j++) {
+                    if((mask & (1 << j)) && regions[ j ].crouch == crouch) {
+                        modifier *= regions[ j ].modifier;
+                    }
+                }
+
+                modifiers[(crouch * table->numRows + row) * table->numColumns +
+                          column ] = modifier;
+            }
+        }
+    }
+
+    table->modifiers = modifiers;
+}
+
+/*
+============
+idSGameCombat::DamageTableRow
+============
+*/
+sint idSGameCombat::DamageTableRow(damageTable_t *table, float32 height) {
+    sint bin, i;
+
+    bin = (sint)(height * DAMAGE_HEIGHT_BINS);
+
+    if(bin >= 0 && bin < DAMAGE_HEIGHT_BINS &&
+            table->heightRows[ bin ] != DAMAGE_ROW_SEARCH) {
+        return table->heightRows[ bin ];
+    }
+
+    for(i = 0; i < table->numBounds; i++) {
+        if(height < table->bounds[ i ]) {
+            return i * 2;
+        }
+
+        if(height == table->bounds[ i ]) {
+            return i * 2 + 1;
+        }
+    }
+
+    return i * 2;
+}
+
+/*
+============
+idSGameCombat::TableDamageModifier
+
+PointDamageModifier from a baked table
+============
+*/
+float32 idSGameCombat::TableDamageModifier(damageTable_t *table, bool crouch,
+        sint angle, float32 height) {
+    return table->modifiers[((crouch ? 1 : 0) * table->numRows +
+                             DamageTableRow(table, height)) * table->numColumns +
+                            table->angleColumns[ angle ] ];
+}
+
+/*
+============
+idSGameCombat::GetTableDamageModifier
+
+GetPointDamageModifier from a baked table
+============
+*/
+float32 idSGameCombat::GetTableDamageModifier(gentity_t *targ,
+        damageTable_t *table, damageRegion_t *regions, sint len, sint angle,
+        float32 height) {
+    float32 modifier;
+
+    if(!table->modifiers || angle < 0 || angle >= DAMAGE_ANGLES) {
+        return GetPointDamageModifier(targ, regions, len, angle, height);
+    }
+
+    modifier = TableDamageModifier(table,
+                                   targ->client->ps.pm_flags & PMF_DUCKED, angle, height);
+
+    if(g_debugDamage.integer) {
+        idSGameMain::Printf("GetDamageRegionModifier(angle = %f, height = %f): %f\n",
+                            (float32)angle, height, modifier);
+    }
+
+    return modifier;
+}
+
+/*
+============
+idSGameCombat::CheckDamageTable
+
+Compares a baked table against the region list for every whole angle,
+both crouch states and a grid of heights that includes each region bound
+and the heights just around it. Returns the number of mismatches.
+============
+*/
+sint idSGameCombat::CheckDamageTable(damageTable_t *table,
+                                     damageRegion_t *regions, sint len, pointer name) {
+    sint    angle, crouch, i, j, numHeights, mismatches = 0;
+    float32 heights[ DAMAGE_HEIGHT_BINS * 4 + 1 + MAX_DAMAGE_BOUNDS * 3 ];
+    float32 point, baked;
+
+    if(!table->modifiers) {
+        if(len) {
+            idSGameMain::Printf(S_COLOR_YELLOW "WARNING: %s: damage table not baked\n",
+                                name);
+        }
+
+        return 0;
+    }
+
+    numHeights = 0;
+
+    for(i = 0; i <= DAMAGE_HEIGHT_BINS * 4; i++) {
+        heights[ numHeights++ ] = (float32)i / (DAMAGE_HEIGHT_BINS * 4);
+    }
+
+    for(i = 0; i < table->numBounds; i++) {
+        heights[ numHeights++ ] = table->bounds[ i ];
+        heights[ numHeights++ ] = nextafterf(table->bounds[ i ], -1.f);
+        heights[ numHeights++ ] = nextafterf(table->bounds[ i ], 2.f);
+    }
+
+    for(crouch = 0; crouch < 2; crouch++) {
+        for(angle = 0; angle < DAMAGE_ANGLES; angle++) {
+            for(j = 0; j < numHeights; j++) {
+                point = PointDamageModifier(regions, len, crouch, angle, heights[ j ]);
+                baked = TableDamageModifier(table, crouch, angle, heights[ j ]);
+
+                if(point == baked) {
+                    continue;
+                }
+
+                if(!mismatches) {
+                    idSGameMain::Printf(S_COLOR_RED "%s: crouch %i angle %i height %f: "
+                                        "regions give %f, table gives %f\n", name, crouch, angle,
+                                        heights[ j ], point, baked);
+                }
+
+                mismatches++;
+            }
+        }
+    }
+
+    if(mismatches) {
+        idSGameMain::Printf(S_COLOR_RED "%s: %i damage table mismatches\n", name,
+                            mismatches);
+    }
+
+    return mismatches;
+}
+
 /*
 ============
 G_CalcDamageModifier
@@ -816,13 +1125,15 @@ float32 idSGameCombat::CalcDamageModifier(vec3_t point, gentity_t *targ,
                                     bulletAngle[ YAW ]);
 
     // Get modifiers from the target's damage regions
-    modifier = GetPointDamageModifier(targ, g_damageRegions[_class],
+    modifier = GetTableDamageModifier(targ, &g_damageTables[_class],
+                                      g_damageRegions[_class],
                                       g_numDamageRegions[_class],
                                       hitRotation, hitRatio);
 
     for(i = UP_NONE + 1; i < UP_NUM_UPGRADES; i++)
         if(bggame->InventoryContainsUpgrade(i, targ->client->ps.stats))
-            modifier *= GetPointDamageModifier(targ, g_armourRegions[ i ],
+            modifier *= GetTableDamageModifier(targ, &g_armourTables[ i ],
+                                               g_armourRegions[ i ],
                                                g_numArmourRegions[ i ],
                                                hitRotation, hitRatio);
 
@@ -839,9 +1150,14 @@ void idSGameCombat::InitDamageLocations(void) {
     valueType          filename[ MAX_QPATH ];
     sint           i;
     sint           len;
+    sint           mismatches = 0;
     fileHandle_t  fileHandle;
     valueType          buffer[ MAX_DAMAGE_REGION_TEXT ];
 
+    ::memset(g_damageTables, 0, sizeof(g_damageTables));
+    ::memset(g_armourTables, 0, sizeof(g_armourTables));
+    numDamageTableModifiers = 0;
+
     for(i = PCL_NONE + 1; i < PCL_NUM_CLASSES; i++) {
         modelName = bggame->ClassConfig((class_t)i)->modelName;
         Q_vsprintf_s(filename, sizeof(filename), sizeof(filename),
@@ -867,6 +1183,13 @@ void idSGameCombat::InitDamageLocations(void) {
         trap_FS_FCloseFile(fileHandle);
 
         g_numDamageRegions[ i ] = ParseDmgScript(g_damageRegions[ i ], buffer);
+        BakeDamageTable(&g_damageTables[ i ], g_damageRegions[ i ],
+                        g_numDamageRegions[ i ]);
+
+        if(g_debugDamage.integer) {
+            mismatches += CheckDamageTable(&g_damageTables[ i ], g_damageRegions[ i ],
+                                           g_numDamageRegions[ i ], filename);
+        }
     }
 
     for(i = UP_NONE + 1; i < UP_NUM_UPGRADES; i++) {
@@ -894,6 +1217,18 @@ void idSGameCombat::InitDamageLocations(void) {
         trap_FS_FCloseFile(fileHandle);
 
         g_numArmourRegions[ i ] = ParseDmgScript(g_armourRegions[ i ], buffer);
+        BakeDamageTable(&g_armourTables[ i ], g_armourRegions[ i ],
+                        g_numArmourRegions[ i ]);
+
+        if(g_debugDamage.integer) {
+            mismatches += CheckDamageTable(&g_armourTables[ i ], g_armourRegions[ i ],
+                                           g_numArmourRegions[ i ], filename);
+        }
+    }
+
+    if(g_debugDamage.integer) {
+        idSGameMain::Printf("damage tables checked against their regions: %i mismatches\n",
+                            mismatches);
     }
 }
 
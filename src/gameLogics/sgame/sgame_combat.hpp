@@ -61,8 +61,21 @@ public:
     static float32 GetRegionDamageModifier(gentity_t *targ, sint _class,
                                            sint piece);
     static float32 GetNonLocDamageModifier(gentity_t *targ, sint _class);
+    static float32 PointDamageModifier(damageRegion_t *regions, sint len,
+                                       bool crouch, float32 angle, float32 height);
     static float32 GetPointDamageModifier(gentity_t *targ,
                                           damageRegion_t *regions, sint len, float32 angle, float32 height);
+    static bool RegionContainsAngle(damageRegion_t *region, float32 angle);
+    static bool RegionContainsHeight(damageRegion_t *region, float32 height);
+    static void BakeDamageTable(damageTable_t *table, damageRegion_t *regions,
+                                sint len);
+    static sint DamageTableRow(damageTable_t *table, float32 height);
+    static float32 TableDamageModifier(damageTable_t *table, bool crouch,
+                                       sint angle, float32 height);
+    static float32 GetTableDamageModifier(gentity_t *targ, damageTable_t *table,
+                                          damageRegion_t *regions, sint len, sint angle, float32 height);
+    static sint CheckDamageTable(damageTable_t *table, damageRegion_t *regions,
+                                 sint len, pointer name);
     static float32 CalcDamageModifier(vec3_t point, gentity_t *targ,
                                       gentity_t *attacker, sint _class, sint dflags);
     static void InitDamageLocations(void);
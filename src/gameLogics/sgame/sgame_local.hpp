@@ -289,6 +289,12 @@ struct gentity_s {
 
     bool
     pointAgainstWorld;              // don't use the bbox for map collisions
+
+    trajectory_t       missilePath;  // s.pos the clear time was predicted for
+    sint
+    missileClearTime;               // path is clear of the world until then
+    bool
+    missileBlocked;                 // and reaches the world at that time
 };
 
 typedef enum {
@@ -395,6 +401,18 @@ typedef struct unlagged_s {
     bool    used;
 } unlagged_t;
 
+// a cached idSGameBuildable::CanBuild result for the build preview
+#define BUILD_PREVIEW_KEY 10
+
+typedef struct buildPreview_s {
+    bool valid;
+    sint generation;                // level.buildableGeneration when checked
+    sint time;                      // level.time when checked
+    sint key[ BUILD_PREVIEW_KEY ];  // quantised builder position and view
+    sint reason;                    // itemBuildError_t
+    sint removal[ MAX_MISC ];       // buildables that building would replace
+} buildPreview_t;
+
 // this structure is cleared on each ClientSpawn(),
 // except for 'client->pers' and 'client->sess'
 struct gclient_s {
@@ -499,6 +517,8 @@ struct gclient_s {
     sint                 lcannonStartTime;
 
     sint                 lastCrushTime;        // Tyrant crush
+
+    buildPreview_t      buildPreview;
 };
 
 typedef struct spawnQueue_s {
@@ -522,6 +542,21 @@ typedef struct damageRegion_s {
     bool crouch;
 } damageRegion_t;
 
+// a damage region list baked into a height x angle modifier table
+#define DAMAGE_HEIGHT_BINS    256
+#define DAMAGE_ANGLES         360
+#define MAX_DAMAGE_BOUNDS     ( MAX_DAMAGE_REGIONS * 2 )
+#define DAMAGE_ROW_SEARCH     255   // the height bin holds a region bound
+
+typedef struct damageTable_s {
+    float32 *modifiers;        // [ crouch ][ row ][ column ], nullptr if unbaked
+    sint numRows, numColumns;
+    sint numBounds;
+    float32 bounds[ MAX_DAMAGE_BOUNDS ];        // sorted region heights
+    uchar8 heightRows[ DAMAGE_HEIGHT_BINS ];
+    uchar8 angleColumns[ DAMAGE_ANGLES ];
+} damageTable_t;
+
 //status of the warning of certain events
 typedef enum {
     TW_NOT = 0,
@@ -529,6 +564,14 @@ typedef enum {
     TW_PASSED
 } timeWarning_t;
 
+// what a client was last counted as by idSGameMain::UpdateRank
+typedef struct clientRank_s {
+    bool ranked;    // present in level.sortedClients
+    bool counted;   // fully connected, included in the team counts
+    bool live;      // counted and not spectating
+    team_t team;
+} clientRank_t;
+
 //
 // this structure is cleared as each map is entered
 //
@@ -575,6 +618,10 @@ typedef struct {
     sint
     numPlayingClients;            // connected, non-spectators
     sint               sortedClients[MAX_CLIENTS];   // sorted by score
+    clientRank_t       clientRanks[MAX_CLIENTS];     // set by UpdateRank
+    valueType          rankTeams[MAX_CLIENTS + 1];   // contents of the P cvar
+    bool               rankTeamsModified;            // P needs to be set
+    sint               rankFriendlyFire;             // contents of the ff cvar
 
     sint
     snd_fry;                      // sound index for standing in lava
@@ -593,7 +640,7 @@ typedef struct {
     voteExecuteTime;              // time the vote is executed
     sint               voteYes;
     sint               voteNo;
-    sint               numVotingClients;             // set by CalculateRanks
+    sint               numVotingClients;             // set by UpdateRank
 
     // team voting state
     valueType              teamVoteString[ 2 ][ MAX_STRING_CHARS ];
@@ -602,7 +649,7 @@ typedef struct {
     teamVoteTime[ 2 ];            // level.time vote was called
     sint               teamVoteYes[ 2 ];
     sint               teamVoteNo[ 2 ];
-    sint               numteamVotingClients[ 2 ];    // set by CalculateRanks
+    sint               numteamVotingClients[ 2 ];    // set by UpdateRank
 
     // spawn variables
     bool
@@ -658,6 +705,11 @@ typedef struct {
     gentity_t        *markedBuildables[ MAX_GENTITIES ];
     sint               numBuildablesForRemoval;
 
+    bool              creepFieldValid;      // alien buildables are indexed
+    bool              triggerGridBuilt;     // static triggers are bucketed
+    uint32            buildableSignature;   // state seen by CalculateBuildPoints
+    sint              buildableGeneration;  // bumped when the signature changes
+
     sint               alienKills;
     sint               humanKills;
 
@@ -853,6 +905,8 @@ extern vmConvar_t g_friendlyBuildableFire;
 extern vmConvar_t g_password;
 extern vmConvar_t g_needpass;
 extern vmConvar_t g_gravity;
+extern vmConvar_t g_physics;
+extern vmConvar_t g_physicsThreads;
 extern vmConvar_t g_speed;
 extern vmConvar_t g_knockback;
 extern vmConvar_t g_quadfactor;
@@ -921,6 +975,8 @@ extern vmConvar_t g_adminLog;
 extern vmConvar_t g_adminParseSay;
 extern vmConvar_t g_adminNameProtect;
 extern vmConvar_t g_adminTempBan;
+extern vmConvar_t g_adminNamelog;
+extern vmConvar_t g_adminNamelogSize;
 extern vmConvar_t g_dretchPunt;
 extern vmConvar_t g_privateMessages;
 extern vmConvar_t g_publicAdminMessages;
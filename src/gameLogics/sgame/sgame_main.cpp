@@ -40,9 +40,12 @@ typedef struct {
     valueType *cvarName;
     valueType *defaultString;
     sint cvarFlags;
-    valueType *description;
     sint modificationCount;  // for tracking changes
     bool trackChange;       // track this variable, and announce if changed
+    void (*changed)(void);  // called on the first frame and whenever it changes
+    valueType *description;
+    convar_t *cvar;         // the engine's cvar, to see changes without asking
+    bool initial;           // changed still owes its first frame call
 } cvarTable_t;
 
 gentity_t g_entities[ MAX_GENTITIES ];
@@ -65,6 +68,8 @@ vmConvar_t  g_maxGameClients;
 vmConvar_t  g_dedicated;
 vmConvar_t  g_speed;
 vmConvar_t  g_gravity;
+vmConvar_t  g_physics;
+vmConvar_t  g_physicsThreads;
 vmConvar_t  g_cheats;
 vmConvar_t  g_demoState;
 vmConvar_t  g_knockback;
@@ -141,6 +146,8 @@ vmConvar_t  g_adminLog;
 vmConvar_t  g_adminParseSay;
 vmConvar_t  g_adminNameProtect;
 vmConvar_t  g_adminTempBan;
+vmConvar_t  g_adminNamelog;
+vmConvar_t  g_adminNamelogSize;
 vmConvar_t  g_dretchPunt;
 vmConvar_t  g_privateMessages;
 vmConvar_t  g_publicAdminMessages;
@@ -171,7 +178,7 @@ static cvarTable_t   gameCvarTable[ ] = {
     { &g_maxGameClients, "g_maxGameClients", "0", CVAR_SERVERINFO | CVAR_ARCHIVE, 0, false  },
 
     { &g_timelimit, "timelimit", "0", CVAR_SERVERINFO | CVAR_ARCHIVE | CVAR_NORESTART, 0, true },
-    { &g_suddenDeathTime, "g_suddenDeathTime", "0", CVAR_ARCHIVE | CVAR_NORESTART, 0, true },
+    { &g_suddenDeathTime, "g_suddenDeathTime", "0", CVAR_ARCHIVE | CVAR_NORESTART, 0, true, &idSGameMain::SuddenDeathTimeChanged },
     { &g_suddenDeath, "g_suddenDeath", "0", CVAR_NORESTART, 0, true },
 
     { &g_synchronousClients, "g_synchronousClients", "0", CVAR_SYSTEMINFO, 0, false  },
@@ -189,7 +196,7 @@ static cvarTable_t   gameCvarTable[ ] = {
     { &g_logFile, "g_logFile", "games.log", CVAR_ARCHIVE, 0, false  },
     { &g_logFileSync, "g_logFileSync", "0", CVAR_ARCHIVE, 0, false  },
 
-    { &g_password, "g_password", "", CVAR_USERINFO, 0, false  },
+    { &g_password, "g_password", "", CVAR_USERINFO, 0, false, &idSGameMain::PasswordChanged },
 
     { &g_banIPs, "g_banIPs", "", CVAR_ARCHIVE, 0, false  },
     { &g_filterBan, "g_filterBan", "1", CVAR_ARCHIVE, 0, false  },
@@ -200,6 +207,8 @@ static cvarTable_t   gameCvarTable[ ] = {
     { &g_allowShare, "g_allowShare", "1", CVAR_ARCHIVE | CVAR_SERVERINFO, 0, false },
     { &g_speed, "g_speed", "320", 0, 0, true  },
     { &g_gravity, "g_gravity", "800", 0, 0, true  },
+    { &g_physics, "g_physics", "0", CVAR_LATCH, 0, false  },
+    { &g_physicsThreads, "g_physicsThreads", "0", CVAR_LATCH, 0, false  },
     { &g_knockback, "g_knockback", "1000", 0, 0, true  },
     { &g_quadfactor, "g_quadfactor", "3", 0, 0, true  },
     { &g_weaponRespawn, "g_weaponrespawn", "5", 0, 0, true  },
@@ -254,7 +263,7 @@ static cvarTable_t   gameCvarTable[ ] = {
     { &g_floodMaxDemerits, "g_floodMaxDemerits", "5000", CVAR_ARCHIVE, 0, false  },
     { &g_floodMinTime, "g_floodMinTime", "2000", CVAR_ARCHIVE, 0, false  },
 
-    { &g_markDeconstruct, "g_markDeconstruct", "1", CVAR_SERVERINFO | CVAR_ARCHIVE, 0, false  },
+    { &g_markDeconstruct, "g_markDeconstruct", "1", CVAR_SERVERINFO | CVAR_ARCHIVE, 0, false, &idSGameMain::MarkDeconstructChanged },
 
     { &g_debugMapRotation, "g_debugMapRotation", "0", 0, 0, false  },
     { &g_currentMapRotation, "g_currentMapRotation", "-1", 0, 0, false  }, // -1 = NOT_ROTATING
@@ -276,6 +285,8 @@ static cvarTable_t   gameCvarTable[ ] = {
     { &g_adminParseSay, "g_adminParseSay", "1", CVAR_ARCHIVE, 0, false  },
     { &g_adminNameProtect, "g_adminNameProtect", "1", CVAR_ARCHIVE, 0, false  },
     { &g_adminTempBan, "g_adminTempBan", "2m", CVAR_ARCHIVE, 0, false  },
+    { &g_adminNamelog, "g_adminNamelog", "namelog.dat", CVAR_ARCHIVE, 0, false  },
+    { &g_adminNamelogSize, "g_adminNamelogSize", "256", CVAR_ARCHIVE, 0, false  },
 
     { &g_dretchPunt, "g_dretchPunt", "0", CVAR_ARCHIVE, 0, false  },
 
@@ -411,6 +422,10 @@ void idSGameMain::RegisterCvars(void) {
 
         if(cv->vmCvar) {
             cv->modificationCount = cv->vmCvar->modificationCount;
+            cv->cvar = trap_Cvar_Find(cv->cvarName);
+
+            // have UpdateCvars call it on the first frame, unannounced
+            cv->initial = (cv->changed != nullptr);
         }
     }
 
@@ -421,25 +436,54 @@ void idSGameMain::RegisterCvars(void) {
 /*
 =================
 idSGameMain::UpdateCvars
+
+Only cvars whose modification count moved are updated, the engine's
+cvars live in our address space so that costs no calls for the rest
 =================
 */
 void idSGameMain::UpdateCvars(void) {
-    sint         i;
-    cvarTable_t *cv;
+    sint         i, numChanged = 0;
+    cvarTable_t *cv, *changed[ ARRAY_LEN(gameCvarTable) ];
 
     for(i = 0, cv = gameCvarTable; i < gameCvarTableSize; i++, cv++) {
-        if(cv->vmCvar) {
-            trap_Cvar_Update(cv->vmCvar);
+        if(!cv->vmCvar) {
+            continue;
+        }
+
+        if(!cv->initial && cv->cvar &&
+                cv->cvar->modificationCount == cv->vmCvar->modificationCount &&
+                cv->modificationCount == cv->vmCvar->modificationCount) {
+            continue;
+        }
 
-            if(cv->modificationCount != cv->vmCvar->modificationCount) {
-                if(cv->trackChange) {
-                    trap_SendServerCommand(-1, va("print \"Server: %s changed to %s\n\"",
-                                                  cv->cvarName, cv->vmCvar->string));
+        trap_Cvar_Update(cv->vmCvar);
 
-                    // update serverinfo in case this cvar is passed to clients indirectly
-                    CalculateRanks();
-                }
-            }
+        if(cv->initial || cv->modificationCount != cv->vmCvar->modificationCount) {
+            cv->modificationCount = cv->vmCvar->modificationCount;
+            changed[ numChanged++ ] = cv;
+        }
+    }
+
+    for(i = 0; i < numChanged; i++) {
+        cv = changed[ i ];
+
+        // the first frame call only seeds the callback, nothing changed yet
+        if(cv->initial) {
+            cv->initial = false;
+            cv->changed();
+            continue;
+        }
+
+        if(cv->trackChange) {
+            trap_SendServerCommand(-1, va("print \"Server: %s changed to %s\n\"",
+                                          cv->cvarName, cv->vmCvar->string));
+
+            // update serverinfo in case this cvar is passed to clients indirectly
+            UpdateRankCvars();
+        }
+
+        if(cv->changed) {
+            cv->changed();
         }
     }
 }
@@ -561,6 +605,7 @@ void idSGameLocal::Init(sint levelTime, sint randomSeed, sint restart) {
     trap_Cvar_Set("g_mapConfigsLoaded", "0");
 
     adminLocal.AdminReadconfig(nullptr, 0);
+    adminLocal.AdminNamelogRead();
 
     // initialize all entities for this game
     ::memset(g_entities, 0, MAX_GENTITIES * sizeof(g_entities[0]));
@@ -570,6 +615,7 @@ void idSGameLocal::Init(sint levelTime, sint randomSeed, sint restart) {
     level.maxclients = g_maxclients.integer;
     ::memset(g_clients, 0, MAX_CLIENTS * sizeof(g_clients[0]));
     level.clients = g_clients;
+    idSGameMain::InitRanks();
 
     // set client fields on player ents
     for(i = 0; i < level.maxclients; i++) {
@@ -595,14 +641,18 @@ void idSGameLocal::Init(sint levelTime, sint randomSeed, sint restart) {
     // parse the key/value pairs and spawn gentities
     idSGameSpawn::SpawnEntitiesFromString();
 
+    // bucket the map's triggers for touch lookups
+    idSGameActive::BuildTriggerGrid();
+
     // load up a custom building layout if there is one
     idSGameBuildable::LayoutLoad();
 
     // the map might disable some things
     bggame->InitAllowedGameElements();
 
-    //Init bullet physics
+    // corpses and physics objects as rigid bodies, or traces if g_physics is 0
     trap_Cvar_VariableStringBuffer("mapname", mapName, sizeof(mapName));
+    idSGameBullet::Init(mapName);
 
     // general initialization
     idSGameMain::FindTeams();
@@ -677,9 +727,13 @@ void idSGameLocal::Shutdown(sint restart) {
     // write all the client session data so we can get it back
     idSGameSession::WriteSessionData();
 
+    adminLocal.AdminWriteConfig();
     adminLocal.AdminCleanup();
+    adminLocal.AdminNamelogWrite();
     adminLocal.AdminNamelogCleanup();
 
+    idSGameBullet::Shutdown();
+
     level.restarted = false;
     level.surrenderTeam = TEAM_NONE;
     trap_SetConfigstring(CS_WINNER, "");
@@ -723,29 +777,6 @@ PLAYER COUNTING / SCORE SORTING
 */
 
 
-/*
-=============
-idSGameMain::SortRanks
-=============
-*/
-sint idSGameMain::SortRanks(const void *a, const void *b) {
-    gclient_t *ca, *cb;
-
-    ca = &level.clients[ *(sint *)a ];
-    cb = &level.clients[ *(sint *)b ];
-
-    // then sort by score
-    if(ca->ps.persistant[ PERS_SCORE ] > cb->ps.persistant[ PERS_SCORE ]) {
-        return -1;
-    }
-
-    if(ca->ps.persistant[ PERS_SCORE ] < cb->ps.persistant[ PERS_SCORE ]) {
-        return 1;
-    }
-
-    return 0;
-}
-
 /*
 ============
 idSGameMain::InitSpawnQueue
@@ -1047,6 +1078,7 @@ void idSGameMain::CalculateBuildPoints(void) {
     sint         i;
     buildable_t buildable;
     gentity_t   *ent;
+    uint32      signature = 2166136261u;
     sint         localHTP = level.humanBuildPoints =
                                 g_humanBuildPoints.integer,
                                 localATP = level.alienBuildPoints = g_alienBuildPoints.integer;
@@ -1137,6 +1169,12 @@ void idSGameMain::CalculateBuildPoints(void) {
 
         buildable = (buildable_t)ent->s.modelindex;
 
+        // anything a build preview depends on
+        signature = (signature ^ (i | (buildable << 12) |
+                                  (ent->health > 0) << 20 | ent->powered << 21 |
+                                  ent->spawned << 22 | ent->deconstruct << 23 |
+                                  ent->active << 24)) * 16777619u;
+
         if(buildable != BA_NONE) {
             if(buildable == BA_H_REACTOR && ent->spawned && ent->health > 0) {
                 level.reactorPresent = true;
@@ -1164,6 +1202,18 @@ void idSGameMain::CalculateBuildPoints(void) {
         level.alienBuildPoints = 0;
     }
 
+    signature = (signature ^ level.humanBuildPoints) * 16777619u;
+    signature = (signature ^ level.alienBuildPoints) * 16777619u;
+    signature = (signature ^ (level.numHumanSpawns << 8 | level.numAlienSpawns))
+                * 16777619u;
+    signature = (signature ^ g_markDeconstruct.integer) * 16777619u;
+
+    // invalidate cached build previews whenever the bases change
+    if(signature != level.buildableSignature) {
+        level.buildableSignature = signature;
+        level.buildableGeneration++;
+    }
+
     trap_SetConfigstring(CS_BUILDPOINTS, va("%d %d %d %d",
                                             level.alienBuildPoints, localATP,
                                             level.humanBuildPoints, localHTP));
@@ -1478,71 +1528,35 @@ void idSGameMain::CalculateAvgPlayers(void) {
 
 /*
 ============
-idSGameMain::CalculateRanks
+idSGameMain::InitRanks
 
-Recalculates the score ranks of all players
-This will be called on every client connect, begin, disconnect, death,
-and team change.
+Clears the rank state for a new level and publishes the initial P and ff
 ============
 */
-void idSGameMain::CalculateRanks(void) {
-    sint       i;
-    valueType      P[ MAX_CLIENTS + 1 ] = {""};
-    sint       ff = 0;
-    sint        numBots = 0;
-
-    level.numConnectedClients = 0;
-    level.numPlayingClients = 0;
-    level.numVotingClients = 0;   // don't count bots
-    level.numAlienClients = 0;
-    level.numHumanClients = 0;
-    level.numLiveAlienClients = 0;
-    level.numLiveHumanClients = 0;
-
-    for(i = 0; i < level.maxclients; i++) {
-        P[ i ] = '-';
-
-        if(level.clients[ i ].pers.connected != CON_DISCONNECTED ||
-                level.clients[ i ].pers.demoClient) {
-            level.sortedClients[ level.numConnectedClients ] = i;
-            level.numConnectedClients++;
-            P[ i ] = (valueType)'0' + level.clients[ i ].pers.teamSelection;
-
-            if(level.clients[ i ].pers.connected != CON_CONNECTED &&
-                    !level.clients[ i ].pers.demoClient) {
-                continue;
-            }
-
-            level.numVotingClients++;
+void idSGameMain::InitRanks(void) {
+    ::memset(level.rankTeams, '-', level.maxclients);
+    level.rankTeams[ level.maxclients ] = '\0';
+    level.rankTeamsModified = true;
+    level.rankFriendlyFire = -1;
 
-            if(level.clients[ i ].pers.teamSelection != TEAM_NONE) {
-                level.numPlayingClients++;
+    UpdateRankCvars();
+}
 
-                if(level.clients[ i ].pers.teamSelection == TEAM_ALIENS) {
-                    level.numAlienClients++;
+/*
+============
+idSGameMain::UpdateRankCvars
 
-                    if(level.clients[ i ].sess.spectatorState == SPECTATOR_NOT) {
-                        level.numLiveAlienClients++;
-                    }
-                } else if(level.clients[ i ].pers.teamSelection == TEAM_HUMANS) {
-                    level.numHumanClients++;
+Sets the P and ff cvars, but only when their contents have changed
+============
+*/
+void idSGameMain::UpdateRankCvars(void) {
+    sint ff = 0;
 
-                    if(level.clients[ i ].sess.spectatorState == SPECTATOR_NOT) {
-                        level.numLiveHumanClients++;
-                    }
-                }
-            }
-        }
+    if(level.rankTeamsModified) {
+        trap_Cvar_Set("P", level.rankTeams);
+        level.rankTeamsModified = false;
     }
 
-    level.numNonSpectatorClients = level.numLiveAlienClients +
-                                   level.numLiveHumanClients;
-    level.numVotingClients = level.numConnectedClients - numBots;
-    level.numteamVotingClients[ 0 ] = level.numHumanClients;
-    level.numteamVotingClients[ 1 ] = level.numAlienClients;
-    P[ i ] = '\0';
-    trap_Cvar_Set("P", P);
-
     if(g_friendlyFire.integer) {
         ff |= (FFF_HUMANS | FFF_ALIENS);
     }
@@ -1559,10 +1573,122 @@ void idSGameMain::CalculateRanks(void) {
         ff |=  FFF_BUILDABLES;
     }
 
-    trap_Cvar_Set("ff", va("%i", ff));
+    if(ff != level.rankFriendlyFire) {
+        trap_Cvar_Set("ff", va("%i", ff));
+        level.rankFriendlyFire = ff;
+    }
+}
+
+/*
+============
+CountRank
+
+Adds (delta 1) or removes (delta -1) a client's contribution to the counts
+============
+*/
+static void CountRank(const clientRank_t *rank, sint delta) {
+    if(rank->ranked) {
+        level.numConnectedClients += delta;
+    }
+
+    if(!rank->counted || rank->team == TEAM_NONE) {
+        return;
+    }
+
+    level.numPlayingClients += delta;
+
+    if(rank->team == TEAM_ALIENS) {
+        level.numAlienClients += delta;
+
+        if(rank->live) {
+            level.numLiveAlienClients += delta;
+        }
+    } else if(rank->team == TEAM_HUMANS) {
+        level.numHumanClients += delta;
+
+        if(rank->live) {
+            level.numLiveHumanClients += delta;
+        }
+    }
+}
+
+/*
+============
+idSGameMain::UpdateRank
+
+Updates the client counts and the score ranking for one client.
+Must be called whenever a client connects, begins, disconnects, spawns,
+changes team or spectator state, or scores; only that client is moved
+within level.sortedClients.
+============
+*/
+void idSGameMain::UpdateRank(sint clientNum) {
+    sint i, score;
+    sint *sorted = level.sortedClients;
+    gclient_t *cl = &level.clients[ clientNum ];
+    clientRank_t *rank = &level.clientRanks[ clientNum ];
+    clientRank_t now;
+    valueType p;
+
+    now.ranked = cl->pers.connected != CON_DISCONNECTED || cl->pers.demoClient;
+    now.counted = now.ranked && (cl->pers.connected == CON_CONNECTED ||
+                                 cl->pers.demoClient);
+    now.team = now.counted ? cl->pers.teamSelection : TEAM_NONE;
+    now.live = now.counted && cl->sess.spectatorState == SPECTATOR_NOT;
+
+    // find the client's current position in the ranking
+    i = level.numConnectedClients;
+
+    if(rank->ranked) {
+        for(i = 0; i < level.numConnectedClients; i++) {
+            if(sorted[ i ] == clientNum) {
+                break;
+            }
+        }
+    }
+
+    if(rank->ranked && !now.ranked) {
+        ::memmove(&sorted[ i ], &sorted[ i + 1 ],
+                  (level.numConnectedClients - i - 1) * sizeof(sorted[ 0 ]));
+    } else if(now.ranked) {
+        if(!rank->ranked) {
+            // new entries start at the bottom
+            sorted[ i ] = clientNum;
+        }
 
-    qsort(level.sortedClients, level.numConnectedClients,
-          sizeof(level.sortedClients[ 0 ]), &idSGameMain::SortRanks);
+        score = cl->ps.persistant[ PERS_SCORE ];
+
+        while(i > 0 &&
+                level.clients[ sorted[ i - 1 ] ].ps.persistant[ PERS_SCORE ] < score) {
+            sorted[ i ] = sorted[ i - 1 ];
+            sorted[ --i ] = clientNum;
+        }
+
+        while(i < level.numConnectedClients - 1 &&
+                level.clients[ sorted[ i + 1 ] ].ps.persistant[ PERS_SCORE ] > score) {
+            sorted[ i ] = sorted[ i + 1 ];
+            sorted[ ++i ] = clientNum;
+        }
+    }
+
+    CountRank(rank, -1);
+    CountRank(&now, 1);
+    *rank = now;
+
+    level.numNonSpectatorClients = level.numLiveAlienClients +
+                                   level.numLiveHumanClients;
+    level.numVotingClients = level.numConnectedClients;
+    level.numteamVotingClients[ 0 ] = level.numHumanClients;
+    level.numteamVotingClients[ 1 ] = level.numAlienClients;
+
+    p = now.ranked ? (valueType)'0' + cl->pers.teamSelection : '-';
+
+    if(clientNum < level.maxclients && level.rankTeams[ clientNum ] != p) {
+        level.rankTeams[ clientNum ] = p;
+        level.rankTeamsModified = true;
+    }
+
+    UpdateRankCvars();
 
     // see if it is time to end the level
     CheckExitRules();
@@ -2415,52 +2541,60 @@ void idSGameMain::CheckTeamVote(team_t team) {
 
 /*
 ==================
-CheckCvars
+idSGameMain::PasswordChanged
 ==================
 */
-void idSGameMain::CheckCvars(void) {
-    static sint lastPasswordModCount   = -1;
-    static sint lastMarkDeconModCount  = -1;
-    static sint lastSDTimeModCount = -1;
-
-    if(g_password.modificationCount != lastPasswordModCount) {
-        lastPasswordModCount = g_password.modificationCount;
-
-        if(*g_password.string && Q_stricmp(g_password.string, "none")) {
-            trap_Cvar_Set("g_needpass", "1");
-        } else {
-            trap_Cvar_Set("g_needpass", "0");
-        }
+void idSGameMain::PasswordChanged(void) {
+    if(*g_password.string && Q_stricmp(g_password.string, "none")) {
+        trap_Cvar_Set("g_needpass", "1");
+    } else {
+        trap_Cvar_Set("g_needpass", "0");
     }
+}
 
-    // Unmark any structures for deconstruction when
-    // the server setting is changed
-    if(g_markDeconstruct.modificationCount != lastMarkDeconModCount) {
-        sint       i;
-        gentity_t *ent;
-
-        lastMarkDeconModCount = g_markDeconstruct.modificationCount;
+/*
+==================
+idSGameMain::MarkDeconstructChanged
 
-        for(i = 1, ent = g_entities + i ; i < level.num_entities ; i++, ent++) {
-            if(!ent->inuse) {
-                continue;
-            }
+Unmark any structures for deconstruction when
+the server setting is changed
+==================
+*/
+void idSGameMain::MarkDeconstructChanged(void) {
+    sint       i;
+    gentity_t *ent;
 
-            if(ent->s.eType != ET_BUILDABLE) {
-                continue;
-            }
+    for(i = 1, ent = g_entities + i ; i < level.num_entities ; i++, ent++) {
+        if(!ent->inuse) {
+            continue;
+        }
 
-            ent->deconstruct = false;
+        if(ent->s.eType != ET_BUILDABLE) {
+            continue;
         }
-    }
 
-    // If we change g_suddenDeathTime during a map, we need to update
-    // when sd will begin
-    if(g_suddenDeathTime.modificationCount != lastSDTimeModCount) {
-        lastSDTimeModCount = g_suddenDeathTime.modificationCount;
-        level.suddenDeathBeginTime = g_suddenDeathTime.integer * 60000;
+        ent->deconstruct = false;
     }
+}
+
+/*
+==================
+idSGameMain::SuddenDeathTimeChanged
+
+If we change g_suddenDeathTime during a map, we need to update
+when sd will begin
+==================
+*/
+void idSGameMain::SuddenDeathTimeChanged(void) {
+    level.suddenDeathBeginTime = g_suddenDeathTime.integer * 60000;
+}
 
+/*
+==================
+CheckCvars
+==================
+*/
+void idSGameMain::CheckCvars(void) {
     level.frameMsec = trap_Milliseconds();
 }
 
@@ -2532,6 +2666,9 @@ void idSGameLocal::RunFrame(sint levelTime) {
         return;
     }
 
+    // last frame's scratch strings are done with
+    Com_ScratchReset();
+
     level.framenum++;
     level.previousTime = level.time;
     level.time = levelTime;
@@ -2547,6 +2684,10 @@ void idSGameLocal::RunFrame(sint levelTime) {
     // go through all allocated objects
     //
     start = trap_Milliseconds();
+
+    // step the rigid bodies before the entities read them back
+    idSGamePhysics::Step(msec);
+
     ent = &g_entities[ 0 ];
 
     for(i = 0; i < level.num_entities; i++, ent++) {
@@ -2661,6 +2802,9 @@ void idSGameLocal::RunFrame(sint levelTime) {
     // for tracking changes
     idSGameMain::CheckCvars();
 
+    // save admin changes made this frame
+    adminLocal.AdminFlushConfig();
+
     if(g_listEntity.integer) {
         for(i = 0; i < MAX_GENTITIES; i++) {
             idSGameMain::Printf("%4i: %s\n", i, g_entities[ i ].classname);
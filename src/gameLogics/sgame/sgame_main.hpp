@@ -39,7 +39,6 @@ public:
     static void Printf(pointer fmt, ...);
     static void Error(pointer fmt, ...);
     static void ClearVotes(void);
-    static sint SortRanks(const void *a, const void *b);
     static void ExitLevel(void);
     static void SendGameStat(team_t team);
     static void CheckIntermissionExit(void);
@@ -53,7 +52,9 @@ public:
     static sint GetPosInSpawnQueue(spawnQueue_t *sq, sint clientNum);
     static void MapConfigs(pointer mapname);
     static sint TimeTilSuddenDeath(void);
-    static void CalculateRanks(void);
+    static void InitRanks(void);
+    static void UpdateRank(sint clientNum);
+    static void UpdateRankCvars(void);
     static void SendScoreboardMessageToAllClients(void);
     static void MoveClientToIntermission(gentity_t *client);
     static void FindIntermissionPoint(void);
@@ -79,6 +80,9 @@ public:
     static void CalculateBuildPoints(void);
     static bool ScoreIsTied(void);
     static void CheckCvars(void);
+    static void PasswordChanged(void);
+    static void MarkDeconstructChanged(void);
+    static void SuddenDeathTimeChanged(void);
 };
 
 #endif // !__SGAME_MAIN_H__
@@ -257,19 +257,99 @@ void idSGameMissile::MissileImpact(gentity_t *ent, trace_t *trace) {
     trap_LinkEntity(ent);
 }
 
+#define MISSILE_PREDICT_TIME 2000 // how far ahead a linear path is traced
+
 /*
 ================
-idSGameMissile::RunMissile
+idSGameMissile::PredictMissileImpact
+
+Traces a TR_LINEAR missile's path against the world once, when it is
+launched or its trajectory changes, to find how long it will stay clear.
+Bodies are left out, MissileNearEntities catches those frame by frame.
 ================
 */
-void idSGameMissile::RunMissile(gentity_t *ent) {
-    vec3_t    origin;
+void idSGameMissile::PredictMissileImpact(gentity_t *ent) {
+    trace_t tr;
+    vec3_t  end, delta;
+    float32 speed;
+
+    ent->missilePath = ent->s.pos;
+    ent->missileClearTime = 0;
+    ent->missileBlocked = false;
+
+    speed = VectorLength(ent->s.pos.trDelta);
+
+    if(ent->s.pos.trType != TR_LINEAR || speed <= 0.0f) {
+        return;
+    }
+
+    bggame->EvaluateTrajectory(&ent->s.pos, level.time + MISSILE_PREDICT_TIME,
+                               end);
+    trap_Trace(&tr, ent->r.currentOrigin, ent->r.mins, ent->r.maxs, end,
+               ent->r.ownerNum, ent->clipmask & ~CONTENTS_BODY);
+
+    if(tr.startsolid || tr.allsolid) {
+        ent->missileBlocked = true;
+        return;
+    }
+
+    // the time the missile reaches the end of the trace, less a little
+    VectorSubtract(tr.endpos, ent->s.pos.trBase, delta);
+    ent->missileClearTime = ent->s.pos.trTime +
+                            (sint)(1000.0f * DotProduct(delta,
+                                    ent->s.pos.trDelta) / (speed * speed)) - 1;
+    ent->missileBlocked = tr.fraction < 1.0f;
+}
+
+/*
+================
+idSGameMissile::MissileNearEntities
+
+True if anything other than the world could be hit moving to origin
+================
+*/
+bool idSGameMissile::MissileNearEntities(gentity_t *ent, vec3_t origin) {
+    sint      i, num;
+    sint      entityList[ MAX_GENTITIES ];
+    vec3_t    mins, maxs;
+    gentity_t *other;
+
+    for(i = 0; i < 3; i++) {
+        mins[ i ] = MIN(ent->r.currentOrigin[ i ], origin[ i ]) +
+                    ent->r.mins[ i ] - 1.0f;
+        maxs[ i ] = MAX(ent->r.currentOrigin[ i ], origin[ i ]) +
+                    ent->r.maxs[ i ] + 1.0f;
+    }
+
+    num = trap_EntitiesInBox(mins, maxs, entityList, MAX_GENTITIES);
+
+    for(i = 0; i < num; i++) {
+        other = &g_entities[ entityList[ i ] ];
+
+        if(other == ent || other->s.number == ent->r.ownerNum) {
+            continue;
+        }
+
+        if(other->r.contents & (ent->clipmask | CONTENTS_BODY)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+================
+idSGameMissile::TraceMissile
+
+Moves the missile to origin, impacting on whatever is in the way.
+Returns false if it exploded.
+================
+*/
+bool idSGameMissile::TraceMissile(gentity_t *ent, vec3_t origin) {
     trace_t   tr;
     sint     passent;
 
-    // get current position
-    bggame->EvaluateTrajectory(&ent->s.pos, level.time, origin);
-
     // ignore interactions with the missile owner
     passent = ent->r.ownerNum;
 
@@ -295,7 +375,7 @@ void idSGameMissile::RunMissile(gentity_t *ent) {
         MissileImpact(ent, &tr);
 
         if(ent->s.eType != ET_MISSILE) {
-            return;    // exploded
+            return false;    // exploded
         }
     }
     // only hit the world with zero width
@@ -306,7 +386,7 @@ void idSGameMissile::RunMissile(gentity_t *ent) {
         MissileImpact(ent, &tr);
 
         if(ent->s.eType != ET_MISSILE) {
-            return;    // exploded
+            return false;    // exploded
         }
     }
     // one last check to see if we can hit an entity near solid stuff
@@ -320,10 +400,39 @@ void idSGameMissile::RunMissile(gentity_t *ent) {
         MissileImpact(ent, &tr);
 
         if(ent->s.eType != ET_MISSILE) {
-            return;    // exploded
+            return false;    // exploded
         }
     }
 
+    return true;
+}
+
+/*
+================
+idSGameMissile::RunMissile
+================
+*/
+void idSGameMissile::RunMissile(gentity_t *ent) {
+    vec3_t    origin;
+
+    // get current position
+    bggame->EvaluateTrajectory(&ent->s.pos, level.time, origin);
+
+    // linear paths are traced ahead when launched or bounced, and again once
+    // an unobstructed prediction has been used up
+    if(::memcmp(&ent->missilePath, &ent->s.pos, sizeof(ent->s.pos)) ||
+            (ent->s.pos.trType == TR_LINEAR && !ent->missileBlocked &&
+             level.time >= ent->missileClearTime)) {
+        PredictMissileImpact(ent);
+    }
+
+    if(level.time < ent->missileClearTime && !MissileNearEntities(ent, origin)) {
+        // nothing but the world can be hit, and the world is known to be clear
+        VectorCopy(origin, ent->r.currentOrigin);
+    } else if(!TraceMissile(ent, origin)) {
+        return;    // exploded
+    }
+
     ent->r.contents = CONTENTS_SOLID; //trick trap_LinkEntity into...
     trap_LinkEntity(ent);
     ent->r.contents = 0; //...encoding bbox information
@@ -56,6 +56,9 @@ public:
     static gentity_t *fire_hive(gentity_t *self, vec3_t start, vec3_t dir);
     static gentity_t *launch_grenade(gentity_t *self, vec3_t start,
                                      vec3_t dir);
+    static void PredictMissileImpact(gentity_t *ent);
+    static bool MissileNearEntities(gentity_t *ent, vec3_t origin);
+    static bool TraceMissile(gentity_t *ent, vec3_t origin);
     static void RunMissile(gentity_t *ent);
 
 };
@@ -1403,6 +1403,7 @@ void idSGameMover::Think_SpawnNewDoorTrigger(gentity_t *ent) {
     // remember the thinnest axis
     other->count = best;
     trap_LinkEntity(other);
+    idSGameActive::AddTrigger(other);
 
     if(ent->moverState < MODEL_POS1) {
         MatchTeam(ent, ent->moverState, level.time);
@@ -1889,6 +1890,7 @@ void idSGameMover::SpawnPlatTrigger(gentity_t *ent) {
     VectorCopy(tmax, trigger->r.maxs);
 
     trap_LinkEntity(trigger);
+    idSGameActive::AddTrigger(trigger);
 }
 
 
@@ -100,10 +100,13 @@ void idSGamePhysics::Bounce(gentity_t *ent, trace_t *trace) {
 
 /*
 ================
-idSGamePhysics::Physics
+idSGamePhysics::TracePhysics
+
+The legacy path, moves the entity along its trajectory and bounces it off
+whatever the trace hits
 ================
 */
-void idSGamePhysics::Physics(gentity_t *ent, sint msec) {
+void idSGamePhysics::TracePhysics(gentity_t *ent, sint msec) {
     vec3_t origin;
     trace_t tr;
     sint contents, mask;
@@ -134,8 +137,14 @@ void idSGamePhysics::Physics(gentity_t *ent, sint msec) {
         // check think function
         idSGameMain::RunThink(ent);
 
-        //check floor infrequently
-        if(ent->nextPhysicsTime < level.time) {
+        // the world can't move out from under something resting on it, so
+        // that sleeps until a mover pushes it; check other floors infrequently,
+        // or at once if the entity underneath has gone
+        if(ent->s.groundEntityNum != ENTITYNUM_WORLD &&
+                (ent->nextPhysicsTime < level.time ||
+                 (ent->s.groundEntityNum >= 0 &&
+                  ent->s.groundEntityNum < ENTITYNUM_MAX_NORMAL &&
+                  !g_entities[ ent->s.groundEntityNum ].inuse))) {
             VectorCopy(ent->r.currentOrigin, origin);
 
             VectorMA(origin, -2.0f, ent->s.origin2, origin);
@@ -185,3 +194,186 @@ void idSGamePhysics::Physics(gentity_t *ent, sint msec) {
     Bounce(ent, &tr);
 }
 
+// a physicsBench run, timing everything the physics backend does a frame
+static struct {
+    sint corpses;
+    sint frames;        // frames left to time, 0 when no run is going
+    sint timed;
+    bool started;
+    float64 frameTime;
+    float64 totalTime;
+    float64 worstTime;
+} physicsBench;
+
+/*
+================
+idSGamePhysics::Physics
+
+Moves a corpse or physics object with the backend g_physics picked at
+map load
+================
+*/
+void idSGamePhysics::Physics(gentity_t *ent, sint msec) {
+    float64 start = 0.0;
+
+    if(physicsBench.frames) {
+        start = BenchmarkClock();
+    }
+
+    if(!idSGameBullet::Physics(ent, msec)) {
+        TracePhysics(ent, msec);
+    }
+
+    if(physicsBench.frames) {
+        physicsBench.frameTime += BenchmarkClock() - start;
+    }
+}
+
+/*
+================
+idSGamePhysics::Step
+
+Steps the rigid body world before the entities read their state back
+================
+*/
+void idSGamePhysics::Step(sint msec) {
+    float64 start;
+
+    if(!physicsBench.frames) {
+        idSGameBullet::Step(msec);
+        return;
+    }
+
+    BenchmarkFrame();
+
+    start = BenchmarkClock();
+    idSGameBullet::Step(msec);
+
+    if(physicsBench.frames) {
+        physicsBench.frameTime += BenchmarkClock() - start;
+    }
+}
+
+/*
+================
+idSGamePhysics::BenchmarkClock
+
+Milliseconds, finer than trap_Milliseconds
+================
+*/
+float64 idSGamePhysics::BenchmarkClock(void) {
+    return std::chrono::duration<float64, std::milli>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*
+================
+idSGamePhysics::Benchmark
+
+Drops a grid of corpses at origin and times the physics of the next frames
+================
+*/
+void idSGamePhysics::Benchmark(sint corpses, sint frames, vec3_t origin) {
+    sint i, side, spawned;
+    gentity_t *body;
+    vec3_t mins, maxs, spot;
+    trace_t tr;
+
+    if(physicsBench.frames) {
+        idSGameMain::Printf("physicsBench: a run is already going\n");
+        return;
+    }
+
+    bggame->ClassBoundingBox(PCL_HUMAN, nullptr, nullptr, nullptr, mins, maxs);
+
+    side = (sint)sqrt((float32)corpses) + 1;
+    spawned = 0;
+
+    // skip the grid spots that are in a wall, a few layers up if need be
+    for(i = 0; i < side * side * 4 && spawned < corpses; i++) {
+        VectorSet(spot, origin[ 0 ] + (i % side - side / 2) * 48.0f,
+                  origin[ 1 ] + ((i / side) % side - side / 2) * 48.0f,
+                  origin[ 2 ] + (i / (side * side)) * 64.0f);
+
+        trap_Trace(&tr, spot, mins, maxs, spot, ENTITYNUM_NONE,
+                   MASK_PLAYERSOLID & ~CONTENTS_BODY);
+
+        if(tr.startsolid || tr.allsolid) {
+            continue;
+        }
+
+        body = idSGameUtils::Spawn();
+        body->classname = "benchCorpse";
+        body->s.eType = ET_CORPSE;
+        body->s.eFlags = EF_DEAD;
+        body->s.clientNum = PCL_HUMAN;
+        body->s.misc = MAX_CLIENTS;
+        body->s.legsAnim = body->s.torsoAnim = BOTH_DEAD1;
+        body->r.contents = CONTENTS_CORPSE;
+        VectorCopy(mins, body->r.mins);
+        VectorCopy(maxs, body->r.maxs);
+
+        idSGameUtils::SetOrigin(body, spot);
+        VectorCopy(spot, body->s.origin);
+        body->s.pos.trType = TR_GRAVITY;
+        body->s.pos.trTime = level.time;
+        VectorSet(body->s.pos.trDelta, crandom() * 50.0f, crandom() * 50.0f, 0.0f);
+
+        trap_LinkEntity(body);
+        spawned++;
+    }
+
+    if(!spawned) {
+        idSGameMain::Printf("physicsBench: no room for corpses at %s\n",
+                            idSGameUtils::vtos(origin));
+        return;
+    }
+
+    ::memset(&physicsBench, 0, sizeof(physicsBench));
+    physicsBench.corpses = spawned;
+    physicsBench.frames = frames;
+
+    idSGameMain::Printf("physicsBench: timing %i corpses over %i frames\n",
+                        spawned, frames);
+}
+
+/*
+================
+idSGamePhysics::BenchmarkFrame
+
+Adds up the frame that just ran, and ends the run after the last one
+================
+*/
+void idSGamePhysics::BenchmarkFrame(void) {
+    sint i;
+    gentity_t *ent;
+
+    // the frame the corpses were spawned in isn't a whole one
+    if(!physicsBench.started) {
+        physicsBench.started = true;
+        physicsBench.frameTime = 0.0;
+        return;
+    }
+
+    physicsBench.totalTime += physicsBench.frameTime;
+    physicsBench.worstTime = MAX(physicsBench.worstTime,
+                                 physicsBench.frameTime);
+    physicsBench.frameTime = 0.0;
+    physicsBench.timed++;
+
+    if(--physicsBench.frames) {
+        return;
+    }
+
+    idSGameMain::Printf("physicsBench: %i corpses, %i frames, %s: %.3f ms "
+                        "a frame, worst %.3f ms\n", physicsBench.corpses, physicsBench.timed,
+                        idSGameBullet::Active() ? "bullet" : "traces",
+                        physicsBench.totalTime / physicsBench.timed, physicsBench.worstTime);
+
+    for(i = MAX_CLIENTS, ent = g_entities + MAX_CLIENTS; i < level.num_entities;
+            i++, ent++) {
+        if(ent->inuse && !Q_stricmp(ent->classname, "benchCorpse")) {
+            idSGameUtils::FreeEntity(ent);
+        }
+    }
+}
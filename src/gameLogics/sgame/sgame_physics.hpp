@@ -46,7 +46,12 @@ public:
     ~idSGamePhysics();
 
     static void Bounce(gentity_t *ent, trace_t *trace);
+    static void TracePhysics(gentity_t *ent, sint msec);
     static void Physics(gentity_t *ent, sint msec);
+    static void Step(sint msec);
+    static float64 BenchmarkClock(void);
+    static void Benchmark(sint corpses, sint frames, vec3_t origin);
+    static void BenchmarkFrame(void);
 };
 
 #endif // !__SGAME_PHYSICS_H__
\ No newline at end of file
@@ -36,6 +36,7 @@
 #include <setjmp.h>
 #include <iostream>
 #include <mutex>
+#include <chrono>
 #include <queue>
 #include <assert.h>
 #include <cstddef>
@@ -97,6 +98,7 @@
 #include <sgame/sgame_session.hpp>
 #include <sgame/sgame_ptr.hpp>
 #include <sgame/sgame_physics.hpp>
+#include <sgame/sgame_bullet.hpp>
 #include <sgame/sgame_mover.hpp>
 #include <sgame/sgame_missile.hpp>
 #include <sgame/sgame_misc.hpp>
@@ -110,16 +110,16 @@ Called on a first-time connect
 ================
 */
 void idSGameSession::InitSessionData(gclient_t *client,
-                                     valueType *userinfo) {
+                                     const infoView_t *userinfo) {
     clientSession_t *sess;
     pointer value;
+    sint length;
 
     sess = &client->sess;
 
     // initial team determination
-    value = Info_ValueForKey(userinfo, "team");
-
-    if(value[0] == 's') {
+    if(Info_ViewFind(userinfo, "team", &value, &length) && length &&
+            value[0] == 's') {
         // a willing spectator, not a waiting-in-line
         sess->spectatorState = SPECTATOR_FREE;
     } else {
@@ -39,7 +39,7 @@ public:
     static void WriteClientSessionData(gclient_t *client);
     static void WriteSessionData(void);
     static void ReadSessionData(gclient_t *client);
-    static void InitSessionData(gclient_t *client, valueType *userinfo);
+    static void InitSessionData(gclient_t *client, const infoView_t *userinfo);
 };
 
 #endif // !__SGAME_SESSION_H__
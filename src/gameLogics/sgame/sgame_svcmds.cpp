@@ -506,6 +506,65 @@ void idSGameSvcmds::Svcmd_PrintQueue_f(void) {
     }
 }
 
+/*
+===================
+idSGameSvcmds::Svcmd_CreepField_f
+===================
+*/
+void idSGameSvcmds::Svcmd_CreepField_f(void) {
+    idSGameBuildable::CreepFieldPrint();
+}
+
+/*
+===================
+idSGameSvcmds::Svcmd_LocationStats_f
+===================
+*/
+void idSGameSvcmds::Svcmd_LocationStats_f(void) {
+    idSGameTeam::Team_PrintLocationStats();
+}
+
+/*
+===================
+idSGameSvcmds::Svcmd_PhysicsBench_f
+
+Times the physics backend with a pile of corpses, dropped over the
+intermission point unless a spot is given
+===================
+*/
+void idSGameSvcmds::Svcmd_PhysicsBench_f(void) {
+    valueType str[ MAX_TOKEN_CHARS ];
+    sint i, corpses = 256, frames = 100;
+    vec3_t origin;
+
+    if(trap_Argc() > 1) {
+        trap_Argv(1, str, sizeof(str));
+        corpses = atoi(str);
+    }
+
+    if(trap_Argc() > 2) {
+        trap_Argv(2, str, sizeof(str));
+        frames = atoi(str);
+    }
+
+    if(corpses <= 0 || frames <= 0 || (trap_Argc() > 3 && trap_Argc() != 6)) {
+        idSGameMain::Printf("usage: physicsBench [corpses] [frames] [x y z]\n");
+        return;
+    }
+
+    if(trap_Argc() == 6) {
+        for(i = 0; i < 3; i++) {
+            trap_Argv(3 + i, str, sizeof(str));
+            origin[ i ] = atof(str);
+        }
+    } else {
+        idSGameMain::FindIntermissionPoint();
+        VectorCopy(level.intermission_origin, origin);
+    }
+
+    idSGamePhysics::Benchmark(corpses, frames, origin);
+}
+
 // dumb wrapper for "a" and "m"
 void idSGameSvcmds::Svcmd_MessageWrapper(void) {
     valueType cmd[ 2 ];
@@ -539,6 +598,9 @@ struct {
     { "admitDefeat", false, &idSGameSvcmds::Svcmd_AdmitDefeat_f },
     { "evacuation", false, &idSGameSvcmds::Svcmd_Evacuation_f },
     { "printqueue", false, &idSGameSvcmds::Svcmd_PrintQueue_f },
+    { "creepField", false, &idSGameSvcmds::Svcmd_CreepField_f },
+    { "locationStats", false, &idSGameSvcmds::Svcmd_LocationStats_f },
+    { "physicsBench", false, &idSGameSvcmds::Svcmd_PhysicsBench_f },
 
     // don't handle communication commands unless dedicated
     { "say_team", true, &idSGameSvcmds::Svcmd_TeamMessage_f },
@@ -52,6 +52,9 @@ public:
     static void Svcmd_EjectClient_f(void);
     static void Svcmd_DumpUser_f(void);
     static void Svcmd_PrintQueue_f(void);
+    static void Svcmd_CreepField_f(void);
+    static void Svcmd_LocationStats_f(void);
+    static void Svcmd_PhysicsBench_f(void);
     static void Svcmd_MessageWrapper(void);
 };
 
@@ -332,6 +332,8 @@ void idSGameTarget::target_location_linkup(gentity_t *ent) {
         }
     }
 
+    idSGameTeam::Team_ClearLocationCache();
+
     // All linked together now
 }
 
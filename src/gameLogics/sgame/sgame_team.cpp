@@ -238,23 +238,46 @@ void idSGameTeam::ChangeTeam(gentity_t *ent, team_t newTeam) {
     }
 }
 
+static cellCache_t locationCache;
+
 /*
 ===========
-idSGameTeam::Team_GetLocation
+idSGameTeam::Team_ClearLocationCache
 
-Report a location for the player. Uses placed nearby target_location entities
+Called when the target_locations are linked
 ============
 */
-gentity_t *idSGameTeam::Team_GetLocation(gentity_t *ent) {
+void idSGameTeam::Team_ClearLocationCache(void) {
+    Com_CellCacheClear(&locationCache, LOCATION_CELL_SIZE);
+}
+
+/*
+===========
+idSGameTeam::Team_PrintLocationStats
+
+How many location lookups had to scan the target_locations this map
+============
+*/
+void idSGameTeam::Team_PrintLocationStats(void) {
+    idSGameMain::Printf("%i location lookups, %i location scans, %i cells, "
+                        "%i corners\n", locationCache.lookups, locationCache.queries,
+                        locationCache.numCells, locationCache.numCorners);
+}
+
+/*
+===========
+idSGameTeam::Team_LocationForPoint
+
+The closest target_location in the PVS of origin, or -1
+============
+*/
+sint idSGameTeam::Team_LocationForPoint(const vec3_t origin) {
     gentity_t *eloc, *best;
     float32 bestlen, len;
-    vec3_t origin;
 
     best = nullptr;
     bestlen = 3.0f * 8192.0f * 8192.0f;
 
-    VectorCopy(ent->r.currentOrigin, origin);
-
     for(eloc = level.locationHead; eloc; eloc = eloc->nextTrain) {
         len = (origin[ 0 ] - eloc->r.currentOrigin[ 0 ]) * (origin[ 0 ] -
                 eloc->r.currentOrigin[ 0 ])
@@ -275,7 +298,23 @@ gentity_t *idSGameTeam::Team_GetLocation(gentity_t *ent) {
         best = eloc;
     }
 
-    return best;
+    return best ? best->s.number : -1;
+}
+
+/*
+===========
+idSGameTeam::Team_GetLocation
+
+Report a location for the player. Uses placed nearby target_location entities
+============
+*/
+gentity_t *idSGameTeam::Team_GetLocation(gentity_t *ent) {
+    sint location;
+
+    location = Com_CellCacheLookup(&locationCache, ent->r.currentOrigin,
+                                   Team_LocationForPoint);
+
+    return location >= 0 ? &g_entities[ location ] : nullptr;
 }
 
 
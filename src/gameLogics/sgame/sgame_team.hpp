@@ -41,6 +41,9 @@ public:
     static bool OnSameTeam(gentity_t *ent1, gentity_t *ent2);
     static void LeaveTeam(gentity_t *self);
     static void ChangeTeam(gentity_t *ent, team_t newTeam);
+    static void Team_ClearLocationCache(void);
+    static void Team_PrintLocationStats(void);
+    static sint Team_LocationForPoint(const vec3_t origin);
     static gentity_t *Team_GetLocation(gentity_t *ent);
     static bool Team_GetLocationMsg(gentity_t *ent, valueType *loc,
                                     sint loclen);
@@ -60,6 +60,7 @@ void idSGameTrigger::InitTrigger(gentity_t *self) {
     self->r.contents =
         CONTENTS_TRIGGER;    // replaces the -1 from trap_SetBrushModel
     self->r.svFlags = SVF_NOCLIENT;
+    idSGameActive::AddTrigger(self);
 }
 
 /*
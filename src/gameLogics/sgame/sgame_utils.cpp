@@ -342,15 +342,15 @@ for printing vectors
 =============
 */
 valueType *idSGameUtils::vtos(const vec3_t v) {
-    static sint index;
-    static valueType str[ 8 ][ 32 ];
+    static thread_local sint index;
+    static thread_local valueType str[ 8 ][ 40 ];
     valueType *s;
 
     // use an array so that multiple vtos won't collide
     s = str[ index ];
     index = (index + 1) & 7;
 
-    Q_vsprintf_s(s, 32, 32, "(%i %i %i)", (sint)v[ 0 ], (sint)v[ 1 ],
+    Q_vsprintf_s(s, 40, 40, "(%i %i %i)", (sint)v[ 0 ], (sint)v[ 1 ],
                  (sint)v[ 2 ]);
 
     return s;
@@ -473,6 +473,7 @@ Marks the entity as free
 */
 void idSGameUtils::FreeEntity(gentity_t *ent) {
     trap_UnlinkEntity(ent);     // unlink from world
+    idSGameBullet::RemoveEntity(ent);
 
     if(ent->neverFree) {
         return;